@@ -25,6 +25,7 @@
 #include "widgets/textarea/lv_textarea.h"
 #include <algorithm>
 #include <cstdint>
+#include <flx/kernel/TimerWheel.hpp>
 #include <flx/ui/GuiTask.hpp>
 #include <flx/ui/common/SettingsCommon.hpp>
 #include <flx/ui/theming/layout_constants/LayoutConstants.hpp>
@@ -161,66 +162,40 @@ void WiFiSettings::createUI() {
 			auto* instance = (WiFiSettings*)lv_observer_get_user_data(observer);
 			int32_t interval = lv_subject_get_int(subject);
 
-			// Delete existing timer if any
-			if (instance->m_scanTimer != nullptr) {
-				esp_timer_stop(instance->m_scanTimer);
-				esp_timer_delete(instance->m_scanTimer);
-				instance->m_scanTimer = nullptr;
-			}
-
-			// Create new timer if interval > 0
-			if (interval > 0) {
-				esp_timer_create_args_t timer_args = {
-					.callback = [](void* arg) {
-						auto* inst = static_cast<WiFiSettings*>(arg);
-						flx::ui::GuiTask::lock();
-						if (inst->m_destroying) {
-							flx::ui::GuiTask::unlock();
-							return;
-						}
-						bool should_scan = flx::connectivity::ConnectivityManager::getInstance().isWiFiEnabled() && !inst->m_isScanning;
-						if (should_scan) {
-							inst->refreshScan();
-						}
-						flx::ui::GuiTask::unlock();
-					},
-					.arg = instance,
-					.dispatch_method = ESP_TIMER_TASK,
-					.name = "wifi_scan_timer",
-					.skip_unhandled_events = true,
-				};
-				esp_timer_create(&timer_args, &instance->m_scanTimer);
-				esp_timer_start_periodic(instance->m_scanTimer, static_cast<uint64_t>(interval) * 1000000);
-			}
+			instance->setScanInterval(interval);
 		},
 		m_container, this
 	);
 
 	// Trigger initial timer setup based on current setting
-	int32_t initial_interval = lv_subject_get_int(m_wifiScanIntervalBridge->getSubject());
-	if (initial_interval > 0) {
-		esp_timer_create_args_t timer_args = {
-			.callback = [](void* arg) {
-				auto* inst = static_cast<WiFiSettings*>(arg);
+	setScanInterval(lv_subject_get_int(m_wifiScanIntervalBridge->getSubject()));
+}
+
+void WiFiSettings::setScanInterval(int32_t intervalSec) {
+	auto& wheel = flx::kernel::TimerWheel::getInstance();
+	if (intervalSec <= 0) {
+		wheel.stop(m_scanTimer);
+		return;
+	}
+	if (m_scanTimer == flx::kernel::TimerWheel::INVALID_TIMER) {
+		m_scanTimer = wheel.create(
+			"wifi_scan",
+			[this]() {
 				flx::ui::GuiTask::lock();
-				if (inst->m_destroying) {
+				if (m_destroying) {
 					flx::ui::GuiTask::unlock();
 					return;
 				}
-				bool should_scan = flx::connectivity::ConnectivityManager::getInstance().isWiFiEnabled() && !inst->m_isScanning;
+				bool should_scan = flx::connectivity::ConnectivityManager::getInstance().isWiFiEnabled() && !m_isScanning;
 				if (should_scan) {
-					inst->refreshScan();
+					refreshScan();
 				}
 				flx::ui::GuiTask::unlock();
 			},
-			.arg = this,
-			.dispatch_method = ESP_TIMER_TASK,
-			.name = "wifi_scan_timer",
-			.skip_unhandled_events = true,
-		};
-		esp_timer_create(&timer_args, &m_scanTimer);
-		esp_timer_start_periodic(m_scanTimer, static_cast<uint64_t>(initial_interval) * 1000000);
+			SCAN_SLACK_MS
+		);
 	}
+	wheel.startPeriodic(m_scanTimer, static_cast<uint32_t>(intervalSec) * 1000);
 }
 
 void WiFiSettings::onShow() {
@@ -511,10 +486,9 @@ void WiFiSettings::showConnectScreen(const char* ssid) {
 
 void WiFiSettings::onDestroy() {
 	m_destroying = true;
-	if (m_scanTimer != nullptr) {
-		esp_timer_stop(m_scanTimer);
-		esp_timer_delete(m_scanTimer);
-		m_scanTimer = nullptr;
+	if (m_scanTimer != flx::kernel::TimerWheel::INVALID_TIMER) {
+		flx::kernel::TimerWheel::getInstance().destroy(m_scanTimer);
+		m_scanTimer = flx::kernel::TimerWheel::INVALID_TIMER;
 	}
 	if (m_connectContainer) {
 		lv_obj_delete(m_connectContainer);
@@ -1,9 +1,9 @@
 #pragma once
-#include "esp_timer.h"
 #include "esp_wifi.h"
 #include "lvgl.h"
 #include "settings/SettingsPageBase.hpp"
 #include <cstring>
+#include <flx/kernel/TimerWheel.hpp>
 #include <flx/ui/LvglObserverBridge.hpp>
 #include <memory>
 #include <string>
@@ -31,7 +31,10 @@ protected:
 
 private:
 
+	static constexpr uint32_t SCAN_SLACK_MS = 1000; // Background scans tolerate a late start
+
 	static const char* getSignalIcon(int8_t rssi);
+	void setScanInterval(int32_t intervalSec);
 
 	lv_obj_t* m_connectContainer = nullptr;
 	lv_obj_t* m_configContainer = nullptr;
@@ -46,7 +49,7 @@ private:
 	bool m_destroying = false;
 	lv_observer_t* m_statusObserver = nullptr;
 	lv_observer_t* m_scanIntervalObserver = nullptr;
-	esp_timer_handle_t m_scanTimer = nullptr;
+	flx::kernel::TimerWheel::TimerId m_scanTimer = flx::kernel::TimerWheel::INVALID_TIMER;
 	std::vector<wifi_ap_record_t> m_scanResults;
 
 	std::unique_ptr<flx::ui::LvglObserverBridge<int32_t>> m_wifiEnabledBridge;
@@ -363,7 +363,7 @@ void SystemInfoApp::createTasksTab(lv_obj_t* tab) {
 	lv_obj_set_style_pad_all(m_tasks_table, 0, LV_PART_MAIN);
 	lv_obj_set_style_pad_all(m_tasks_table, 0, LV_PART_ITEMS);
 	lv_obj_set_width(m_tasks_table, lv_pct(100));
-	lv_table_set_column_count(m_tasks_table, 7);
+	lv_table_set_column_count(m_tasks_table, 8);
 
 	// Responsive column widths
 	lv_obj_update_layout(tab);
@@ -371,21 +371,23 @@ void SystemInfoApp::createTasksTab(lv_obj_t* tab) {
 	// Use slightly less than full width to avoid potential scrollbar issues
 	int32_t const w = screen_w - 5;
 
-	lv_table_set_column_width(m_tasks_table, 0, (int32_t)(w * 0.08)); // #
-	lv_table_set_column_width(m_tasks_table, 1, (int32_t)(w * 0.28)); // Name
+	lv_table_set_column_width(m_tasks_table, 0, (int32_t)(w * 0.07)); // #
+	lv_table_set_column_width(m_tasks_table, 1, (int32_t)(w * 0.24)); // Name
 	lv_table_set_column_width(m_tasks_table, 2, (int32_t)(w * 0.12)); // CPU%
-	lv_table_set_column_width(m_tasks_table, 3, (int32_t)(w * 0.15)); // State
-	lv_table_set_column_width(m_tasks_table, 4, (int32_t)(w * 0.12)); // Prio
-	lv_table_set_column_width(m_tasks_table, 5, (int32_t)(w * 0.15)); // Stack
-	lv_table_set_column_width(m_tasks_table, 6, (int32_t)(w * 0.10)); // Core
+	lv_table_set_column_width(m_tasks_table, 3, (int32_t)(w * 0.12)); // Peak
+	lv_table_set_column_width(m_tasks_table, 4, (int32_t)(w * 0.11)); // State
+	lv_table_set_column_width(m_tasks_table, 5, (int32_t)(w * 0.09)); // Prio
+	lv_table_set_column_width(m_tasks_table, 6, (int32_t)(w * 0.15)); // Stack
+	lv_table_set_column_width(m_tasks_table, 7, (int32_t)(w * 0.10)); // Core
 
 	lv_table_set_cell_value(m_tasks_table, 0, 0, "#");
 	lv_table_set_cell_value(m_tasks_table, 0, 1, "Name");
 	lv_table_set_cell_value(m_tasks_table, 0, 2, "CPU%");
-	lv_table_set_cell_value(m_tasks_table, 0, 3, "State");
-	lv_table_set_cell_value(m_tasks_table, 0, 4, "Prio");
-	lv_table_set_cell_value(m_tasks_table, 0, 5, "Stack");
-	lv_table_set_cell_value(m_tasks_table, 0, 6, "Core");
+	lv_table_set_cell_value(m_tasks_table, 0, 3, "Peak");
+	lv_table_set_cell_value(m_tasks_table, 0, 4, "State");
+	lv_table_set_cell_value(m_tasks_table, 0, 5, "Prio");
+	lv_table_set_cell_value(m_tasks_table, 0, 6, "Stack");
+	lv_table_set_cell_value(m_tasks_table, 0, 7, "Core");
 }
 
 void SystemInfoApp::updateInfo() {
@@ -516,15 +518,16 @@ void SystemInfoApp::updateTaskList(std::vector<flx::services::TaskInfo>& tasks)
 			lv_table_set_cell_value_fmt(m_tasks_table, row, 0, "%d", (int)(i + 1));
 			lv_table_set_cell_value(m_tasks_table, row, 1, task.name.c_str());
 			lv_table_set_cell_value_fmt(m_tasks_table, row, 2, "%.1f%%", task.cpuUsagePercent);
-			lv_table_set_cell_value(m_tasks_table, row, 3, task.state.c_str());
-			lv_table_set_cell_value_fmt(m_tasks_table, row, 4, "%d", task.currentPriority);
-			lv_table_set_cell_value_fmt(m_tasks_table, row, 5, "%u", (unsigned int)task.stackHighWaterMark);
+			lv_table_set_cell_value_fmt(m_tasks_table, row, 3, "%.1f%%", task.cpuPeakPercent);
+			lv_table_set_cell_value(m_tasks_table, row, 4, task.state.c_str());
+			lv_table_set_cell_value_fmt(m_tasks_table, row, 5, "%d", task.currentPriority);
+			lv_table_set_cell_value_fmt(m_tasks_table, row, 6, "%u", (unsigned int)task.stackHighWaterMark);
 
 			// Handle Core ID (check for tskNO_AFFINITY which is 2147483647)
 			if (task.coreID == -1 || task.coreID == tskNO_AFFINITY) {
-				lv_table_set_cell_value(m_tasks_table, row, 6, "Any");
+				lv_table_set_cell_value(m_tasks_table, row, 7, "Any");
 			} else {
-				lv_table_set_cell_value_fmt(m_tasks_table, row, 6, "%d", task.coreID);
+				lv_table_set_cell_value_fmt(m_tasks_table, row, 7, "%d", task.coreID);
 			}
 		}
 	}
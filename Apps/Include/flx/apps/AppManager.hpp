@@ -3,9 +3,11 @@
 #include "AppContext.hpp"
 #include "Intent.hpp"
 #include <flx/core/Bundle.hpp>
+#include <flx/core/LockProfiler.hpp>
 #include <flx/core/Singleton.hpp>
 #include <flx/kernel/TaskManager.hpp>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -42,6 +44,7 @@ struct AppStackEntry {
 	std::unique_ptr<AppContext> context;
 	LaunchId launchId = LAUNCH_ID_INVALID;
 	ResultCallback resultCallback;
+	std::vector<std::string> retainedServices; // Released when the entry leaves the stack
 };
 
 class AppManager : public flx::Singleton<AppManager> {
@@ -132,14 +135,14 @@ private:
 	std::vector<std::shared_ptr<App>> m_apps;
 	std::vector<AppStateObserver*> m_observers {};
 
-	void* m_mutex = nullptr;
+	mutable flx::core::ProfiledMutex<std::mutex> m_mutex {"app_manager"};
 	void* m_executor = nullptr;
 
 	// Internal helpers
 	LaunchId generateLaunchId();
+	static void releaseServices(AppStackEntry& entry);
 	void notifyAppStarted(const std::string& packageName);
 	void notifyAppStopped(const std::string& packageName);
-	void publishAppEvent(const char* event, const std::string& appId);
 
 	// Legacy method removed, but internal logic moved to startAppForResult
 	// bool startApp(std::shared_ptr<App> app);
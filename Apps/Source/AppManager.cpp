@@ -1,14 +1,14 @@
 #include "esp_system.h"
 #include "freertos/idf_additions.h"
 #include "freertos/projdefs.h"
-#include "freertos/semphr.h"
 #include "portmacro.h"
 #include <algorithm> // Explicitly include for std::find_if
 #include <flx/apps/AppManager.hpp>
 #include <flx/apps/AppManifest.hpp>
 #include <flx/apps/AppRegistry.hpp>
-#include <flx/core/EventBus.hpp>
 #include <flx/core/Logger.hpp>
+#include <flx/core/SystemEvents.hpp>
+#include <flx/core/Trace.hpp>
 #include <flx/kernel/TaskManager.hpp>
 #include <flx/services/ServiceRegistry.hpp>
 
@@ -19,6 +19,8 @@ public:
 
 	AppExecutor() : flx::kernel::Task("app_executor", 8 * 1024, 4) {
 		setRestartPolicy(RestartPolicy::RESTART_TASK);
+		// Restarts reuse one arena block instead of reallocating from the heap
+		setStackMemory(StackMemory::INTERNAL);
 	}
 
 protected:
@@ -33,7 +35,7 @@ protected:
 	}
 };
 
-AppManager::AppManager() : m_mutex(xSemaphoreCreateMutex()) {}
+AppManager::AppManager() = default;
 
 // Callback storage
 static GuiLockCallback s_guiLock;
@@ -85,31 +87,36 @@ void AppManager::registerApp(std::shared_ptr<App> app) {
 	if (!app) {
 		return;
 	}
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	// Lifecycle events carry the id in a fixed-size typed payload
+	if (app->getPackageName().size() > flx::core::MAX_APP_ID_LENGTH) {
+		Log::error("AppManager", "App id '%s' is longer than %zu chars, ignoring", app->getPackageName().c_str(), flx::core::MAX_APP_ID_LENGTH);
+		return;
+	}
+	m_mutex.lock();
 	for (const auto& ex: m_apps)
 		if (ex->getPackageName() == app->getPackageName()) {
-			xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+			m_mutex.unlock();
 			return;
 		}
 	Log::info("AppManager", "Registered app: %s (%s)", app->getAppName().c_str(), app->getPackageName().c_str());
 	m_apps.push_back(app);
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 }
 
 std::shared_ptr<App> AppManager::getAppByPackageName(const std::string& pkg) {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	std::shared_ptr<App> found = nullptr;
 	for (auto& app: m_apps)
 		if (app->getPackageName() == pkg) {
 			found = app;
 			break;
 		}
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 	return found;
 }
 
 bool AppManager::isAppRegistered(const std::string& packageName) const {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	bool found = false;
 	for (const auto& app: m_apps) {
 		if (app->getPackageName() == packageName) {
@@ -117,7 +124,7 @@ bool AppManager::isAppRegistered(const std::string& packageName) const {
 			break;
 		}
 	}
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 	return found;
 }
 
@@ -130,6 +137,7 @@ LaunchId AppManager::startApp(const Intent& intent) {
 }
 
 LaunchId AppManager::startAppForResult(const Intent& intent, ResultCallback callback) {
+	FLX_TRACE_SCOPE("AppManager::startAppForResult");
 	// Resolve intent to an app
 	auto manifestOpt = IntentResolver::resolve(intent);
 	if (!manifestOpt) {
@@ -141,10 +149,10 @@ LaunchId AppManager::startAppForResult(const Intent& intent, ResultCallback call
 
 	// === Pre-launch validation ===
 
-	// Check required services are running
+	// Check required services are running; lazy ones are started here
 	for (const auto& svcId: manifest.requiredServices) {
-		auto state = flx::services::ServiceRegistry::getInstance().getServiceState(svcId);
-		if (state != flx::services::ServiceState::Started) {
+		auto svc = flx::services::ServiceRegistry::getInstance().getService(svcId);
+		if (!svc || !svc->isRunning()) {
 			Log::error("AppManager", "App '%s' requires service '%s' which is not running", manifest.appId.c_str(), svcId.c_str());
 			return LAUNCH_ID_INVALID;
 		}
@@ -168,7 +176,7 @@ LaunchId AppManager::startAppForResult(const Intent& intent, ResultCallback call
 	LaunchId launchId = LAUNCH_ID_INVALID;
 
 	Log::info("AppManager", "startAppForResult: Acquiring mutex for %s", manifest.appId.c_str());
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	Log::info("AppManager", "startAppForResult: Mutex acquired");
 
 	// Check if already in stack
@@ -200,7 +208,7 @@ LaunchId AppManager::startAppForResult(const Intent& intent, ResultCallback call
 		// Push to top
 		m_appStack.push_back(std::move(entry));
 
-		xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+		m_mutex.unlock();
 
 		// Resume
 		lockGui();
@@ -239,28 +247,34 @@ LaunchId AppManager::startAppForResult(const Intent& intent, ResultCallback call
 	entry.launchId = launchId;
 	entry.resultCallback = callback;
 	entry.context = std::move(ctx);
+	for (const auto& svcId: manifest.requiredServices) {
+		if (flx::services::ServiceRegistry::getInstance().retainService(svcId)) entry.retainedServices.push_back(svcId);
+	}
 
 	app->setContext(entry.context.get());
 	m_appStack.push_back(std::move(entry));
 
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 
 	// 4. Start lifecycle
 	lockGui();
-	if (!app->onStart()) {
-		Log::error("AppManager", "Failed to start app: %s", manifest.appId.c_str());
-		stopApp(manifest.appId, true); // Cleanup
-		unlockGui();
-		return LAUNCH_ID_INVALID;
+	{
+		FLX_TRACE_SCOPE("App::onStart");
+		if (!app->onStart()) {
+			Log::error("AppManager", "Failed to start app: %s", manifest.appId.c_str());
+			stopApp(manifest.appId, true); // Cleanup
+			unlockGui();
+			return LAUNCH_ID_INVALID;
+		}
+		app->setActive(true);
+		app->onResume();
 	}
-	app->setActive(true);
-	app->onResume();
 	unlockGui();
 
 	Log::info("AppManager", "Started app: %s (launchId=%lu, action=%s)", manifest.appId.c_str(), (unsigned long)launchId, intent.action.c_str());
 
 	notifyAppStarted(manifest.appId);
-	publishAppEvent(flx::core::Events::APP_STARTED, manifest.appId);
+	flx::core::publishAppEvent<flx::core::AppStarted>(manifest.appId);
 
 	Log::info("AppManager", "startAppForResult: Requesting Desktop openApp");
 
@@ -277,7 +291,7 @@ LaunchId AppManager::startAppForResult(const Intent& intent, ResultCallback call
 void AppManager::finishApp(LaunchId id, ResultCode resultCode, const flx::core::Bundle& resultData) {
 	if (id == LAUNCH_ID_INVALID) return;
 
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 
 	// Find in stack
 	auto it = m_appStack.begin();
@@ -289,7 +303,7 @@ void AppManager::finishApp(LaunchId id, ResultCode resultCode, const flx::core::
 	}
 
 	if (it == m_appStack.end()) {
-		xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+		m_mutex.unlock();
 		Log::error("AppManager", "finishApp: LaunchId %lu not found", (unsigned long)id);
 		return;
 	}
@@ -316,6 +330,7 @@ void AppManager::finishApp(LaunchId id, ResultCode resultCode, const flx::core::
 
 	if (app) app->setContext(nullptr);
 
+	releaseServices(*it);
 	m_appStack.erase(it);
 
 	// Delivery logic
@@ -327,7 +342,7 @@ void AppManager::finishApp(LaunchId id, ResultCode resultCode, const flx::core::
 		// If we wanted to track parent ID, we could.
 	}
 
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 
 	// Deliver to callback
 	if (resultCb) {
@@ -343,7 +358,7 @@ void AppManager::finishApp(LaunchId id, ResultCode resultCode, const flx::core::
 	}
 
 	notifyAppStopped(pkg);
-	publishAppEvent(flx::core::Events::APP_STOPPED, pkg);
+	flx::core::publishAppEvent<flx::core::AppStopped>(pkg);
 
 	// Close UI
 	lockGui();
@@ -352,7 +367,7 @@ void AppManager::finishApp(LaunchId id, ResultCode resultCode, const flx::core::
 }
 
 bool AppManager::stopApp(const std::string& packageName, bool closeUI) {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 
 	// Find in stack (could be multiple instances? For now assume finding last for that pkg)
 	// Iterate backwards to find latest
@@ -365,7 +380,7 @@ bool AppManager::stopApp(const std::string& packageName, bool closeUI) {
 	}
 
 	if (it == m_appStack.rend()) {
-		xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+		m_mutex.unlock();
 		return false; // Not running
 	}
 
@@ -386,6 +401,7 @@ bool AppManager::stopApp(const std::string& packageName, bool closeUI) {
 
 	if (app) app->setContext(nullptr);
 
+	releaseServices(*forward_it);
 	m_appStack.erase(forward_it);
 
 	// Resume previous if we removed the top
@@ -394,10 +410,10 @@ bool AppManager::stopApp(const std::string& packageName, bool closeUI) {
 		newTop = m_appStack.back().app;
 	}
 
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 
 	notifyAppStopped(packageName);
-	publishAppEvent(flx::core::Events::APP_STOPPED, packageName);
+	flx::core::publishAppEvent<flx::core::AppStopped>(packageName);
 
 	if (wasActive && newTop) {
 		lockGui();
@@ -415,13 +431,13 @@ bool AppManager::stopApp(const std::string& packageName, bool closeUI) {
 }
 
 void AppManager::stopCurrentApp() {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	if (m_appStack.empty()) {
-		xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+		m_mutex.unlock();
 		return;
 	}
 	auto app = m_appStack.back().app;
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 
 	if (app) {
 		stopApp(app->getPackageName());
@@ -429,15 +445,15 @@ void AppManager::stopCurrentApp() {
 }
 
 AppContext* AppManager::getContext(LaunchId id) const {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	for (const auto& entry: m_appStack) {
 		if (entry.launchId == id) {
 			auto* ctx = entry.context.get();
-			xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+			m_mutex.unlock();
 			return ctx;
 		}
 	}
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 	return nullptr;
 }
 
@@ -446,21 +462,21 @@ AppContext* AppManager::getContext(LaunchId id) const {
 // ============================================================
 
 size_t AppManager::getStackDepth() const {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	size_t depth = m_appStack.size();
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 	return depth;
 }
 
 bool AppManager::isAppInStack(const std::string& packageName) const {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	for (const auto& entry: m_appStack) {
 		if (entry.app && entry.app->getPackageName() == packageName) {
-			xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+			m_mutex.unlock();
 			return true;
 		}
 	}
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 	return false;
 }
 
@@ -468,6 +484,13 @@ bool AppManager::isAppInStack(const std::string& packageName) const {
 // Helper methods
 // ============================================================
 
+void AppManager::releaseServices(AppStackEntry& entry) {
+	for (const auto& svcId: entry.retainedServices) {
+		flx::services::ServiceRegistry::getInstance().releaseService(svcId);
+	}
+	entry.retainedServices.clear();
+}
+
 LaunchId AppManager::generateLaunchId() {
 	// Mutex should be held by caller
 	LaunchId id = m_nextLaunchId++;
@@ -476,12 +499,12 @@ LaunchId AppManager::generateLaunchId() {
 }
 
 void AppManager::update() {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	std::shared_ptr<App> activeApp = nullptr;
 	if (!m_appStack.empty()) {
 		activeApp = m_appStack.back().app;
 	}
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 
 	if (activeApp) {
 		lockGui();
@@ -495,12 +518,12 @@ const std::vector<std::shared_ptr<App>>& AppManager::getInstalledApps() const {
 }
 
 std::shared_ptr<App> AppManager::getCurrentApp() const {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	std::shared_ptr<App> app = nullptr;
 	if (!m_appStack.empty()) {
 		app = m_appStack.back().app;
 	}
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 	return app;
 }
 
@@ -508,36 +531,36 @@ void AppManager::addObserver(AppStateObserver* observer) {
 	if (!observer) {
 		return;
 	}
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	// Check if already added
 	for (auto* obs: m_observers) {
 		if (obs == observer) {
-			xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+			m_mutex.unlock();
 			return;
 		}
 	}
 	m_observers.push_back(observer);
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 }
 
 void AppManager::removeObserver(AppStateObserver* observer) {
 	if (!observer) {
 		return;
 	}
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	for (auto it = m_observers.begin(); it != m_observers.end(); ++it) {
 		if (*it == observer) {
 			m_observers.erase(it);
 			break;
 		}
 	}
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 }
 
 void AppManager::notifyAppStarted(const std::string& packageName) {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	auto observers = m_observers; // Copy to avoid holding lock during callbacks
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 
 	for (auto* observer: observers) {
 		observer->onAppStarted(packageName);
@@ -545,23 +568,17 @@ void AppManager::notifyAppStarted(const std::string& packageName) {
 }
 
 void AppManager::notifyAppStopped(const std::string& packageName) {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 	auto observers = m_observers; // Copy to avoid holding lock during callbacks
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 
 	for (auto* observer: observers) {
 		observer->onAppStopped(packageName);
 	}
 }
 
-void AppManager::publishAppEvent(const char* event, const std::string& appId) {
-	flx::core::Bundle data;
-	data.putString("appId", appId);
-	flx::core::EventBus::getInstance().publish(event, data);
-}
-
 void AppManager::performHealthCheck() {
-	xSemaphoreTake((SemaphoreHandle_t)m_mutex, portMAX_DELAY);
+	m_mutex.lock();
 
 	size_t stackSize = m_appStack.size();
 	std::string topApp = stackSize > 0 ? m_appStack.back().app->getPackageName() : "None";
@@ -569,7 +586,7 @@ void AppManager::performHealthCheck() {
 	int appCount = (int)m_apps.size();
 	Log::info("AppManager", "Health: %d apps registered, %zu in stack, Top: %s", appCount, stackSize, topApp.c_str());
 
-	xSemaphoreGive((SemaphoreHandle_t)m_mutex);
+	m_mutex.unlock();
 }
 
 } // namespace flx::apps
@@ -10,6 +10,8 @@
 #   _flx_generate_config_hpp()      — Emit constexpr Config.hpp from parsed YAML data
 #   _flx_generate_sdkconfig_frag()  — Emit sdkconfig.profile with LVGL/target/partition defaults
 #   _flx_configure_headless()       — Set HEADLESS_MODE, EXCLUDE_COMPONENTS, LV_USE_LOVYAN_GFX
+#   _flx_resolve_log_levels()       — Resolve per-module compile-time log floors from 'logging:'
+#   flx_apply_log_levels()          — After project(): add FLX_LOG_MIN_LEVEL to each module
 # ============================================================================
 
 # --------------------------------------------------------------------------
@@ -212,6 +214,24 @@ function(_flx_bool VAL OUT_VAR)
     endif()
 endfunction()
 
+# --------------------------------------------------------------------------
+# _flx_log_level_value(name out_var)
+#   Map a YAML log level name to its esp_log_level_t value. Empty = invalid.
+# --------------------------------------------------------------------------
+function(_flx_log_level_value NAME OUT_VAR)
+    string(TOLOWER "${NAME}" _lower)
+    set(_names none error warn info debug verbose)
+    list(FIND _names "${_lower}" _idx)
+    if(_idx EQUAL -1)
+        set(${OUT_VAR} "" PARENT_SCOPE)
+    else()
+        set(${OUT_VAR} "${_idx}" PARENT_SCOPE)
+    endif()
+endfunction()
+
+# FlxOS modules that compile flx::Log calls (component directory names)
+set(FLXOS_LOG_MODULES Core Kernel Services Apps HalModule Applications Firmware Connectivity System UI Profiles)
+
 # --------------------------------------------------------------------------
 # _flx_validate_profile(prefix)
 #   Validate required fields and enum values before code generation.
@@ -266,7 +286,60 @@ function(_flx_validate_profile PREFIX)
             "FlxOS: Invalid lvgl.ui_density '${_ui_density}'. Valid values: ${_valid_ui_density}")
     endif()
 
+    _flx_yaml_get("${PREFIX}" "logging_level" "verbose" _log_level)
+    _flx_log_level_value("${_log_level}" _log_level_value)
+    if("${_log_level_value}" STREQUAL "")
+        message(FATAL_ERROR
+            "FlxOS: Invalid logging.level '${_log_level}'. Valid values: none error warn info debug verbose")
+    endif()
+
     get_cmake_property(_all_vars VARIABLES)
+    foreach(_var IN LISTS _all_vars)
+        if("${_var}" MATCHES "^${PREFIX}_logging_modules_(.+)")
+            set(_log_module "${CMAKE_MATCH_1}")
+            list(FIND FLXOS_LOG_MODULES "${_log_module}" _log_module_idx)
+            if(_log_module_idx EQUAL -1)
+                message(FATAL_ERROR
+                    "FlxOS: Unknown module '${_log_module}' in logging.modules. Valid modules: ${FLXOS_LOG_MODULES}")
+            endif()
+            _flx_log_level_value("${${_var}}" _log_module_value)
+            if("${_log_module_value}" STREQUAL "")
+                message(FATAL_ERROR
+                    "FlxOS: Invalid level '${${_var}}' for logging.modules.${_log_module}. Valid values: none error warn info debug verbose")
+            endif()
+        endif()
+    endforeach()
+
+    foreach(_var IN LISTS _all_vars)
+        if("${_var}" MATCHES "^${PREFIX}_scheduling_tasks_(.+)_stack$")
+            set(_task_name "${CMAKE_MATCH_1}")
+            if(NOT "${${_var}}" MATCHES "^[0-9]+$" OR "${${_var}}" LESS 1024)
+                message(FATAL_ERROR
+                    "FlxOS: Invalid stack '${${_var}}' for scheduling.tasks.${_task_name}. Expected bytes, at least 1024")
+            endif()
+        elseif("${_var}" MATCHES "^${PREFIX}_scheduling_tasks_(.+)_core$")
+            set(_task_name "${CMAKE_MATCH_1}")
+            if(NOT "${${_var}}" MATCHES "^(0|1|any)$")
+                message(FATAL_ERROR
+                    "FlxOS: Invalid core '${${_var}}' for scheduling.tasks.${_task_name}. Valid values: 0 1 any")
+            endif()
+        elseif("${_var}" MATCHES "^${PREFIX}_scheduling_tasks_(.+)_priority$")
+            set(_task_name "${CMAKE_MATCH_1}")
+            if(NOT "${${_var}}" MATCHES "^[0-9]+$" OR "${${_var}}" GREATER 24)
+                message(FATAL_ERROR
+                    "FlxOS: Invalid priority '${${_var}}' for scheduling.tasks.${_task_name}. Expected 0-24")
+            endif()
+        endif()
+    endforeach()
+
+    foreach(_arena_key internal psram)
+        _flx_yaml_get("${PREFIX}" "scheduling_arena_${_arena_key}" "0" _arena_bytes)
+        if(NOT "${_arena_bytes}" MATCHES "^[0-9]+$")
+            message(FATAL_ERROR
+                "FlxOS: Invalid scheduling.arena.${_arena_key} '${_arena_bytes}'. Expected bytes")
+        endif()
+    endforeach()
+
     foreach(_var IN LISTS _all_vars)
         if("${_var}" MATCHES "^${PREFIX}_sdkconfig_(.+)")
             set(_sdk_key "${CMAKE_MATCH_1}")
@@ -490,6 +563,33 @@ function(_flx_generate_config_hpp PREFIX OUTPUT_FILE HWD_SOURCE_EXISTS)
     _b("capabilities_keyboard" "false" _cap_kbd)
     _b("capabilities_trackball" "false" _cap_tb)
 
+    # Boot-time arena for statically created tasks (flx::kernel::TaskArena)
+    _y("scheduling_arena_internal" "12288" _arena_internal)
+    _y("scheduling_arena_psram" "0" _arena_psram)
+
+    # Per-task placement: scheduling.tasks.<task name>.{stack, core, priority}
+    set(_sched_tasks "")
+    get_cmake_property(_sched_vars VARIABLES)
+    foreach(_var IN LISTS _sched_vars)
+        if("${_var}" MATCHES "^${PREFIX}_scheduling_tasks_(.+)_(stack|core|priority)$")
+            list(APPEND _sched_tasks "${CMAKE_MATCH_1}")
+        endif()
+    endforeach()
+    list(REMOVE_DUPLICATES _sched_tasks)
+    set(_sched_entries "")
+    foreach(_task IN LISTS _sched_tasks)
+        _y("scheduling_tasks_${_task}_stack" "0" _task_stack)
+        _y("scheduling_tasks_${_task}_core" "" _task_core)
+        _y("scheduling_tasks_${_task}_priority" "-1" _task_prio)
+        if("${_task_core}" STREQUAL "")
+            set(_task_core "TASK_CORE_UNSET")
+        elseif("${_task_core}" STREQUAL "any")
+            set(_task_core "TASK_CORE_ANY")
+        endif()
+        string(APPEND _sched_entries "    { \"${_task}\", ${_task_stack}, ${_task_core}, ${_task_prio} },\n")
+        message(STATUS "FlxOS: Task ${_task} → stack ${_task_stack}, core ${_task_core}, priority ${_task_prio}")
+    endforeach()
+
     # Build the file content
     set(_hpp "// ==========================================================================\n")
     string(APPEND _hpp "// FlxOS Config.hpp — AUTO-GENERATED by profile.cmake\n")
@@ -499,7 +599,10 @@ function(_flx_generate_config_hpp PREFIX OUTPUT_FILE HWD_SOURCE_EXISTS)
     string(APPEND _hpp "#pragma once\n\n")
 
     # Include SPI header (needed for spi_host_device_t type in structs)
-    string(APPEND _hpp "#include <driver/spi_master.h>\n\n")
+    string(APPEND _hpp "#include <cstdint>\n")
+    string(APPEND _hpp "#include <driver/spi_master.h>\n")
+    string(APPEND _hpp "#include <freertos/FreeRTOS.h>\n")
+    string(APPEND _hpp "#include <string_view>\n\n")
 
     # Preprocessor-level feature flags for #if guards (conditional includes)
     # These companion macros exist because #if directives cannot evaluate C++ constexpr.
@@ -602,6 +705,19 @@ function(_flx_generate_config_hpp PREFIX OUTPUT_FILE HWD_SOURCE_EXISTS)
     string(APPEND _hpp "    int maxCmdlineLength;\n")
     string(APPEND _hpp "};\n\n")
 
+    string(APPEND _hpp "struct TaskArenaConfig {\n")
+    string(APPEND _hpp "    uint32_t internalBytes, psramBytes;\n")
+    string(APPEND _hpp "};\n\n")
+
+    string(APPEND _hpp "inline constexpr int TASK_CORE_UNSET = -2;\n")
+    string(APPEND _hpp "inline constexpr int TASK_CORE_ANY = -1;\n\n")
+    string(APPEND _hpp "struct TaskSchedule {\n")
+    string(APPEND _hpp "    const char* name;\n")
+    string(APPEND _hpp "    uint32_t stackSize; // 0 = keep the task's own\n")
+    string(APPEND _hpp "    int core; // TASK_CORE_UNSET = keep, TASK_CORE_ANY = float\n")
+    string(APPEND _hpp "    int priority; // -1 = keep\n")
+    string(APPEND _hpp "};\n\n")
+
     string(APPEND _hpp "struct Capabilities {\n")
     string(APPEND _hpp "    bool wifi, bluetooth, ble, gps, lora, camera, audio, keyboard, trackball;\n")
     string(APPEND _hpp "};\n\n")
@@ -711,6 +827,42 @@ function(_flx_generate_config_hpp PREFIX OUTPUT_FILE HWD_SOURCE_EXISTS)
     string(APPEND _hpp "    .audio = ${_cap_audio}, .keyboard = ${_cap_kbd}, .trackball = ${_cap_tb},\n")
     string(APPEND _hpp "};\n\n")
 
+    string(APPEND _hpp "inline constexpr TaskArenaConfig taskArena { .internalBytes = ${_arena_internal}, .psramBytes = ${_arena_psram} };\n\n")
+
+    # Terminated by a null entry so the array is never empty
+    string(APPEND _hpp "inline constexpr TaskSchedule taskSchedule[] = {\n")
+    string(APPEND _hpp "${_sched_entries}")
+    string(APPEND _hpp "    { nullptr, 0, TASK_CORE_UNSET, -1 },\n")
+    string(APPEND _hpp "};\n\n")
+
+    string(APPEND _hpp "constexpr const TaskSchedule* findTaskSchedule(std::string_view name) {\n")
+    string(APPEND _hpp "    for (const auto& task : taskSchedule) {\n")
+    string(APPEND _hpp "        if (task.name && name == task.name) return &task;\n")
+    string(APPEND _hpp "    }\n")
+    string(APPEND _hpp "    return nullptr;\n")
+    string(APPEND _hpp "}\n\n")
+
+    string(APPEND _hpp "/// Stack size for the named task: the profile's override, else @p fallback\n")
+    string(APPEND _hpp "constexpr uint32_t taskStackSize(std::string_view name, uint32_t fallback) {\n")
+    string(APPEND _hpp "    const TaskSchedule* task = findTaskSchedule(name);\n")
+    string(APPEND _hpp "    return task && task->stackSize ? task->stackSize : fallback;\n")
+    string(APPEND _hpp "}\n\n")
+
+    string(APPEND _hpp "/// Core for the named task (tskNO_AFFINITY floats): the profile's choice, else @p fallback\n")
+    string(APPEND _hpp "constexpr BaseType_t taskCore(std::string_view name, BaseType_t fallback) {\n")
+    string(APPEND _hpp "    const TaskSchedule* task = findTaskSchedule(name);\n")
+    string(APPEND _hpp "    if (!task || task->core == TASK_CORE_UNSET) return fallback;\n")
+    string(APPEND _hpp "    // A core the chip does not have floats rather than failing task creation\n")
+    string(APPEND _hpp "    return task->core == TASK_CORE_ANY || task->core >= portNUM_PROCESSORS ? tskNO_AFFINITY : task->core;\n")
+    string(APPEND _hpp "}\n\n")
+
+    string(APPEND _hpp "/// Priority for the named task: the profile's choice, else @p fallback\n")
+    string(APPEND _hpp "constexpr UBaseType_t taskPriority(std::string_view name, UBaseType_t fallback) {\n")
+    string(APPEND _hpp "    const TaskSchedule* task = findTaskSchedule(name);\n")
+    string(APPEND _hpp "    if (!task || task->priority < 0) return fallback;\n")
+    string(APPEND _hpp "    return task->priority < configMAX_PRIORITIES ? task->priority : configMAX_PRIORITIES - 1;\n")
+    string(APPEND _hpp "}\n\n")
+
     string(APPEND _hpp "}  // namespace flx::config\n")
 
     file(WRITE "${OUTPUT_FILE}" "${_hpp}")
@@ -931,6 +1083,8 @@ function(_flx_generate_sdkconfig_frag PREFIX OUTPUT_FILE)
         string(APPEND _frag "\n# SPIRAM\n")
         string(APPEND _frag "CONFIG_SPIRAM=y\n")
         string(APPEND _frag "CONFIG_SPIRAM_MODE_OCT=y\n")
+        # TaskArena may place static task stacks in PSRAM
+        string(APPEND _frag "CONFIG_SPIRAM_ALLOW_STACK_EXTERNAL_MEMORY=y\n")
 
         # SPIRAM speed: 80M or 120M (120M requires flash freq to also be 120M)
         _y("hardware_spiram_speed" "80M" _spiram_speed)
@@ -992,6 +1146,49 @@ function(_flx_generate_sdkconfig_frag PREFIX OUTPUT_FILE)
     message(STATUS "FlxOS: Generated ${OUTPUT_FILE}")
 endfunction()
 
+# --------------------------------------------------------------------------
+# _flx_resolve_log_levels(prefix)
+#   Resolve the compile-time log floor of every module:
+#     logging:
+#       level: info          # default for all modules (default: verbose)
+#       modules:
+#         Kernel: warn       # per-module override
+#   Stored as FLXOS_LOG_LEVEL_<Module> cache entries for flx_apply_log_levels().
+# --------------------------------------------------------------------------
+function(_flx_resolve_log_levels PREFIX)
+    _flx_yaml_get("${PREFIX}" "logging_level" "verbose" _default_name)
+    _flx_log_level_value("${_default_name}" _default_value)
+    foreach(_module IN LISTS FLXOS_LOG_MODULES)
+        _flx_yaml_get("${PREFIX}" "logging_modules_${_module}" "${_default_name}" _module_name)
+        _flx_log_level_value("${_module_name}" _module_value)
+        set(FLXOS_LOG_LEVEL_${_module} "${_module_value}" CACHE INTERNAL "Compile-time log floor for ${_module}")
+        if(NOT "${_module_value}" STREQUAL "${_default_value}")
+            message(STATUS "FlxOS: Log level for ${_module} → ${_module_name}")
+        endif()
+    endforeach()
+    message(STATUS "FlxOS: Default compile-time log level → ${_default_name}")
+endfunction()
+
+# --------------------------------------------------------------------------
+# flx_apply_log_levels()
+#   Call after project(): define FLX_LOG_MIN_LEVEL privately on each FlxOS
+#   module so flx::Log compiles out calls below the module's floor.
+# --------------------------------------------------------------------------
+function(flx_apply_log_levels)
+    idf_build_get_property(_build_components BUILD_COMPONENTS)
+    foreach(_module IN LISTS FLXOS_LOG_MODULES)
+        if(NOT "${_module}" IN_LIST _build_components OR "$CACHE{FLXOS_LOG_LEVEL_${_module}}" STREQUAL "")
+            continue()
+        endif()
+        idf_component_get_property(_lib ${_module} COMPONENT_LIB)
+        get_target_property(_lib_type ${_lib} TYPE)
+        if("${_lib_type}" STREQUAL "INTERFACE_LIBRARY")
+            continue()
+        endif()
+        target_compile_definitions(${_lib} PRIVATE FLX_LOG_MIN_LEVEL=$CACHE{FLXOS_LOG_LEVEL_${_module}})
+    endforeach()
+endfunction()
+
 # --------------------------------------------------------------------------
 # flx_load_profile()
 #   Top-level function called from root CMakeLists.txt.
@@ -1126,6 +1323,9 @@ function(flx_load_profile)
     endif()
     _flx_generate_config_hpp("_FLX" "${_config_hpp}" "${_hwd_source_exists}")
 
+    # Per-module compile-time log floors (applied by flx_apply_log_levels())
+    _flx_resolve_log_levels("_FLX")
+
     # Generate sdkconfig.profile
     set(_sdkconfig_frag "${CMAKE_SOURCE_DIR}/sdkconfig.profile")
     _flx_generate_sdkconfig_frag("_FLX" "${_sdkconfig_frag}")
@@ -69,9 +69,13 @@ public:
 
 private:
 
+	static constexpr uint32_t USAGE_PERIOD_MS = 2000;
+	static constexpr uint32_t USAGE_SLACK_MS = 1000;
+
 	HotspotManager() = default;
 	~HotspotManager() = default;
 
+	static void updateUsage();
 	void updateClientHostname(uint8_t* mac, const std::string& hostname);
 	void checkAutoShutdown();
 
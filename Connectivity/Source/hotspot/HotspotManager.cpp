@@ -13,6 +13,7 @@
 #include <cstring>
 #include <flx/core/Logger.hpp>
 #include <flx/core/Observable.hpp>
+#include <flx/kernel/TimerWheel.hpp>
 #include <string_view>
 
 #include "esp_netif.h"
@@ -186,48 +187,50 @@ uint32_t HotspotManager::getUptime() const {
 }
 
 void HotspotManager::startUsageTimer() {
-	// Create timer to update usage (every 2 seconds)
-	// Uses esp_timer instead of lv_timer for headless compatibility
-	esp_timer_handle_t timer = nullptr;
-	esp_timer_create_args_t const timer_args = {
-		.callback = [](void* /*arg*/) {
-			HotspotManager& self = HotspotManager::getInstance();
-			if (self.isEnabled()) {
-				uint64_t const now = esp_timer_get_time();
-				uint64_t const dt_us = now - self.m_last_update_time;
-
-				if (dt_us > 0 && self.m_last_update_time > 0) {
-					float const dt_s = (float)dt_us / 1000000.0F;
-					self.m_upload_speed =
-						(uint32_t)((float)(self.m_bytes_sent - self.m_last_bytes_sent) /
-								   dt_s);
-					self.m_download_speed =
-						(uint32_t)((float)(self.m_bytes_received -
-										   self.m_last_bytes_received) /
-								   dt_s);
-				}
+	// Usage refresh every 2 seconds on the shared timer wheel (works headless,
+	// unlike lv_timer). Speeds divide by the measured interval, so the wide
+	// slack only delays the UI update and lets it share wake-ups.
+	static flx::kernel::TimerWheel::TimerId timer = flx::kernel::TimerWheel::INVALID_TIMER;
+	auto& wheel = flx::kernel::TimerWheel::getInstance();
+	if (timer == flx::kernel::TimerWheel::INVALID_TIMER) {
+		timer = wheel.create("hotspot_usage", &HotspotManager::updateUsage, USAGE_SLACK_MS);
+	}
+	wheel.startPeriodic(timer, USAGE_PERIOD_MS);
+}
 
-				self.m_last_update_time = now;
-				self.m_last_bytes_sent = self.m_bytes_sent;
-				self.m_last_bytes_received = self.m_bytes_received;
+void HotspotManager::updateUsage() {
+	HotspotManager& self = HotspotManager::getInstance();
+	if (!self.isEnabled()) {
+		return;
+	}
 
-				auto& cm = ConnectivityManager::getInstance();
-				cm.getHotspotUsageSentSubject().set((int32_t)(self.getBytesSent() / 1024));
-				cm.getHotspotUsageReceivedSubject().set((int32_t)(self.getBytesReceived() / 1024));
-				cm.getHotspotUploadSpeedSubject().set((int32_t)(self.getUploadSpeed() / 1024));
-				cm.getHotspotDownloadSpeedSubject().set((int32_t)(self.getDownloadSpeed() / 1024));
-				cm.getHotspotUptimeSubject().set((int32_t)self.getUptime());
+	uint64_t const now = esp_timer_get_time();
+	uint64_t const dt_us = now - self.m_last_update_time;
+
+	if (dt_us > 0 && self.m_last_update_time > 0) {
+		float const dt_s = (float)dt_us / 1000000.0F;
+		self.m_upload_speed =
+			(uint32_t)((float)(self.m_bytes_sent - self.m_last_bytes_sent) /
+					   dt_s);
+		self.m_download_speed =
+			(uint32_t)((float)(self.m_bytes_received -
+							   self.m_last_bytes_received) /
+					   dt_s);
+	}
 
-				self.checkAutoShutdown();
-			}
-		},
-		.arg = nullptr,
-		.dispatch_method = ESP_TIMER_TASK,
-		.name = "hotspot_usage",
-		.skip_unhandled_events = true,
-	};
-	esp_timer_create(&timer_args, &timer);
-	esp_timer_start_periodic(timer, 2000000); // 2 seconds in microseconds
+	self.m_last_update_time = now;
+	self.m_last_bytes_sent = self.m_bytes_sent;
+	self.m_last_bytes_received = self.m_bytes_received;
+
+	auto& cm = ConnectivityManager::getInstance();
+	flx::ObservableBatch batch; // One notification round for the whole usage sample
+	cm.getHotspotUsageSentSubject().set((int32_t)(self.getBytesSent() / 1024));
+	cm.getHotspotUsageReceivedSubject().set((int32_t)(self.getBytesReceived() / 1024));
+	cm.getHotspotUploadSpeedSubject().set((int32_t)(self.getUploadSpeed() / 1024));
+	cm.getHotspotDownloadSpeedSubject().set((int32_t)(self.getDownloadSpeed() / 1024));
+	cm.getHotspotUptimeSubject().set((int32_t)self.getUptime());
+
+	self.checkAutoShutdown();
 }
 
 void HotspotManager::checkAutoShutdown() {
@@ -10,6 +10,7 @@
 #include "esp_wifi_types_generic.h"
 #include <cstdint>
 #include <cstring>
+#include <flx/core/EventBus.hpp>
 #include <flx/core/Logger.hpp>
 #include <flx/core/Observable.hpp>
 #include <string>
@@ -227,6 +228,9 @@ void WiFiManager::handleStaDisconnected(void* event_data) {
 	auto* event = (wifi_event_sta_disconnected_t*)event_data;
 	Log::warn(TAG, "STA disconnected, reason: %d", event->reason);
 
+	// Connected/SSID/IP/status change together; notify observers once at scope exit
+	flx::ObservableBatch batch;
+
 	if (m_connected_subject) {
 		m_connected_subject->set(0);
 	}
@@ -258,6 +262,9 @@ void WiFiManager::handleStaDisconnected(void* event_data) {
 	} else {
 		setStatus(WiFiStatus::DISCONNECTED);
 	}
+
+	// Runs on the esp_event loop task: hand subscribers off to the dispatcher
+	flx::core::EventBus::getInstance().publishAsync(flx::core::Events::WIFI_DISCONNECTED, {}, {.coalesce = true});
 }
 
 void WiFiManager::handleStaConnected(void* event_data) {
@@ -302,14 +309,22 @@ void WiFiManager::ip_event_handler(void* arg, esp_event_base_t /*event_base*/, i
 		esp_ip4addr_ntoa(&event->ip_info.ip, ip_str, sizeof(ip_str));
 		Log::info(TAG, "Got IP: %s", ip_str);
 
-		if (self->m_ip_subject) {
-			self->m_ip_subject->set(ip_str);
+		{
+			flx::ObservableBatch batch;
+			if (self->m_ip_subject) {
+				self->m_ip_subject->set(ip_str);
+			}
+			if (self->m_connected_subject) {
+				self->m_connected_subject->set(1);
+			}
+			self->m_retry_count = 0;
+			self->setStatus(WiFiStatus::CONNECTED);
 		}
-		if (self->m_connected_subject) {
-			self->m_connected_subject->set(1);
-		}
-		self->m_retry_count = 0;
-		self->setStatus(WiFiStatus::CONNECTED);
+
+		flx::core::Bundle data;
+		data.putString("ssid", self->m_ssid_subject ? self->m_ssid_subject->get() : std::string());
+		data.putString("ip", ip_str);
+		flx::core::EventBus::getInstance().publishAsync(flx::core::Events::WIFI_CONNECTED, data);
 
 		if (self->m_got_ip_callback) {
 			self->m_got_ip_callback();
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace flx::core {
+
+/**
+ * @brief Discovery results kept on /system between boots
+ *
+ * Boot steps that work something out (the service boot order, the SD
+ * card that was inserted) store the answer under a key and look it up on
+ * the next boot. The file is keyed by the firmware's ELF hash and the
+ * profile id; load() discards it when either differs, so a new build or
+ * board always starts cold.
+ *
+ * Each user validates its own entry (a manifest signature, the card serial
+ * and capacity) and puts a fresh answer when the check fails. save()
+ * writes the file only when something changed.
+ *
+ * File format (text, one entry per line, keys without spaces):
+ *   flxcache 1
+ *   key <elf sha256 prefix> <profile id>
+ *   <key> <value>
+ *   ...
+ *   end
+ */
+class BootCache {
+public:
+
+	static constexpr const char* PATH = "/system/boot.cache";
+
+	struct Stats {
+		std::string key;
+		bool warm; ///< A cache for this firmware and profile was loaded
+		uint32_t hits;
+		uint32_t misses;
+		uint32_t updates;
+	};
+
+	static BootCache& getInstance();
+
+	/** Read PATH; keeps nothing unless it was written by this firmware for @p profileId */
+	void load(const std::string& profileId);
+
+	/** @return true and the value if @p key is cached */
+	bool get(const std::string& key, std::string& value);
+
+	void put(const std::string& key, const std::string& value);
+	void invalidate(const std::string& key);
+
+	/** Drop every entry and delete the file; the next boot probes everything */
+	void clear();
+
+	/** Write PATH if an entry changed since load(); blocks on the filesystem */
+	bool save();
+
+	Stats getStats() const;
+	std::vector<std::pair<std::string, std::string>> getEntries() const;
+
+private:
+
+	BootCache() = default;
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::string> m_entries;
+	std::string m_key;
+	bool m_warm = false;
+	bool m_dirty = false;
+	uint32_t m_hits = 0;
+	uint32_t m_misses = 0;
+	uint32_t m_updates = 0;
+};
+
+} // namespace flx::core
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace flx::core {
+
+/**
+ * @brief Phase timestamps for one boot, persisted to /system
+ *
+ * Boot code records named phases (app_main, each mount, each service
+ * start, display init, desktop init, first frame) against esp_timer time,
+ * i.e. microseconds since the chip started. freeze() ends the boot; save()
+ * then writes the timeline next to the one from the previous boot so two
+ * builds can be compared on the device ('boottime') or on the host
+ * ('flxos.py boottime compare').
+ *
+ * Recording never allocates or blocks. Phases recorded after freeze(), or
+ * beyond MAX_PHASES, are ignored.
+ *
+ * File format (text, one record per line):
+ *   flxboot 1
+ *   build <version> <elf sha256 prefix>
+ *   reset <esp_reset_reason_t>
+ *   <start_us> <end_us> <name>
+ *   ...
+ *   end
+ */
+class BootTimeline {
+public:
+
+	static constexpr size_t MAX_PHASES = 64;
+	static constexpr size_t NAME_LEN = 32;
+	static constexpr const char* PATH = "/system/boot.tl";
+	static constexpr const char* PREVIOUS_PATH = "/system/boot.prev.tl";
+
+	struct Phase {
+		char name[NAME_LEN];
+		uint32_t startUs;
+		uint32_t endUs; ///< Equal to startUs for a point mark
+	};
+
+	struct Timeline {
+		std::string build;
+		int resetReason = 0;
+		std::vector<Phase> phases; ///< In recording order
+	};
+
+	/** Record a phase that ran from @p startUs to @p endUs (esp_timer time) */
+	static void record(const char* name, int64_t startUs, int64_t endUs);
+
+	/** Record a point in time */
+	static void mark(const char* name);
+
+	/** Stop recording; the boot is over */
+	static void freeze() { s_frozen.store(true, std::memory_order_release); }
+	static bool isFrozen() { return s_frozen.load(std::memory_order_acquire); }
+
+	/** Phases recorded so far in this boot */
+	static Timeline current();
+
+	/**
+	 * Move the previous boot's file to PREVIOUS_PATH and write this one to
+	 * PATH. Blocks on the filesystem; call off the GUI task.
+	 */
+	static bool save();
+
+	/** Write @p timeline in the file format */
+	static void write(FILE* out, const Timeline& timeline);
+
+	/** Read a timeline written by save(); false if missing or malformed */
+	static bool load(const char* path, Timeline& out);
+
+private:
+
+	static inline std::atomic<bool> s_frozen {false};
+};
+
+/** RAII phase: records from construction to destruction */
+class BootPhase {
+public:
+
+	explicit BootPhase(const char* name);
+	~BootPhase();
+
+	BootPhase(const BootPhase&) = delete;
+	BootPhase& operator=(const BootPhase&) = delete;
+
+private:
+
+	const char* m_name;
+	int64_t m_startUs;
+};
+
+} // namespace flx::core
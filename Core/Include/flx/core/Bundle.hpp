@@ -1,9 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <variant>
 #include <vector>
 
 namespace flx::core {
@@ -19,6 +20,16 @@ namespace flx::core {
  * - Binary blob support (std::vector<uint8_t>)
  * - Nested Bundle support for complex structured data
  * - Introspection APIs: size(), clear(), hasKey(), keys()
+ *
+ * Storage: entries are kept sorted by key in a small vector with room for
+ * INLINE_CAPACITY entries inside the Bundle itself, spilling to the heap only
+ * beyond that. Each value is a single std::variant, and keys rely on
+ * std::string's small-string buffer, so a typical 1–2 key event payload with
+ * short strings is built and copied without touching the heap.
+ *
+ * An inline entry is 56 bytes on the 32-bit targets, and Bundles sit in every
+ * EventBus async ring slot and on task stacks, so the inline capacity stays
+ * small (sizeof(Bundle) is 128 bytes there).
  */
 class Bundle final {
 public:
@@ -36,8 +47,8 @@ public:
 	Bundle() = default;
 	Bundle(const Bundle& other);
 	Bundle& operator=(const Bundle& other);
-	Bundle(Bundle&&) = default;
-	Bundle& operator=(Bundle&&) = default;
+	Bundle(Bundle&& other) noexcept;
+	Bundle& operator=(Bundle&& other) noexcept;
 	~Bundle() = default;
 
 	// === Typed putters ===
@@ -97,29 +108,46 @@ public:
 
 private:
 
-	struct Value {
-		Type type;
-		union {
-			bool valueBool;
-			int32_t valueInt32;
-			int64_t valueInt64;
-			float valueFloat;
-		};
-		std::string valueString;
-		std::vector<uint8_t> valueBlob;
-		std::unique_ptr<Bundle> valueBundle;
-
-		Value() : type(Type::Bool), valueBool(false) {}
-		Value(const Value& other);
-		Value& operator=(const Value& other);
-		Value(Value&&) = default;
-		Value& operator=(Value&&) = default;
-		~Value() = default;
+	friend class BundleWriter; // Encodes entries directly (BundleCodec.hpp)
+
+	static constexpr size_t INLINE_CAPACITY = 2;
+
+	/// Owning pointer with deep-copy semantics for nested bundles
+	struct NestedBundle {
+		std::unique_ptr<Bundle> ptr;
+
+		NestedBundle() = default;
+		explicit NestedBundle(const Bundle& value) : ptr(std::make_unique<Bundle>(value)) {}
+		NestedBundle(const NestedBundle& other) : ptr(other.ptr ? std::make_unique<Bundle>(*other.ptr) : nullptr) {}
+		NestedBundle& operator=(const NestedBundle& other) {
+			if (this != &other) ptr = other.ptr ? std::make_unique<Bundle>(*other.ptr) : nullptr;
+			return *this;
+		}
+		NestedBundle(NestedBundle&&) noexcept = default;
+		NestedBundle& operator=(NestedBundle&&) noexcept = default;
 	};
 
-	std::unordered_map<std::string, Value> m_entries;
+	// Alternative order matches Type
+	using Value = std::variant<bool, int32_t, int64_t, float, std::string, std::vector<uint8_t>, NestedBundle>;
 
+	struct Entry {
+		std::string key;
+		Value value;
+	};
+
+	std::array<Entry, INLINE_CAPACITY> m_inline {};
+	std::vector<Entry> m_spill; // Holds all entries once size exceeds INLINE_CAPACITY
+	size_t m_size = 0;
+
+	Entry* entries() { return m_spill.empty() ? m_inline.data() : m_spill.data(); }
+	const Entry* entries() const { return m_spill.empty() ? m_inline.data() : m_spill.data(); }
+
+	const Entry* findEntry(const std::string& key) const;
 	const Value* findEntry(const std::string& key, Type expectedType) const;
+	void put(const std::string& key, Value&& value);
 };
 
+// Checked on the 32-bit targets only; host builds have wider strings
+static_assert(sizeof(void*) != 4 || sizeof(Bundle) <= 128, "Bundle grew; it is stored by value in async ring slots and on task stacks");
+
 } // namespace flx::core
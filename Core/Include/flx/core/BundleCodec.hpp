@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <flx/core/Bundle.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace flx::core {
+
+/**
+ * @brief Versioned binary encoding for Bundle
+ *
+ * Layout (all integers little-endian):
+ *
+ *   Document : "FXB" u8 version  Body
+ *   Body     : u32 entriesLength  u16 entryCount  Entry*
+ *   Entry    : u8 type  u8 keyLength  key[keyLength]  Payload
+ *   Payload  : Bool u8 | Int32 i32 | Int64 i64 | Float f32
+ *            | String/Blob u32 length + bytes | Bundle Body
+ *
+ * Entries are written in Bundle key order. Every variable-size payload is
+ * length-prefixed, so readers can skip entries without decoding them.
+ */
+namespace bundle_codec {
+inline constexpr uint8_t MAGIC[3] = {'F', 'X', 'B'};
+inline constexpr uint8_t VERSION = 1;
+inline constexpr size_t HEADER_SIZE = 4;
+inline constexpr size_t MAX_KEY_LENGTH = 255;
+inline constexpr int MAX_DEPTH = 8; ///< Nesting limit enforced when parsing
+} // namespace bundle_codec
+
+/**
+ * @brief Read-only blob slice inside an encoded Bundle
+ */
+struct BlobView {
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+};
+
+/**
+ * @brief Zero-copy view over an encoded Bundle
+ *
+ * Answers typed queries directly from the encoded bytes. Strings and blobs
+ * are returned as views into the buffer, which must outlive the view.
+ * Missing keys or type mismatches return the default value.
+ */
+class BundleView {
+public:
+
+	BundleView() = default;
+
+	/**
+	 * Validate a complete document (header + body) and return a view of it.
+	 * Returns an invalid view if the magic, version or structure is wrong.
+	 */
+	static BundleView parse(const uint8_t* data, size_t size);
+
+	bool isValid() const { return m_data != nullptr; }
+	size_t size() const { return m_count; }
+	bool empty() const { return m_count == 0; }
+
+	bool hasKey(std::string_view key) const;
+	bool hasType(std::string_view key, Bundle::Type type) const;
+
+	bool getBool(std::string_view key, bool defaultValue = false) const;
+	int32_t getInt32(std::string_view key, int32_t defaultValue = 0) const;
+	int64_t getInt64(std::string_view key, int64_t defaultValue = 0) const;
+	float getFloat(std::string_view key, float defaultValue = 0.0f) const;
+	std::string_view getString(std::string_view key) const;
+	BlobView getBlob(std::string_view key) const;
+	BundleView getBundle(std::string_view key) const;
+
+	/** Materialise an owning Bundle (deep, including nested bundles) */
+	Bundle toBundle() const;
+
+private:
+
+	struct Field {
+		Bundle::Type type;
+		const uint8_t* payload;
+		size_t payloadSize;
+	};
+
+	BundleView(const uint8_t* entries, size_t length, uint16_t count) : m_data(entries), m_length(length), m_count(count) {}
+
+	bool find(std::string_view key, Field& out) const;
+	static bool validateBody(const uint8_t* data, size_t size, size_t& consumed, int depth);
+
+	const uint8_t* m_data = nullptr; // First entry
+	size_t m_length = 0; // Bytes of entry data
+	uint16_t m_count = 0;
+};
+
+/**
+ * @brief Streaming Bundle encoder
+ *
+ * Appends entries to an output buffer as they are produced, so callers can
+ * snapshot state without building an intermediate Bundle. Nested bundles are
+ * opened with beginBundle() and closed with endBundle(); their length prefix
+ * is back-patched on close.
+ *
+ *   std::vector<uint8_t> out;
+ *   BundleWriter w(out);
+ *   w.putString("appId", id);
+ *   w.beginBundle("state");
+ *   w.putInt32("scroll", y);
+ *   w.endBundle();
+ *   w.finish();
+ *
+ * Keys must be unique within a bundle. Putters return false once the
+ * writer has failed (key too long, unbalanced nesting).
+ */
+class BundleWriter {
+public:
+
+	explicit BundleWriter(std::vector<uint8_t>& out);
+
+	bool putBool(std::string_view key, bool value);
+	bool putInt32(std::string_view key, int32_t value);
+	bool putInt64(std::string_view key, int64_t value);
+	bool putFloat(std::string_view key, float value);
+	bool putString(std::string_view key, std::string_view value);
+	bool putBlob(std::string_view key, const uint8_t* data, size_t size);
+	bool putBundle(std::string_view key, const Bundle& value);
+
+	bool beginBundle(std::string_view key);
+	bool endBundle();
+
+	/** Append every entry of @p bundle to the bundle currently open */
+	bool putAll(const Bundle& bundle);
+
+	/**
+	 * Close the document. Returns false if nesting is unbalanced or a
+	 * previous put failed; the output is then not a valid document.
+	 */
+	bool finish();
+
+	bool ok() const { return !m_failed; }
+
+private:
+
+	struct Frame {
+		size_t lengthOffset; // Offset of the body's u32 length field
+		uint16_t count;
+	};
+
+	bool beginEntry(Bundle::Type type, std::string_view key);
+	void openBody();
+	void closeBody();
+
+	std::vector<uint8_t>& m_out;
+	std::vector<Frame> m_frames;
+	bool m_failed = false;
+	bool m_finished = false;
+};
+
+// ──────── Convenience ────────
+
+/** Encode a Bundle into a new document */
+std::vector<uint8_t> encodeBundle(const Bundle& bundle);
+
+/** Decode a document into @p out; returns false (and leaves @p out empty) on malformed input */
+bool decodeBundle(const uint8_t* data, size_t size, Bundle& out);
+
+/** Atomically write a Bundle document to @p path (temp file + rename) */
+bool saveBundleToFile(const std::string& path, const Bundle& bundle);
+
+/** Read and decode a Bundle document from @p path */
+bool loadBundleFromFile(const std::string& path, Bundle& out);
+
+} // namespace flx::core
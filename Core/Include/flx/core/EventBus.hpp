@@ -1,8 +1,12 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <deque>
 #include <flx/core/Bundle.hpp>
+#include <flx/core/LockProfiler.hpp>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -10,6 +14,20 @@
 
 namespace flx::core {
 
+/// Delivery priority for asynchronous events (higher drains first)
+enum class EventPriority : uint8_t {
+	Low,
+	Normal,
+	High,
+};
+
+/// Options for EventBus::publishAsync()
+struct AsyncEventOptions {
+	EventPriority priority = EventPriority::Normal;
+	/// Replace the payload of an identical event still at the tail of the queue instead of queueing another
+	bool coalesce = false;
+};
+
 /**
  * @brief System-wide publish/subscribe event bus
  *
@@ -24,6 +42,24 @@ namespace flx::core {
  * - "sdcard.unmounted"  — Bundle: {}
  * - "app.installed"     — Bundle: { "appId": string }
  * - "app.uninstalled"   — Bundle: { "appId": string }
+ * - "service.started"   — Bundle: { "serviceId": string }
+ * - "service.stopped"   — Bundle: { "serviceId": string }
+ * - "service.failed"    — Bundle: { "serviceId": string }
+ *
+ * Hot system events are also available as typed, allocation-free channels
+ * (see EventChannel.hpp / SystemEvents.hpp); Bundle listeners still receive them.
+ *
+ * Dispatch is topic-indexed: event names are interned to integer TopicIds
+ * once (at subscribe time, or at the publish site via registerTopic()), and
+ * each topic keeps a pre-merged, copy-on-write list of its subscribers.
+ * Publishing costs O(matching subscribers) and does not allocate.
+ *
+ * Hierarchical wildcards are supported: subscribing to "wifi.*" receives
+ * "wifi.connected", "wifi.scan.done", etc. "*" matches every event.
+ *
+ * publishAsync() enqueues into bounded per-priority ring buffers that are
+ * drained by the kernel's EventDispatcherTask, so producers (esp_event
+ * handlers, esp_timer callbacks) never run subscriber code on their own task.
  *
  * Thread-safe: all methods can be called from any task/thread.
  */
@@ -31,18 +67,55 @@ class EventBus {
 public:
 
 	using SubscriptionId = uint32_t;
+	using TopicId = uint32_t;
 	using Callback = std::function<void(const std::string& event, const Bundle& data)>;
 
+	static constexpr TopicId INVALID_TOPIC = UINT32_MAX;
+
+	using Priority = EventPriority;
+	using AsyncOptions = AsyncEventOptions;
+
+	static constexpr size_t PRIORITY_COUNT = 3;
+	static constexpr size_t ASYNC_QUEUE_DEPTH = 16; ///< Slots per priority ring
+
+	struct AsyncStats {
+		uint32_t enqueued[PRIORITY_COUNT] {};
+		uint32_t overflow[PRIORITY_COUNT] {}; ///< Events dropped because the ring was full
+		uint32_t coalesced = 0;
+		uint32_t delivered = 0;
+		uint32_t highWater = 0; ///< Max pending events observed across all rings
+		uint32_t pending = 0;
+	};
+
 	static EventBus& getInstance();
 
+	/**
+	 * Intern an event name and return its topic ID.
+	 * Publish sites on hot paths should resolve their topic once
+	 * (e.g. into a function-local static) and use publish(TopicId, ...).
+	 * @param event Event name (e.g. "wifi.connected") or wildcard pattern ("wifi.*")
+	 */
+	TopicId registerTopic(const std::string& event);
+
+	/**
+	 * Get the name of an interned topic (empty string if unknown).
+	 */
+	const std::string& getTopicName(TopicId topic) const;
+
 	/**
 	 * Subscribe to a specific event.
-	 * @param event Event name to listen for (e.g. "wifi.connected")
+	 * @param event Event name to listen for (e.g. "wifi.connected"),
+	 *              or a hierarchical wildcard (e.g. "wifi.*")
 	 * @param callback Function called when the event is published
 	 * @return Subscription ID for later unsubscription
 	 */
 	SubscriptionId subscribe(const std::string& event, Callback callback);
 
+	/**
+	 * Subscribe to an already interned topic.
+	 */
+	SubscriptionId subscribe(TopicId topic, Callback callback);
+
 	/**
 	 * Subscribe to all events (wildcard listener).
 	 * @param callback Function called for every published event
@@ -57,11 +130,65 @@ public:
 
 	/**
 	 * Publish an event to all subscribers.
+	 * A name that was never subscribed to or registered is not interned;
+	 * it reaches only matching wildcard and subscribeAll() listeners.
 	 * @param event Event name
 	 * @param data Optional event payload
 	 */
 	void publish(const std::string& event, const Bundle& data = {});
 
+	/**
+	 * Publish an event to all subscribers of an interned topic.
+	 * Allocation-free; invalid topic IDs are ignored.
+	 */
+	void publish(TopicId topic, const Bundle& data = {});
+
+	/**
+	 * Queue an event for delivery on the event dispatcher task.
+	 * Never blocks on subscribers; drops (and counts) the event if the
+	 * ring for its priority is full.
+	 * @return true if the event was queued or coalesced
+	 */
+	bool publishAsync(TopicId topic, const Bundle& data = {}, AsyncOptions options = {});
+	bool publishAsync(const std::string& event, const Bundle& data = {}, AsyncOptions options = {});
+
+	/**
+	 * Deliver pending asynchronous events, highest priority first.
+	 * Called by the dispatcher task.
+	 * @param maxEvents Upper bound on events delivered in this call
+	 * @return Number of events delivered
+	 */
+	size_t drainAsync(size_t maxEvents = SIZE_MAX);
+
+	/**
+	 * Install the hook used to wake the dispatcher after an enqueue.
+	 * Decouples Core from the kernel task that owns the drain loop.
+	 */
+	void setAsyncWakeup(std::function<void()> wakeup);
+
+	AsyncStats getAsyncStats() const;
+	void resetAsyncStats();
+
+	/**
+	 * Install a hook called with the event name (or wildcard pattern) after
+	 * each subscribe(). Runs on the subscriber's task, outside the bus lock.
+	 * Lets the service registry start lazy services when their topics gain
+	 * a listener without Core knowing about services.
+	 */
+	void setSubscribeHook(std::function<void(const std::string& event)> hook);
+
+	/**
+	 * Check whether publishing to a topic would reach any subscriber
+	 * (direct, wildcard or subscribeAll).
+	 */
+	bool hasSubscribers(TopicId topic) const;
+
+	/** Number of interned topics (diagnostics) */
+	size_t getTopicCount() const;
+
+	/** Number of active subscriptions (diagnostics) */
+	size_t getSubscriptionCount() const;
+
 private:
 
 	EventBus() = default;
@@ -71,13 +198,56 @@ private:
 
 	struct Subscription {
 		SubscriptionId id;
-		std::string event; // Empty = wildcard (all events)
-		Callback callback;
+		std::shared_ptr<const Callback> callback;
 	};
 
-	std::vector<Subscription> m_subscriptions;
+	using DispatchList = std::vector<Subscription>;
+
+	struct Topic {
+		std::string name;
+		std::string wildcardPrefix; // "wifi." for "wifi.*", "" for "*"
+		bool isWildcard = false;
+		std::vector<Subscription> subscribers; // Direct subscribers only
+		std::shared_ptr<const DispatchList> dispatch; // Direct + matching wildcards + subscribeAll, ordered by id
+	};
+
+	static constexpr TopicId ALL_TOPICS = INVALID_TOPIC - 1;
+
+	struct AsyncEvent {
+		TopicId topic = INVALID_TOPIC;
+		bool coalesce = false;
+		Bundle data;
+	};
+
+	struct AsyncRing {
+		std::array<AsyncEvent, ASYNC_QUEUE_DEPTH> slots {};
+		size_t head = 0;
+		size_t count = 0;
+	};
+
+	// All private helpers expect m_mutex to be held
+	TopicId internLocked(const std::string& event);
+	SubscriptionId addSubscriptionLocked(TopicId topic, Callback callback);
+	DispatchList collectListenersLocked(const std::string& name, const Topic* topic) const;
+	void rebuildDispatchLocked(Topic& topic);
+	void rebuildMatchingLocked(const Topic& pattern);
+	void rebuildAllLocked();
+
+	std::deque<Topic> m_topics; // Deque keeps Topic references stable on growth
+	std::unordered_map<std::string, TopicId> m_topicIndex;
+	std::vector<Subscription> m_globalSubscribers;
+	size_t m_wildcardSubscriptions = 0; // Lets publish() of an unknown name skip the wildcard scan
+	std::unordered_map<SubscriptionId, TopicId> m_subscriptionTopics;
 	SubscriptionId m_nextId = 1;
-	mutable std::mutex m_mutex;
+	std::function<void(const std::string&)> m_subscribeHook;
+	using Mutex = ProfiledMutex<std::mutex>;
+	mutable Mutex m_mutex {"event_bus"};
+
+	// Async delivery state (separate lock so producers never wait on dispatch bookkeeping)
+	std::array<AsyncRing, PRIORITY_COUNT> m_asyncRings {};
+	AsyncStats m_asyncStats {};
+	std::function<void()> m_asyncWakeup;
+	mutable std::mutex m_asyncMutex;
 };
 
 // Standard event name constants
@@ -90,6 +260,9 @@ constexpr const char* SDCARD_MOUNTED = "sdcard.mounted";
 constexpr const char* SDCARD_UNMOUNTED = "sdcard.unmounted";
 constexpr const char* APP_INSTALLED = "app.installed";
 constexpr const char* APP_UNINSTALLED = "app.uninstalled";
+constexpr const char* SERVICE_STARTED = "service.started";
+constexpr const char* SERVICE_STOPPED = "service.stopped";
+constexpr const char* SERVICE_FAILED = "service.failed";
 } // namespace Events
 
 } // namespace flx::core
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <flx/core/Bundle.hpp>
+#include <flx/core/EventBus.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace flx::core {
+
+/**
+ * @brief Compile-time typed event channel with zero-allocation delivery
+ *
+ * Each payload type gets its own channel. Payloads are trivially copyable
+ * structs delivered to typed subscribers by const reference; publishing
+ * never touches the heap.
+ *
+ * A payload type must provide:
+ * - `static constexpr const char* TOPIC` — the EventBus topic it maps to
+ * - `void toBundle(Bundle& out) const`   — conversion for Bundle listeners
+ *
+ * Bridge: string/wildcard/subscribeAll listeners on the EventBus keep
+ * working. A Bundle is materialised only when the mapped topic actually has
+ * EventBus subscribers, so typed-only topics stay allocation-free.
+ *
+ * Usage:
+ *   EventChannel<AppStarted>::getInstance().subscribe([](const AppStarted& e) { ... });
+ *   EventChannel<AppStarted>::getInstance().publish(AppStarted::make(appId));
+ */
+template<typename T>
+class EventChannel {
+	static_assert(std::is_trivially_copyable_v<T>, "EventChannel payloads must be trivially copyable");
+
+public:
+
+	using SubscriptionId = uint32_t;
+	using Handler = std::function<void(const T& event)>;
+
+	static EventChannel& getInstance() {
+		static EventChannel instance;
+		return instance;
+	}
+
+	/**
+	 * Subscribe to typed events.
+	 * @return Subscription ID for later unsubscription
+	 */
+	SubscriptionId subscribe(Handler handler) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		SubscriptionId id = m_nextId++;
+		auto list = m_handlers ? std::make_shared<HandlerList>(*m_handlers) : std::make_shared<HandlerList>();
+		list->push_back({id, std::move(handler)});
+		m_handlers = std::move(list);
+		return id;
+	}
+
+	void unsubscribe(SubscriptionId id) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_handlers) return;
+		auto list = std::make_shared<HandlerList>(*m_handlers);
+		list->erase(std::remove_if(list->begin(), list->end(), [id](const Entry& e) { return e.id == id; }), list->end());
+		if (list->empty()) {
+			m_handlers.reset();
+		} else {
+			m_handlers = std::move(list);
+		}
+	}
+
+	/**
+	 * Deliver to typed subscribers, then bridge to Bundle listeners if any.
+	 */
+	void publish(const T& event) {
+		std::shared_ptr<const HandlerList> handlers;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			handlers = m_handlers;
+		}
+		if (handlers) {
+			for (const auto& entry: *handlers) {
+				if (entry.handler) entry.handler(event);
+			}
+		}
+
+		auto& bus = EventBus::getInstance();
+		if (bus.hasSubscribers(m_topic)) {
+			Bundle data;
+			event.toBundle(data);
+			bus.publish(m_topic, data);
+		}
+	}
+
+	EventBus::TopicId getTopic() const { return m_topic; }
+
+private:
+
+	struct Entry {
+		SubscriptionId id;
+		Handler handler;
+	};
+
+	using HandlerList = std::vector<Entry>;
+
+	EventChannel() : m_topic(EventBus::getInstance().registerTopic(T::TOPIC)) {}
+	~EventChannel() = default;
+	EventChannel(const EventChannel&) = delete;
+	EventChannel& operator=(const EventChannel&) = delete;
+
+	const EventBus::TopicId m_topic;
+	std::shared_ptr<const HandlerList> m_handlers; // Copy-on-write, snapshot per publish
+	SubscriptionId m_nextId = 1;
+	std::mutex m_mutex;
+};
+
+/**
+ * Copy a string into a fixed-size, always NUL-terminated payload field
+ * (truncating if necessary).
+ * @return false if @p src was truncated
+ */
+template<size_t N>
+inline bool copyEventString(char (&dst)[N], std::string_view src) {
+	size_t len = std::min(src.size(), N - 1);
+	std::memcpy(dst, src.data(), len);
+	dst[len] = '\0';
+	return len == src.size();
+}
+
+} // namespace flx::core
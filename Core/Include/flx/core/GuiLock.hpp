@@ -2,7 +2,9 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include <flx/core/LockProfiler.hpp>
 #include <flx/core/Singleton.hpp>
+#include <source_location>
 
 namespace flx::core {
 
@@ -11,34 +13,45 @@ class GuiLock : public flx::Singleton<GuiLock> {
 
 public:
 
-	static void lock() {
-		auto& instance = getInstance();
-		if (instance.m_semaphore) {
-			xSemaphoreTakeRecursive(instance.m_semaphore, portMAX_DELAY);
-		}
+	/** Callers' file and line show up as holders in the lock profile */
+	static void lock(const std::source_location& site = std::source_location::current()) {
+		getInstance().m_mutex.lock(site);
 	}
 
 	static void unlock() {
-		auto& instance = getInstance();
-		if (instance.m_semaphore) {
-			xSemaphoreGiveRecursive(instance.m_semaphore);
-		}
+		getInstance().m_mutex.unlock();
 	}
 
 private:
 
-	GuiLock() {
-		m_semaphore = xSemaphoreCreateRecursiveMutex();
-		configASSERT(m_semaphore != nullptr);
-	}
-	~GuiLock() {
-		if (m_semaphore) {
-			vSemaphoreDelete(m_semaphore);
-			m_semaphore = nullptr;
+	/** Recursive FreeRTOS mutex with the Lockable interface ProfiledMutex expects */
+	class Semaphore {
+	public:
+
+		Semaphore() {
+			m_handle = xSemaphoreCreateRecursiveMutex();
+			configASSERT(m_handle != nullptr);
 		}
-	}
+		~Semaphore() {
+			if (m_handle) {
+				vSemaphoreDelete(m_handle);
+				m_handle = nullptr;
+			}
+		}
+
+		void lock() { xSemaphoreTakeRecursive(m_handle, portMAX_DELAY); }
+		bool try_lock() { return xSemaphoreTakeRecursive(m_handle, 0) == pdTRUE; }
+		void unlock() { xSemaphoreGiveRecursive(m_handle); }
+
+	private:
+
+		SemaphoreHandle_t m_handle = nullptr;
+	};
+
+	GuiLock() = default;
+	~GuiLock() = default;
 
-	SemaphoreHandle_t m_semaphore = nullptr;
+	ProfiledMutex<Semaphore> m_mutex {"gui"};
 };
 
 } // namespace flx::core
@@ -8,7 +8,7 @@ namespace flx::core {
  * @brief RAII wrapper for GuiLock
  */
 struct GuiLockGuard {
-	GuiLockGuard() noexcept { flx::core::GuiLock::lock(); }
+	explicit GuiLockGuard(const std::source_location& site = std::source_location::current()) noexcept { flx::core::GuiLock::lock(site); }
 	~GuiLockGuard() noexcept { flx::core::GuiLock::unlock(); }
 
 	GuiLockGuard(const GuiLockGuard&) = delete;
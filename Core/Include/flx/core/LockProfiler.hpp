@@ -0,0 +1,198 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <source_location>
+#include <vector>
+
+namespace flx::core {
+
+/**
+ * @brief Where a lock was taken
+ *
+ * Callers that pass a std::source_location get file and line. Locks taken
+ * through std::lock_guard only have the return address of lock(), which
+ * idf.py monitor decodes when printed (or use addr2line on the ELF).
+ */
+struct LockSite {
+	const char* file;
+	uint32_t line;
+	const void* pc;
+
+	bool operator==(const LockSite&) const = default;
+};
+
+/**
+ * @brief Wait and hold times for the system's shared locks
+ *
+ * Each ProfiledMutex registers a named profile. While profiling is enabled
+ * every outermost acquisition records how long the caller waited, how long
+ * the lock was then held, and which call site held it. Times go into log2
+ * histograms (bucket 0 is under 1 us, bucket i covers [2^(i-1), 2^i) us).
+ *
+ * Disabled, a lock or unlock adds a relaxed load and a depth counter. The
+ * statistics are allocated the first time profiling is enabled.
+ */
+class LockProfiler {
+public:
+
+	static constexpr size_t HISTOGRAM_BUCKETS = 20;
+	static constexpr size_t MAX_SITES = 12; ///< Call sites tracked per lock
+
+	struct Site {
+		LockSite site;
+		char task[configMAX_TASK_NAME_LEN]; ///< Last task to hold the lock from here
+		uint32_t count;
+		uint32_t maxHoldUs;
+		uint64_t totalHoldUs;
+		uint64_t totalWaitUs;
+	};
+
+	struct Report {
+		const char* name;
+		uint32_t acquisitions;
+		uint32_t contended; ///< Acquisitions that had to wait
+		uint32_t maxWaitUs;
+		uint32_t maxHoldUs;
+		uint64_t totalWaitUs;
+		uint64_t totalHoldUs;
+		uint32_t otherSites; ///< Acquisitions from sites beyond MAX_SITES
+		uint32_t waitHistogram[HISTOGRAM_BUCKETS];
+		uint32_t holdHistogram[HISTOGRAM_BUCKETS];
+		std::vector<Site> sites; ///< Longest total hold first
+	};
+
+	static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+	static void setEnabled(bool enabled);
+
+	/** One report per registered lock, in registration order */
+	static std::vector<Report> getReport();
+	static void reset();
+
+	static size_t bucketOf(uint32_t us);
+	/** Lower bound of @p bucket in microseconds */
+	static uint32_t bucketFloorUs(size_t bucket);
+
+private:
+
+	static inline std::atomic<bool> s_enabled {false};
+};
+
+/**
+ * @brief Bookkeeping behind one ProfiledMutex
+ *
+ * The acquire/release calls run while the owning mutex is held, so the
+ * depth and current-hold fields need no synchronisation of their own.
+ */
+class LockProfile {
+public:
+
+	explicit LockProfile(const char* name);
+	~LockProfile();
+	LockProfile(const LockProfile&) = delete;
+	LockProfile& operator=(const LockProfile&) = delete;
+
+	/** A finished outermost hold, recorded after the mutex is released */
+	struct Hold {
+		LockSite site;
+		uint32_t waitUs;
+		uint32_t holdUs;
+	};
+
+	static int64_t now();
+
+	/** Lock acquired; @p waitUs < 0 means profiling was off when it was requested */
+	void acquired(const LockSite& site, int64_t waitUs) {
+		if (m_depth++ == 0 && waitUs >= 0) begin(site, waitUs);
+	}
+
+	/** Called before the underlying unlock; true if @p hold must be recorded */
+	bool releasing(Hold& hold) {
+		if (--m_depth != 0 || !m_tracking) return false;
+		end(hold);
+		return true;
+	}
+
+	void record(const Hold& hold);
+
+private:
+
+	friend class LockProfiler;
+	struct Stats;
+
+	void begin(const LockSite& site, int64_t waitUs);
+	void end(Hold& hold);
+
+	const char* m_name;
+	LockProfile* m_next = nullptr;
+	std::atomic<Stats*> m_stats {nullptr}; // Allocated on first enable, never freed while registered
+	std::mutex m_statsMutex {};
+
+	// Current outermost hold (owner only)
+	uint32_t m_depth = 0;
+	bool m_tracking = false;
+	LockSite m_site {};
+	int64_t m_holdStartUs = 0;
+	uint32_t m_waitUs = 0;
+};
+
+/**
+ * @brief Drop-in mutex wrapper that feeds a LockProfile
+ *
+ * Works with std::lock_guard and friends. @p Base needs lock(), try_lock()
+ * and unlock(); recursive bases are fine, only the outermost hold counts.
+ */
+template<typename Base>
+class ProfiledMutex {
+public:
+
+	explicit ProfiledMutex(const char* name) : m_profile(name) {}
+
+	ProfiledMutex(const ProfiledMutex&) = delete;
+	ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+	// Not inlined, so the return address is the caller's
+	[[gnu::noinline]] void lock() { lockFrom({nullptr, 0, __builtin_return_address(0)}); }
+
+	void lock(const std::source_location& location) { lockFrom({location.file_name(), location.line(), nullptr}); }
+
+	[[gnu::noinline]] bool try_lock() {
+		if (!m_base.try_lock()) return false;
+		m_profile.acquired({nullptr, 0, __builtin_return_address(0)}, LockProfiler::isEnabled() ? 0 : -1);
+		return true;
+	}
+
+	void unlock() {
+		LockProfile::Hold hold;
+		bool const tracked = m_profile.releasing(hold);
+		m_base.unlock();
+		if (tracked) m_profile.record(hold);
+	}
+
+private:
+
+	void lockFrom(const LockSite& site) {
+		if (!LockProfiler::isEnabled()) {
+			m_base.lock();
+			m_profile.acquired(site, -1);
+			return;
+		}
+		if (m_base.try_lock()) {
+			m_profile.acquired(site, 0);
+			return;
+		}
+		int64_t const start = LockProfile::now();
+		m_base.lock();
+		// At least 1 us so the acquisition counts as contended
+		m_profile.acquired(site, std::max<int64_t>(LockProfile::now() - start, 1));
+	}
+
+	Base m_base {};
+	LockProfile m_profile;
+};
+
+} // namespace flx::core
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "esp_log.h"
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace flx::core {
+
+/**
+ * @brief Deferred-format log capture
+ *
+ * In deferred mode Log::info() and friends do not format on the caller's
+ * task. They copy the timestamp, tag, format pointer and raw arguments into a
+ * fixed-size record in a lock-free ring (one per core), and a background
+ * drain task formats and writes the records later.
+ *
+ * Capture walks the format string once and pulls each argument with va_arg.
+ * `%s` strings are copied inline because the caller's buffer may not outlive
+ * the call; the format string itself is kept by pointer and must have static
+ * storage (string literals, as the printf attribute on Log implies).
+ *
+ * Deferral is lossy, so it is off unless CONFIG_FLXOS_DEFERRED_LOGGING or
+ * 'logbuf on' turns it on:
+ * - A `%s` argument is cut to MAX_STRING_ARG characters, or to its
+ *   precision (`%.8s`, `%.*s`) when that is shorter.
+ * - Arguments beyond ARG_CAPACITY bytes print as "<...>".
+ * - Producers never block: when a ring is full the record is dropped and
+ *   counted. Records are drained oldest first across cores.
+ */
+class LogBuffer {
+public:
+
+	static constexpr size_t MAX_CORES = 2;
+	static constexpr size_t RING_CAPACITY = 64; ///< Records per core (power of two)
+	static constexpr size_t TAG_CAPACITY = 24;
+	static constexpr size_t ARG_CAPACITY = 80; ///< Bytes of captured arguments per record
+	static constexpr size_t MAX_STRING_ARG = 48; ///< Longest %s copied inline (longer strings are cut)
+
+	struct Record {
+		const char* fmt;
+		uint32_t timestamp;
+		uint8_t level;
+		uint8_t tagLength;
+		uint8_t argLength;
+		bool truncated; // Arguments did not fit; formatting stops at the first missing one
+		char tag[TAG_CAPACITY];
+		uint8_t args[ARG_CAPACITY];
+	};
+
+	struct Stats {
+		uint32_t captured[MAX_CORES];
+		uint32_t dropped[MAX_CORES];
+		uint32_t truncated; ///< Records whose arguments were cut
+		uint32_t fallback; ///< Messages formatted synchronously (unsupported conversion)
+		uint32_t drained;
+		uint32_t highWater; ///< Most records pending in one ring
+	};
+
+	static bool isDeferred() { return s_deferred.load(std::memory_order_relaxed); }
+
+	/**
+	 * Enable or disable deferred capture. The rings are allocated on first
+	 * enable and kept for the lifetime of the system.
+	 */
+	static void setDeferred(bool enabled);
+
+	/**
+	 * Capture a message into the current core's ring.
+	 * @return false if the message must be formatted synchronously instead
+	 *         (rings not allocated, unsupported conversion). A full ring
+	 *         counts as handled: the record is dropped and counted.
+	 */
+	static bool capture(esp_log_level_t level, std::string_view tag, const char* fmt, va_list args);
+
+	/**
+	 * Format and write up to @p maxRecords pending records.
+	 * @return Number of records written
+	 */
+	static size_t drain(size_t maxRecords);
+
+	/** Format the message part of @p record into @p out (always NUL-terminated) */
+	static size_t format(const Record& record, char* out, size_t size);
+
+	static size_t pending();
+	static Stats getStats();
+	static void resetStats();
+
+private:
+
+	static inline std::atomic<bool> s_deferred {false};
+};
+
+} // namespace flx::core
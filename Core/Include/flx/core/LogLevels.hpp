@@ -0,0 +1,79 @@
+#pragma once
+
+#include "esp_log.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace flx {
+
+/**
+ * @brief Runtime per-tag log level table
+ *
+ * Checked by Log before any capture or formatting, so a filtered message
+ * costs one or two relaxed loads. Tags without an override use the default
+ * level. Overrides are appended under a mutex and never removed, so readers
+ * scan the table without locking.
+ *
+ * esp_log_write() keeps its own per-tag filter; the CLI `loglevel` command
+ * updates both.
+ */
+class LogLevels {
+public:
+
+	static constexpr size_t MAX_OVERRIDES = 16;
+	static constexpr size_t TAG_CAPACITY = 24;
+
+	struct Override {
+		char tag[TAG_CAPACITY];
+		esp_log_level_t level;
+	};
+
+	static bool isEnabled(esp_log_level_t level, std::string_view tag) {
+		// Nothing is configured this verbose: reject without touching the table
+		if (level > s_maxLevel.load(std::memory_order_relaxed)) return false;
+		size_t count = s_count.load(std::memory_order_acquire);
+		if (count == 0) return level <= s_default.load(std::memory_order_relaxed);
+		return level <= lookup(tag, count);
+	}
+
+	/** Level for tags without an override (ESP-IDF's "*") */
+	static void setDefault(esp_log_level_t level);
+	static esp_log_level_t getDefault() { return s_default.load(std::memory_order_relaxed); }
+
+	/**
+	 * Override the level of one tag.
+	 * @return false if the tag is too long or the table is full
+	 */
+	static bool set(std::string_view tag, esp_log_level_t level);
+
+	static esp_log_level_t get(std::string_view tag);
+
+	/** Copy the current overrides into @p out; returns the number written */
+	static size_t list(Override* out, size_t capacity);
+
+private:
+
+	struct Slot {
+		char tag[TAG_CAPACITY];
+		uint8_t length;
+		std::atomic<esp_log_level_t> level;
+	};
+
+	static esp_log_level_t lookup(std::string_view tag, size_t count);
+	static void refreshMaxLevel();
+
+#ifdef CONFIG_LOG_DEFAULT_LEVEL
+	static constexpr esp_log_level_t DEFAULT_LEVEL = static_cast<esp_log_level_t>(CONFIG_LOG_DEFAULT_LEVEL);
+#else
+	static constexpr esp_log_level_t DEFAULT_LEVEL = ESP_LOG_INFO;
+#endif
+
+	static inline Slot s_slots[MAX_OVERRIDES] {};
+	static inline std::atomic<size_t> s_count {0};
+	static inline std::atomic<esp_log_level_t> s_default {DEFAULT_LEVEL};
+	static inline std::atomic<esp_log_level_t> s_maxLevel {DEFAULT_LEVEL}; // Most verbose level of default + overrides
+};
+
+} // namespace flx
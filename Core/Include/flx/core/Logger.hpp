@@ -1,70 +1,189 @@
 #pragma once
 #include "esp_log.h"
+#include <algorithm>
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
+#include <flx/core/LogBuffer.hpp>
+#include <flx/core/LogLevels.hpp>
 #include <string_view>
 
+/**
+ * Most verbose level compiled into this translation unit (esp_log_level_t
+ * value). Set per component from the profile's `logging:` section; calls
+ * above it compile to nothing.
+ */
+#ifndef FLX_LOG_MIN_LEVEL
+#define FLX_LOG_MIN_LEVEL 5 // ESP_LOG_VERBOSE
+#endif
+
 namespace flx {
 
-class Log {
+/**
+ * @brief Level-independent output path shared by every BasicLog instantiation
+ */
+class LogWriter {
 public:
 
-	static void info(std::string_view tag, const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
-		va_list args;
-		va_start(args, fmt);
-		log_impl(ESP_LOG_INFO, "I", "\033[0;32m", tag, fmt, args);
-		va_end(args);
+	static constexpr size_t LINE_CAPACITY = 1024;
+	static constexpr size_t RESET_RESERVE = 8; // Reset sequence and newline
+
+	/// Receives every emitted line (colour codes included) after the console write
+	using LineSink = void (*)(esp_log_level_t level, const char* line);
+
+	/**
+	 * Install a tap on the output path (e.g. persistent storage). The sink runs
+	 * on the emitting task — the caller for synchronous logs, the drain task
+	 * for deferred ones — and must not block. Pass nullptr to remove it.
+	 */
+	static void setLineSink(LineSink sink) { s_lineSink.store(sink, std::memory_order_release); }
+
+	/**
+	 * Write the "colour L (timestamp) tag: " prefix into @p buf.
+	 * @return Prefix length, or -1 on error
+	 */
+	static int formatPrefix(char* buf, size_t size, esp_log_level_t level, uint32_t timestamp, std::string_view tag) {
+		const char* level_char = "I";
+		const char* color = "\033[0;32m";
+		switch (level) {
+			case ESP_LOG_ERROR:
+				level_char = "E";
+				color = "\033[0;31m";
+				break;
+			case ESP_LOG_WARN:
+				level_char = "W";
+				color = "\033[0;33m";
+				break;
+			case ESP_LOG_DEBUG:
+				level_char = "D";
+				color = "\033[0;37m";
+				break;
+			case ESP_LOG_VERBOSE:
+				level_char = "V";
+				color = "\033[0;38;5;250m";
+				break;
+			default:
+				break;
+		}
+		return std::snprintf(buf, size, "%s%s (%lu) %.*s: ", color, level_char, (unsigned long)timestamp, (int)tag.size(), tag.data());
 	}
 
-	static void error(std::string_view tag, const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
-		va_list args;
-		va_start(args, fmt);
-		log_impl(ESP_LOG_ERROR, "E", "\033[0;31m", tag, fmt, args);
-		va_end(args);
+	/**
+	 * Append the colour reset and newline to a formatted line and hand it to
+	 * esp_log_write(). @p buf must have RESET_RESERVE bytes of headroom.
+	 */
+	static void emit(esp_log_level_t level, std::string_view tag, char* buf) {
+		std::strcat(buf, "\033[0m\n");
+		// Provide a null-terminated tag for ESP-IDF's filtering system
+		char tag_buf[32];
+		std::size_t tag_len = std::min(tag.size(), sizeof(tag_buf) - 1);
+		std::memcpy(tag_buf, tag.data(), tag_len);
+		tag_buf[tag_len] = '\0';
+		esp_log_write(level, tag_buf, "%s", buf);
+		if (LineSink sink = s_lineSink.load(std::memory_order_acquire)) {
+			sink(level, buf);
+		}
 	}
 
-	static void warn(std::string_view tag, const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
-		va_list args;
-		va_start(args, fmt);
-		log_impl(ESP_LOG_WARN, "W", "\033[0;33m", tag, fmt, args);
-		va_end(args);
+protected:
+
+	static void log_impl(esp_log_level_t level, std::string_view tag, const char* fmt, va_list args) {
+		// Errors stay synchronous so they reach the console even if the system dies next
+		if (level != ESP_LOG_ERROR && core::LogBuffer::isDeferred() && core::LogBuffer::capture(level, tag, fmt, args)) {
+			return;
+		}
+
+		char buf[LINE_CAPACITY];
+		int pos = formatPrefix(buf, sizeof(buf), level, esp_log_timestamp(), tag);
+		if (pos >= 0 && pos < (int)(sizeof(buf) - RESET_RESERVE)) {
+			int msg_len = std::vsnprintf(buf + pos, sizeof(buf) - (size_t)pos - RESET_RESERVE, fmt, args);
+			if (msg_len >= 0) {
+				emit(level, tag, buf);
+			}
+		}
 	}
 
-	static void debug(std::string_view tag, const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
-		va_list args;
-		va_start(args, fmt);
-		log_impl(ESP_LOG_DEBUG, "D", "\033[0;37m", tag, fmt, args);
-		va_end(args);
+private:
+
+	static inline std::atomic<LineSink> s_lineSink {nullptr};
+};
+
+/**
+ * @brief printf-style logger with a compile-time level floor
+ *
+ * Each component compiles against its own MinLevel, so the level is part of
+ * the type and different floors never collide at link time. Calls above
+ * MinLevel are discarded by `if constexpr`; the rest consult the runtime
+ * LogLevels table before anything is captured or formatted.
+ *
+ * That only holds for code compiled in one component. An inline function in
+ * a header shared between components would see a different `Log` in each
+ * one, and the linker keeps a single copy. Such functions use InlineLog,
+ * which has no compile-time floor and relies on the runtime tag levels.
+ */
+template<int MinLevel>
+class BasicLog : public LogWriter {
+public:
+
+	static constexpr int MIN_LEVEL = MinLevel;
+
+	static void info([[maybe_unused]] std::string_view tag, [[maybe_unused]] const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+		if constexpr (MinLevel >= ESP_LOG_INFO) {
+			if (!LogLevels::isEnabled(ESP_LOG_INFO, tag)) return;
+			va_list args;
+			va_start(args, fmt);
+			log_impl(ESP_LOG_INFO, tag, fmt, args);
+			va_end(args);
+		}
 	}
 
-	static void verbose(std::string_view tag, const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
-		va_list args;
-		va_start(args, fmt);
-		log_impl(ESP_LOG_VERBOSE, "V", "\033[0;38;5;250m", tag, fmt, args);
-		va_end(args);
+	static void error([[maybe_unused]] std::string_view tag, [[maybe_unused]] const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+		if constexpr (MinLevel >= ESP_LOG_ERROR) {
+			if (!LogLevels::isEnabled(ESP_LOG_ERROR, tag)) return;
+			va_list args;
+			va_start(args, fmt);
+			log_impl(ESP_LOG_ERROR, tag, fmt, args);
+			va_end(args);
+		}
 	}
 
-private:
+	static void warn([[maybe_unused]] std::string_view tag, [[maybe_unused]] const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+		if constexpr (MinLevel >= ESP_LOG_WARN) {
+			if (!LogLevels::isEnabled(ESP_LOG_WARN, tag)) return;
+			va_list args;
+			va_start(args, fmt);
+			log_impl(ESP_LOG_WARN, tag, fmt, args);
+			va_end(args);
+		}
+	}
 
-	static void log_impl(esp_log_level_t level, const char* level_char, const char* color, std::string_view tag, const char* fmt, va_list args) {
-		char buf[1024];
-		int pos = std::snprintf(buf, sizeof(buf), "%s%s (%lu) %.*s: ", color, level_char, (unsigned long)esp_log_timestamp(), (int)tag.size(), tag.data());
-		if (pos >= 0 && pos < (int)sizeof(buf) - 8) {
-			int msg_len = std::vsnprintf(buf + pos, sizeof(buf) - (size_t)pos - 8, fmt, args); // -8 for reset sequence and newline
-			if (msg_len >= 0) {
-				std::strcat(buf, "\033[0m\n");
-				// Provide a null-terminated tag for ESP-IDF's filtering system
-				char tag_buf[32];
-				std::size_t tag_len = std::min(tag.size(), sizeof(tag_buf) - 1);
-				std::memcpy(tag_buf, tag.data(), tag_len);
-				tag_buf[tag_len] = '\0';
-				esp_log_write(level, tag_buf, "%s", buf);
-			}
+	static void debug([[maybe_unused]] std::string_view tag, [[maybe_unused]] const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+		if constexpr (MinLevel >= ESP_LOG_DEBUG) {
+			if (!LogLevels::isEnabled(ESP_LOG_DEBUG, tag)) return;
+			va_list args;
+			va_start(args, fmt);
+			log_impl(ESP_LOG_DEBUG, tag, fmt, args);
+			va_end(args);
+		}
+	}
+
+	static void verbose([[maybe_unused]] std::string_view tag, [[maybe_unused]] const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+		if constexpr (MinLevel >= ESP_LOG_VERBOSE) {
+			if (!LogLevels::isEnabled(ESP_LOG_VERBOSE, tag)) return;
+			va_list args;
+			va_start(args, fmt);
+			log_impl(ESP_LOG_VERBOSE, tag, fmt, args);
+			va_end(args);
 		}
 	}
 };
 
+using Log = BasicLog<FLX_LOG_MIN_LEVEL>;
+
+/// For inline functions in headers included from several components
+using InlineLog = BasicLog<ESP_LOG_VERBOSE>;
+
 } // namespace flx
 
 // Backward compatibility alias
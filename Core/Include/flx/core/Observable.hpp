@@ -1,23 +1,208 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace flx {
 
+/**
+ * @brief Process-wide notification counters (diagnostics)
+ */
+struct ObservableStats {
+	static inline std::atomic<uint32_t> batchCommits {0};
+	static inline std::atomic<uint32_t> batchCollapsed {0}; ///< Notifications merged inside a batch
+	static inline std::atomic<uint32_t> bridgeApplied {0}; ///< LVGL subject updates applied
+	static inline std::atomic<uint32_t> bridgeCollapsed {0}; ///< LVGL subject updates merged into a pending one
+};
+
+namespace detail {
+
+/**
+ * @brief Copy-on-write observer list.
+ *
+ * Mutated only under the owning observable's lock (subscribe/unsubscribe);
+ * notification takes a refcounted snapshot instead of copying the vector,
+ * so set() does not allocate.
+ *
+ * Slots freed by remove() are reused, so short-lived observers (one-shot
+ * waits) do not grow the list. The id returned by add() carries the slot's
+ * generation in its high bits: a stale or repeated remove() of an old id
+ * does nothing instead of removing the slot's new occupant.
+ */
+template<typename Callback>
+class ObserverList {
+public:
+
+	using List = std::vector<Callback>;
+	using Snapshot = std::shared_ptr<const List>;
+
+	size_t add(Callback cb) {
+		auto next = m_list ? std::make_shared<List>(*m_list) : std::make_shared<List>();
+		size_t slot = 0;
+		while (slot < next->size() && (*next)[slot]) slot++;
+		if (slot == next->size()) {
+			next->push_back(nullptr);
+			m_generations.push_back(0);
+		}
+		(*next)[slot] = std::move(cb);
+		m_list = std::move(next);
+		return (static_cast<size_t>(m_generations[slot]) << SLOT_BITS) | slot;
+	}
+
+	void remove(size_t id) {
+		size_t const slot = id & SLOT_MASK;
+		if (!m_list || slot >= m_list->size() || !(*m_list)[slot]) return;
+		if ((id >> SLOT_BITS) != (m_generations[slot] & GENERATION_MASK)) return;
+		auto next = std::make_shared<List>(*m_list);
+		(*next)[slot] = nullptr;
+		m_generations[slot]++;
+		m_list = std::move(next);
+	}
+
+	Snapshot snapshot() const { return m_list; }
+
+	template<typename V>
+	static void dispatch(const Snapshot& observers, const V& value) {
+		if (!observers) return;
+		for (const auto& cb: *observers) {
+			if (cb) {
+				cb(value);
+			}
+		}
+	}
+
+private:
+
+	// Low bits index the slot, the rest hold its generation
+	static constexpr size_t SLOT_BITS = 12;
+	static constexpr size_t SLOT_MASK = (size_t {1} << SLOT_BITS) - 1;
+	static constexpr uint32_t GENERATION_MASK = static_cast<uint32_t>(SIZE_MAX >> SLOT_BITS);
+
+	Snapshot m_list;
+	std::vector<uint32_t> m_generations; // Per slot; not part of the snapshot
+};
+
+/**
+ * @brief Per-thread state of an open ObservableBatch.
+ *
+ * While a batch is open on the calling thread, observables record a single
+ * deferred notify() per instance instead of dispatching immediately.
+ */
+class BatchState {
+public:
+
+	/**
+	 * Defer a notification for @p key if a batch is open on this thread.
+	 * @return true if deferred (caller must not dispatch now)
+	 */
+	template<typename Flush>
+	static bool defer(const void* key, Flush&& flush) {
+		BatchState* state = current();
+		if (!state) return false;
+		for (const auto& p: state->pending) {
+			if (p.key == key) {
+				ObservableStats::batchCollapsed.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		state->pending.push_back({key, std::forward<Flush>(flush)});
+		return true;
+	}
+
+	static BatchState*& current() {
+		static thread_local BatchState* state = nullptr;
+		return state;
+	}
+
+	struct Pending {
+		const void* key;
+		std::function<void()> flush;
+	};
+
+	std::vector<Pending> pending;
+	int depth = 0;
+};
+
+} // namespace detail
+
+/**
+ * @brief Transaction scope that defers observable notifications.
+ *
+ * Values change immediately (get() sees them), but observers are notified
+ * once per observable, with its latest value, when the outermost batch on
+ * the current thread is committed (explicitly or on destruction).
+ *
+ *   {
+ *       flx::ObservableBatch batch;
+ *       connected.set(1);
+ *       ssid.set("home");
+ *       ip.set("10.0.0.2");
+ *   } // observers fire here, in first-change order
+ */
+class ObservableBatch {
+public:
+
+	ObservableBatch() {
+		auto*& state = detail::BatchState::current();
+		if (!state) {
+			state = &m_state;
+			m_owner = true;
+		}
+		state->depth++;
+	}
+
+	~ObservableBatch() { commit(); }
+
+	ObservableBatch(const ObservableBatch&) = delete;
+	ObservableBatch& operator=(const ObservableBatch&) = delete;
+
+	/**
+	 * Close this scope; the outermost scope dispatches deferred notifications.
+	 */
+	void commit() {
+		if (m_committed) return;
+		m_committed = true;
+
+		auto*& state = detail::BatchState::current();
+		// An outer scope committed early has already closed the batch
+		if (state) state->depth--;
+		if (!m_owner) return; // Nested scope: the outermost one flushes
+
+		std::vector<detail::BatchState::Pending> pending = std::move(m_state.pending);
+		state = nullptr; // Observers run outside the batch
+		ObservableStats::batchCommits.fetch_add(1, std::memory_order_relaxed);
+		for (auto& p: pending) {
+			p.flush();
+		}
+	}
+
+private:
+
+	detail::BatchState m_state;
+	bool m_owner = false;
+	bool m_committed = false;
+};
+
 /**
  * @brief Thread-safe observable value with observer pattern.
  *
  * Inspired by LVGL's lv_subject_t but with zero LVGL dependency.
  * Observers are notified when the value changes.
  *
+ * This primary template guards the value with a mutex and is used for
+ * non-trivially-copyable types. Trivially copyable types (int32_t, uint8_t,
+ * small POD structs) use the lock-free-read specialization below.
+ *
  * @tparam T The type of value to observe (int32_t, std::string, void*, etc.)
  */
-template<typename T>
+template<typename T, typename Enable = void>
 class Observable {
 public:
 
@@ -30,7 +215,7 @@ public:
 	 * Set the value and notify all observers if it changed.
 	 */
 	void set(const T& value) {
-		std::vector<Callback> observers_copy;
+		typename detail::ObserverList<Callback>::Snapshot observers;
 		T value_copy;
 		{
 			std::lock_guard<std::mutex> lock(m_mutex);
@@ -39,34 +224,28 @@ public:
 			}
 			m_prev_value = m_value;
 			m_value = value;
-			observers_copy = m_observers;
+			observers = m_observers.snapshot();
 			value_copy = m_value;
 		}
-		for (auto& cb: observers_copy) {
-			if (cb) {
-				cb(value_copy);
-			}
-		}
+		if (detail::BatchState::defer(this, [this]() { notify(); })) return;
+		detail::ObserverList<Callback>::dispatch(observers, value_copy);
 	}
 
 	/**
 	 * Set the value and always notify observers (even if unchanged).
 	 */
 	void setAndNotify(const T& value) {
-		std::vector<Callback> observers_copy;
+		typename detail::ObserverList<Callback>::Snapshot observers;
 		T value_copy;
 		{
 			std::lock_guard<std::mutex> lock(m_mutex);
 			m_prev_value = m_value;
 			m_value = value;
-			observers_copy = m_observers;
+			observers = m_observers.snapshot();
 			value_copy = m_value;
 		}
-		for (auto& cb: observers_copy) {
-			if (cb) {
-				cb(value_copy);
-			}
-		}
+		if (detail::BatchState::defer(this, [this]() { notify(); })) return;
+		detail::ObserverList<Callback>::dispatch(observers, value_copy);
 	}
 
 	/**
@@ -88,12 +267,11 @@ public:
 	/**
 	 * Subscribe to value changes.
 	 * @param cb Callback invoked when value changes.
-	 * @return Index of the observer (can be used for unsubscribe).
+	 * @return Id of the observer (can be used for unsubscribe).
 	 */
 	size_t subscribe(Callback cb) {
 		std::lock_guard<std::mutex> lock(m_mutex);
-		m_observers.push_back(cb);
-		return m_observers.size() - 1;
+		return m_observers.add(std::move(cb));
 	}
 
 	/**
@@ -102,34 +280,195 @@ public:
 	 */
 	void unsubscribe(size_t index) {
 		std::lock_guard<std::mutex> lock(m_mutex);
-		if (index < m_observers.size()) {
-			m_observers[index] = nullptr;
-		}
+		m_observers.remove(index);
 	}
 
 	/**
 	 * Manually notify all observers with current value.
 	 */
 	void notify() {
-		std::vector<Callback> observers_copy;
+		if (detail::BatchState::defer(this, [this]() { notify(); })) return;
+		typename detail::ObserverList<Callback>::Snapshot observers;
 		T value_copy;
 		{
 			std::lock_guard<std::mutex> lock(m_mutex);
-			observers_copy = m_observers;
+			observers = m_observers.snapshot();
 			value_copy = m_value;
 		}
-		for (auto& cb: observers_copy) {
-			if (cb) {
-				cb(value_copy);
-			}
-		}
+		detail::ObserverList<Callback>::dispatch(observers, value_copy);
 	}
 
 private:
 
 	T m_value;
 	T m_prev_value;
-	std::vector<Callback> m_observers {};
+	detail::ObserverList<Callback> m_observers {};
+	mutable std::mutex m_mutex {};
+};
+
+/**
+ * @brief Observable specialization for trivially copyable values.
+ *
+ * get()/getPrevious() never take a lock: values that fit a lock-free
+ * std::atomic are stored in one, larger PODs use a seqlock over atomic words.
+ * Writers are still serialized by a mutex, which also guards the
+ * copy-on-write observer list. A reader that keeps colliding with a writer
+ * (e.g. a higher-priority task spinning on a preempted writer) falls back
+ * to the mutex, so priority inheritance lets the writer finish.
+ */
+template<typename T>
+class Observable<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+public:
+
+	using Callback = std::function<void(const T& value)>;
+
+	explicit Observable(T initial = T {}) {
+		m_value.store(initial);
+		m_prev_value.store(initial);
+	}
+
+	/**
+	 * Set the value and notify all observers if it changed.
+	 */
+	void set(const T& value) {
+		typename detail::ObserverList<Callback>::Snapshot observers;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			T current = m_value.loadLocked();
+			if (current == value) {
+				return;
+			}
+			m_prev_value.store(current);
+			m_value.store(value);
+			observers = m_observers.snapshot();
+		}
+		if (detail::BatchState::defer(this, [this]() { notify(); })) return;
+		detail::ObserverList<Callback>::dispatch(observers, value);
+	}
+
+	/**
+	 * Set the value and always notify observers (even if unchanged).
+	 */
+	void setAndNotify(const T& value) {
+		typename detail::ObserverList<Callback>::Snapshot observers;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_prev_value.store(m_value.loadLocked());
+			m_value.store(value);
+			observers = m_observers.snapshot();
+		}
+		if (detail::BatchState::defer(this, [this]() { notify(); })) return;
+		detail::ObserverList<Callback>::dispatch(observers, value);
+	}
+
+	/**
+	 * Get the current value (lock-free).
+	 */
+	T get() const { return m_value.load(m_mutex); }
+
+	/**
+	 * Get the previous value (before last set, lock-free).
+	 */
+	T getPrevious() const { return m_prev_value.load(m_mutex); }
+
+	/**
+	 * Subscribe to value changes.
+	 * @return Id of the observer (can be used for unsubscribe).
+	 */
+	size_t subscribe(Callback cb) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_observers.add(std::move(cb));
+	}
+
+	/**
+	 * Unsubscribe an observer by index.
+	 */
+	void unsubscribe(size_t index) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_observers.remove(index);
+	}
+
+	/**
+	 * Manually notify all observers with current value.
+	 */
+	void notify() {
+		if (detail::BatchState::defer(this, [this]() { notify(); })) return;
+		typename detail::ObserverList<Callback>::Snapshot observers;
+		T value_copy;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			observers = m_observers.snapshot();
+			value_copy = m_value.loadLocked();
+		}
+		detail::ObserverList<Callback>::dispatch(observers, value_copy);
+	}
+
+private:
+
+	/// Single-word values: plain atomic
+	struct AtomicCell {
+		std::atomic<T> value {};
+
+		void store(const T& v) { value.store(v, std::memory_order_release); }
+		T loadLocked() const { return value.load(std::memory_order_relaxed); }
+		T load(std::mutex& /*writerLock*/) const { return value.load(std::memory_order_acquire); }
+	};
+
+	/// Multi-word values: seqlock over relaxed atomic words (writers hold the mutex)
+	struct SeqlockCell {
+		static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+		static constexpr int MAX_SPINS = 64;
+
+		std::atomic<uint32_t> seq {0};
+		std::atomic<uint32_t> words[WORDS] {};
+
+		void store(const T& v) {
+			uint32_t buf[WORDS] {};
+			std::memcpy(buf, &v, sizeof(T));
+			uint32_t s = seq.load(std::memory_order_relaxed);
+			seq.store(s + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			for (size_t i = 0; i < WORDS; i++) {
+				words[i].store(buf[i], std::memory_order_relaxed);
+			}
+			seq.store(s + 2, std::memory_order_release);
+		}
+
+		T loadLocked() const {
+			uint32_t buf[WORDS];
+			for (size_t i = 0; i < WORDS; i++) {
+				buf[i] = words[i].load(std::memory_order_relaxed);
+			}
+			T out;
+			std::memcpy(&out, buf, sizeof(T));
+			return out;
+		}
+
+		T load(std::mutex& writerLock) const {
+			uint32_t buf[WORDS];
+			for (int spin = 0; spin < MAX_SPINS; spin++) {
+				uint32_t s0 = seq.load(std::memory_order_acquire);
+				if (s0 & 1) continue;
+				for (size_t i = 0; i < WORDS; i++) {
+					buf[i] = words[i].load(std::memory_order_relaxed);
+				}
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (seq.load(std::memory_order_relaxed) == s0) {
+					T out;
+					std::memcpy(&out, buf, sizeof(T));
+					return out;
+				}
+			}
+			std::lock_guard<std::mutex> lock(writerLock);
+			return loadLocked();
+		}
+	};
+
+	using Cell = std::conditional_t<std::atomic<T>::is_always_lock_free, AtomicCell, SeqlockCell>;
+
+	Cell m_value;
+	Cell m_prev_value;
+	detail::ObserverList<Callback> m_observers {};
 	mutable std::mutex m_mutex {};
 };
 
@@ -145,7 +484,7 @@ public:
 		: m_value(initial ? initial : ""), m_prev_value(m_value) {}
 
 	void set(const char* value) {
-		std::vector<Callback> observers_copy;
+		detail::ObserverList<Callback>::Snapshot observers;
 		std::string value_copy;
 		{
 			std::lock_guard<std::mutex> lock(m_mutex);
@@ -155,14 +494,11 @@ public:
 			}
 			m_prev_value = m_value;
 			m_value = newVal;
-			observers_copy = m_observers;
+			observers = m_observers.snapshot();
 			value_copy = m_value;
 		}
-		for (auto& cb: observers_copy) {
-			if (cb) {
-				cb(value_copy);
-			}
-		}
+		if (detail::BatchState::defer(this, [this]() { notify(); })) return;
+		detail::ObserverList<Callback>::dispatch(observers, value_copy);
 	}
 
 	void copy(const char* value) { set(value); }
@@ -179,37 +515,31 @@ public:
 
 	size_t subscribe(Callback cb) {
 		std::lock_guard<std::mutex> lock(m_mutex);
-		m_observers.push_back(cb);
-		return m_observers.size() - 1;
+		return m_observers.add(std::move(cb));
 	}
 
 	void unsubscribe(size_t index) {
 		std::lock_guard<std::mutex> lock(m_mutex);
-		if (index < m_observers.size()) {
-			m_observers[index] = nullptr;
-		}
+		m_observers.remove(index);
 	}
 
 	void notify() {
-		std::vector<Callback> observers_copy;
+		if (detail::BatchState::defer(this, [this]() { notify(); })) return;
+		detail::ObserverList<Callback>::Snapshot observers;
 		std::string value_copy;
 		{
 			std::lock_guard<std::mutex> lock(m_mutex);
-			observers_copy = m_observers;
+			observers = m_observers.snapshot();
 			value_copy = m_value;
 		}
-		for (auto& cb: observers_copy) {
-			if (cb) {
-				cb(value_copy);
-			}
-		}
+		detail::ObserverList<Callback>::dispatch(observers, value_copy);
 	}
 
 private:
 
 	std::string m_value {};
 	std::string m_prev_value {};
-	std::vector<Callback> m_observers {};
+	detail::ObserverList<Callback> m_observers {};
 	mutable std::mutex m_mutex {};
 };
 
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <flx/core/Bundle.hpp>
+#include <flx/core/EventBus.hpp>
+#include <flx/core/EventChannel.hpp>
+#include <flx/core/Logger.hpp>
+#include <string>
+#include <string_view>
+
+namespace flx::core {
+
+/**
+ * @brief Typed payloads for standard system events (see EventChannel)
+ *
+ * Field names and Bundle keys match the string events documented on EventBus,
+ * so Bundle listeners observe the same payloads as before.
+ */
+
+// ──────── App lifecycle ────────
+
+struct AppLifecycleEvent {
+	char appId[64];
+
+	void toBundle(Bundle& out) const { out.putString("appId", appId); }
+};
+
+/// Longest app id the typed payload holds; AppManager rejects longer ones
+constexpr size_t MAX_APP_ID_LENGTH = sizeof(AppLifecycleEvent::appId) - 1;
+
+struct AppStarted : AppLifecycleEvent {
+	static constexpr const char* TOPIC = Events::APP_STARTED;
+};
+
+struct AppStopped : AppLifecycleEvent {
+	static constexpr const char* TOPIC = Events::APP_STOPPED;
+};
+
+// ──────── Service lifecycle ────────
+
+struct ServiceLifecycleEvent {
+	char serviceId[48];
+
+	void toBundle(Bundle& out) const { out.putString("serviceId", serviceId); }
+};
+
+/// Longest service id the typed payload holds; ServiceRegistry rejects longer ones
+constexpr size_t MAX_SERVICE_ID_LENGTH = sizeof(ServiceLifecycleEvent::serviceId) - 1;
+
+struct ServiceStarted : ServiceLifecycleEvent {
+	static constexpr const char* TOPIC = Events::SERVICE_STARTED;
+};
+
+struct ServiceStopped : ServiceLifecycleEvent {
+	static constexpr const char* TOPIC = Events::SERVICE_STOPPED;
+};
+
+struct ServiceFailed : ServiceLifecycleEvent {
+	static constexpr const char* TOPIC = Events::SERVICE_FAILED;
+};
+
+// ──────── Helpers ────────
+
+/**
+ * Publish on the string topic with a Bundle, for an id that does not fit the
+ * typed payload. Truncated, it would reach listeners as a different id;
+ * typed subscribers miss the event, Bundle listeners still get it whole.
+ */
+inline void publishOverlongIdEvent(const char* topic, const char* key, std::string_view id) {
+	InlineLog::warn("SystemEvents", "%s: %s '%.*s' does not fit the typed payload", topic, key, (int)id.size(), id.data());
+	Bundle data;
+	data.putString(key, std::string(id));
+	EventBus::getInstance().publish(topic, data);
+}
+
+/**
+ * Publish an app lifecycle event on its typed channel.
+ */
+template<typename Event>
+inline void publishAppEvent(std::string_view appId) {
+	Event event {};
+	if (!copyEventString(event.appId, appId)) {
+		publishOverlongIdEvent(Event::TOPIC, "appId", appId);
+		return;
+	}
+	EventChannel<Event>::getInstance().publish(event);
+}
+
+/**
+ * Publish a service lifecycle event on its typed channel.
+ */
+template<typename Event>
+inline void publishServiceEvent(std::string_view serviceId) {
+	Event event {};
+	if (!copyEventString(event.serviceId, serviceId)) {
+		publishOverlongIdEvent(Event::TOPIC, "serviceId", serviceId);
+		return;
+	}
+	EventChannel<Event>::getInstance().publish(event);
+}
+
+} // namespace flx::core
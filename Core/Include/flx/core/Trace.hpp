@@ -0,0 +1,112 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace flx::core {
+
+/**
+ * @brief Scoped begin/end spans for boot, app launch and frame timing
+ *
+ * FLX_TRACE_SCOPE("name") records a begin event where it is declared and an
+ * end event when the scope exits. Each event carries a timestamp, the
+ * current task handle and the core it ran on, and goes into a lock-free
+ * ring for that core, so tracing never blocks and never allocates once
+ * the rings exist.
+ *
+ * Names are kept by pointer and must outlive the trace (string literals,
+ * or strings owned by objects that live for the lifetime of the system).
+ *
+ * While tracing is stopped a scope costs one relaxed atomic load. Dumps
+ * are written in the Chrome trace event format, which Perfetto
+ * (ui.perfetto.dev) and chrome://tracing open directly.
+ */
+class Trace {
+public:
+
+	static constexpr size_t MAX_CORES = 2;
+	static constexpr size_t RING_CAPACITY = 512; ///< Events per core (power of two)
+
+	enum class Mode : uint8_t {
+		ONESHOT, ///< Keep the first events; stop recording once a ring is full
+		RING ///< Keep the latest events, overwriting the oldest
+	};
+
+	struct Event {
+		const char* name;
+		uint32_t timestampUs; ///< Since start()
+		TaskHandle_t task;
+		uint8_t core;
+		char phase; ///< 'B' or 'E'
+	};
+
+	struct Stats {
+		bool enabled;
+		Mode mode;
+		uint32_t recorded[MAX_CORES];
+		uint32_t dropped[MAX_CORES]; ///< ONESHOT events that arrived after the ring filled
+		int64_t startUs; ///< esp_timer time of start()
+	};
+
+	static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * Clear the rings and start recording. The rings are allocated on the
+	 * first start (PSRAM preferred) and kept for the lifetime of the system.
+	 * @return false if the rings could not be allocated
+	 */
+	static bool start(Mode mode);
+	static void stop();
+
+	static void begin(const char* name) { record(name, 'B'); }
+	static void end(const char* name) { record(name, 'E'); }
+
+	/** Events currently held, oldest first */
+	static std::vector<Event> snapshot();
+
+	/**
+	 * Write the held events as Chrome trace JSON. End events whose begin
+	 * was overwritten are left out so every track still nests.
+	 * @return Number of begin/end events written
+	 */
+	static size_t writeChromeJson(FILE* out);
+
+	static Stats getStats();
+
+private:
+
+	static void record(const char* name, char phase);
+
+	static inline std::atomic<bool> s_enabled {false};
+};
+
+/** RAII span; only closes what it opened, so starting or stopping mid-scope is safe */
+class TraceScope {
+public:
+
+	explicit TraceScope(const char* name) : m_name(Trace::isEnabled() ? name : nullptr) {
+		if (m_name) Trace::begin(m_name);
+	}
+
+	~TraceScope() {
+		if (m_name) Trace::end(m_name);
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+
+	const char* m_name;
+};
+
+} // namespace flx::core
+
+#define FLX_TRACE_CONCAT_INNER(a, b) a##b
+#define FLX_TRACE_CONCAT(a, b) FLX_TRACE_CONCAT_INNER(a, b)
+#define FLX_TRACE_SCOPE(name) ::flx::core::TraceScope FLX_TRACE_CONCAT(flxTraceScope_, __LINE__)(name)
@@ -0,0 +1,162 @@
+#include "esp_app_desc.h"
+#include <cstdio>
+#include <cstring>
+#include <flx/core/BootCache.hpp>
+#include <flx/core/Logger.hpp>
+#include <string_view>
+#include <unistd.h>
+
+static constexpr std::string_view TAG = "BootCache";
+
+namespace flx::core {
+
+namespace {
+
+std::string cacheKey(const std::string& profileId) {
+	char sha[17] = {};
+	esp_app_get_elf_sha256(sha, sizeof(sha));
+	return std::string(sha) + " " + profileId;
+}
+
+bool readLine(FILE* f, std::string& line) {
+	line.clear();
+	char chunk[128];
+	while (fgets(chunk, sizeof(chunk), f)) {
+		line += chunk;
+		if (line.back() == '\n') {
+			line.pop_back();
+			return true;
+		}
+	}
+	return !line.empty();
+}
+
+} // namespace
+
+BootCache& BootCache::getInstance() {
+	static BootCache instance;
+	return instance;
+}
+
+// ============================================================
+// Persistence
+// ============================================================
+
+void BootCache::load(const std::string& profileId) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_key = cacheKey(profileId);
+	m_entries.clear();
+	m_warm = false;
+	m_dirty = false;
+
+	FILE* f = fopen(PATH, "r");
+	if (!f) {
+		Log::info(TAG, "No boot cache, probing everything");
+		return;
+	}
+
+	std::string line;
+	bool valid = readLine(f, line) && line == "flxcache 1";
+	valid = valid && readLine(f, line) && line == "key " + m_key;
+	bool ended = false;
+	std::map<std::string, std::string> entries;
+	while (valid && !ended && readLine(f, line)) {
+		size_t const space = line.find(' ');
+		if (line == "end") {
+			ended = true;
+		} else if (space != std::string::npos && space > 0) {
+			entries[line.substr(0, space)] = line.substr(space + 1);
+		} else {
+			valid = false;
+		}
+	}
+	fclose(f);
+
+	if (!valid || !ended) {
+		// Another build or board wrote it, or the write was cut short
+		Log::info(TAG, "Boot cache is stale, probing everything");
+		m_dirty = true;
+		return;
+	}
+	m_entries = std::move(entries);
+	m_warm = true;
+	Log::info(TAG, "Loaded %u cached entries", (unsigned)m_entries.size());
+}
+
+bool BootCache::save() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_dirty || m_key.empty()) return true;
+
+	std::string const tmpPath = std::string(PATH) + ".tmp";
+	FILE* f = fopen(tmpPath.c_str(), "w");
+	if (!f) {
+		Log::warn(TAG, "Cannot write %s", tmpPath.c_str());
+		return false;
+	}
+	fprintf(f, "flxcache 1\nkey %s\n", m_key.c_str());
+	for (const auto& [key, value]: m_entries) fprintf(f, "%s %s\n", key.c_str(), value.c_str());
+	fprintf(f, "end\n");
+	fflush(f);
+	fsync(fileno(f));
+	fclose(f);
+	if (rename(tmpPath.c_str(), PATH) != 0) {
+		Log::warn(TAG, "Cannot rename %s", tmpPath.c_str());
+		return false;
+	}
+
+	m_dirty = false;
+	Log::info(TAG, "Saved %u entries to %s", (unsigned)m_entries.size(), PATH);
+	return true;
+}
+
+void BootCache::clear() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+	m_warm = false;
+	m_dirty = false;
+	unlink(PATH);
+}
+
+// ============================================================
+// Entries
+// ============================================================
+
+bool BootCache::get(const std::string& key, std::string& value) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_entries.find(key);
+	if (it == m_entries.end()) {
+		m_misses++;
+		return false;
+	}
+	m_hits++;
+	value = it->second;
+	return true;
+}
+
+void BootCache::put(const std::string& key, const std::string& value) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto& entry = m_entries[key];
+	if (entry == value) return;
+	entry = value;
+	m_dirty = true;
+	m_updates++;
+}
+
+void BootCache::invalidate(const std::string& key) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_entries.erase(key) == 0) return;
+	m_dirty = true;
+	m_updates++;
+}
+
+BootCache::Stats BootCache::getStats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return {m_key, m_warm, m_hits, m_misses, m_updates};
+}
+
+std::vector<std::pair<std::string, std::string>> BootCache::getEntries() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return {m_entries.begin(), m_entries.end()};
+}
+
+} // namespace flx::core
@@ -0,0 +1,154 @@
+#include "esp_app_desc.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <flx/core/BootTimeline.hpp>
+#include <flx/core/Logger.hpp>
+#include <string_view>
+#include <unistd.h>
+
+static constexpr std::string_view TAG = "BootTimeline";
+
+namespace flx::core {
+
+namespace {
+
+struct Slot {
+	std::atomic<bool> ready {false};
+	BootTimeline::Phase phase {};
+};
+
+Slot s_slots[BootTimeline::MAX_PHASES];
+std::atomic<size_t> s_count {0};
+
+std::string buildId() {
+	const esp_app_desc_t* app = esp_app_get_description();
+	char sha[9] = {};
+	esp_app_get_elf_sha256(sha, sizeof(sha));
+	return std::string(app->version) + " " + sha;
+}
+
+} // namespace
+
+// ============================================================
+// Recording
+// ============================================================
+
+void BootTimeline::record(const char* name, int64_t startUs, int64_t endUs) {
+	if (isFrozen()) return;
+	size_t const index = s_count.fetch_add(1, std::memory_order_relaxed);
+	if (index >= MAX_PHASES) return;
+
+	Slot& slot = s_slots[index];
+	strncpy(slot.phase.name, name, NAME_LEN - 1);
+	slot.phase.startUs = static_cast<uint32_t>(startUs);
+	slot.phase.endUs = static_cast<uint32_t>(endUs);
+	slot.ready.store(true, std::memory_order_release);
+}
+
+void BootTimeline::mark(const char* name) {
+	int64_t const now = esp_timer_get_time();
+	record(name, now, now);
+}
+
+BootTimeline::Timeline BootTimeline::current() {
+	Timeline timeline;
+	timeline.build = buildId();
+	timeline.resetReason = static_cast<int>(esp_reset_reason());
+
+	size_t const count = std::min(s_count.load(std::memory_order_relaxed), MAX_PHASES);
+	timeline.phases.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		if (s_slots[i].ready.load(std::memory_order_acquire)) timeline.phases.push_back(s_slots[i].phase);
+	}
+	return timeline;
+}
+
+BootPhase::BootPhase(const char* name) : m_name(name), m_startUs(esp_timer_get_time()) {}
+
+BootPhase::~BootPhase() {
+	BootTimeline::record(m_name, m_startUs, esp_timer_get_time());
+}
+
+// ============================================================
+// Persistence
+// ============================================================
+
+void BootTimeline::write(FILE* out, const Timeline& timeline) {
+	fprintf(out, "flxboot 1\n");
+	fprintf(out, "build %s\n", timeline.build.c_str());
+	fprintf(out, "reset %d\n", timeline.resetReason);
+	for (const auto& phase: timeline.phases) {
+		fprintf(out, "%lu %lu %s\n", (unsigned long)phase.startUs, (unsigned long)phase.endUs, phase.name);
+	}
+	fprintf(out, "end\n");
+}
+
+bool BootTimeline::save() {
+	Timeline const timeline = current();
+
+	// Keep exactly one previous boot for comparison
+	unlink(PREVIOUS_PATH);
+	rename(PATH, PREVIOUS_PATH);
+
+	std::string const tmpPath = std::string(PATH) + ".tmp";
+	FILE* f = fopen(tmpPath.c_str(), "w");
+	if (!f) {
+		Log::warn(TAG, "Cannot write %s", tmpPath.c_str());
+		return false;
+	}
+	write(f, timeline);
+	fflush(f);
+	fsync(fileno(f));
+	fclose(f);
+	if (rename(tmpPath.c_str(), PATH) != 0) {
+		Log::warn(TAG, "Cannot rename %s", tmpPath.c_str());
+		return false;
+	}
+
+	Log::info(TAG, "Saved %u phases to %s", (unsigned)timeline.phases.size(), PATH);
+#if CONFIG_FLXOS_BOOT_TIMELINE_CONSOLE
+	// Lets 'flxos.py boottime' read the timeline from a captured console log (e.g. QEMU)
+	write(stdout, timeline);
+	fflush(stdout);
+#endif
+	return true;
+}
+
+bool BootTimeline::load(const char* path, Timeline& out) {
+	FILE* f = fopen(path, "r");
+	if (!f) return false;
+
+	out = {};
+	char line[96];
+	bool valid = fgets(line, sizeof(line), f) && strcmp(line, "flxboot 1\n") == 0;
+	bool ended = false;
+	while (valid && !ended && fgets(line, sizeof(line), f)) {
+		line[strcspn(line, "\n")] = '\0';
+		unsigned long start = 0;
+		unsigned long end = 0;
+		int nameOffset = 0;
+		if (strncmp(line, "build ", 6) == 0) {
+			out.build = line + 6;
+		} else if (strncmp(line, "reset ", 6) == 0) {
+			out.resetReason = atoi(line + 6);
+		} else if (strcmp(line, "end") == 0) {
+			ended = true;
+		} else if (sscanf(line, "%lu %lu %n", &start, &end, &nameOffset) == 2 && nameOffset > 0) {
+			Phase phase {};
+			strncpy(phase.name, line + nameOffset, NAME_LEN - 1);
+			phase.startUs = static_cast<uint32_t>(start);
+			phase.endUs = static_cast<uint32_t>(end);
+			out.phases.push_back(phase);
+		} else {
+			valid = false;
+		}
+	}
+	fclose(f);
+	return valid && ended;
+}
+
+} // namespace flx::core
@@ -1,182 +1,145 @@
+#include <algorithm>
 #include <flx/core/Bundle.hpp>
+#include <iterator>
 
 namespace flx::core {
 
 // ============================================================
-// Value copy constructor & assignment (deep copy nested Bundle)
+// Bundle copy/move constructor & assignment
 // ============================================================
 
-Bundle::Value::Value(const Value& other)
-	: type(other.type),
-	  valueString(other.valueString),
-	  valueBlob(other.valueBlob) {
-	switch (type) {
-		case Type::Bool:
-			valueBool = other.valueBool;
-			break;
-		case Type::Int32:
-			valueInt32 = other.valueInt32;
-			break;
-		case Type::Int64:
-			valueInt64 = other.valueInt64;
-			break;
-		case Type::Float:
-			valueFloat = other.valueFloat;
-			break;
-		default:
-			valueBool = false;
-			break;
-	}
-	if (other.valueBundle) {
-		valueBundle = std::make_unique<Bundle>(*other.valueBundle);
+Bundle::Bundle(const Bundle& other)
+	: m_spill(other.m_spill),
+	  m_size(other.m_size) {
+	if (m_spill.empty()) {
+		std::copy_n(other.m_inline.begin(), m_size, m_inline.begin());
 	}
 }
 
-Bundle::Value& Bundle::Value::operator=(const Value& other) {
-	if (this == &other) return *this;
-	type = other.type;
-	valueString = other.valueString;
-	valueBlob = other.valueBlob;
-	switch (type) {
-		case Type::Bool:
-			valueBool = other.valueBool;
-			break;
-		case Type::Int32:
-			valueInt32 = other.valueInt32;
-			break;
-		case Type::Int64:
-			valueInt64 = other.valueInt64;
-			break;
-		case Type::Float:
-			valueFloat = other.valueFloat;
-			break;
-		default:
-			valueBool = false;
-			break;
-	}
-	if (other.valueBundle) {
-		valueBundle = std::make_unique<Bundle>(*other.valueBundle);
-	} else {
-		valueBundle.reset();
+Bundle& Bundle::operator=(const Bundle& other) {
+	if (this != &other) {
+		clear();
+		m_spill = other.m_spill;
+		m_size = other.m_size;
+		if (m_spill.empty()) {
+			std::copy_n(other.m_inline.begin(), m_size, m_inline.begin());
+		}
 	}
 	return *this;
 }
 
-// ============================================================
-// Bundle copy constructor & assignment
-// ============================================================
-
-Bundle::Bundle(const Bundle& other) {
-	m_entries = other.m_entries;
+Bundle::Bundle(Bundle&& other) noexcept
+	: m_spill(std::move(other.m_spill)),
+	  m_size(other.m_size) {
+	if (m_spill.empty()) {
+		std::move(other.m_inline.begin(), other.m_inline.begin() + m_size, m_inline.begin());
+	}
+	other.clear();
 }
 
-Bundle& Bundle::operator=(const Bundle& other) {
+Bundle& Bundle::operator=(Bundle&& other) noexcept {
 	if (this != &other) {
-		m_entries = other.m_entries;
+		clear();
+		m_spill = std::move(other.m_spill);
+		m_size = other.m_size;
+		if (m_spill.empty()) {
+			std::move(other.m_inline.begin(), other.m_inline.begin() + m_size, m_inline.begin());
+		}
+		other.clear();
 	}
 	return *this;
 }
 
 // ============================================================
-// Typed putters
+// Sorted small-vector storage
 // ============================================================
 
-void Bundle::putBool(const std::string& key, bool value) {
-	Value v;
-	v.type = Type::Bool;
-	v.valueBool = value;
-	m_entries[key] = std::move(v);
+const Bundle::Entry* Bundle::findEntry(const std::string& key) const {
+	const Entry* first = entries();
+	const Entry* last = first + m_size;
+	const Entry* it = std::lower_bound(first, last, key, [](const Entry& e, const std::string& k) { return e.key < k; });
+	return (it != last && it->key == key) ? it : nullptr;
 }
 
-void Bundle::putInt32(const std::string& key, int32_t value) {
-	Value v;
-	v.type = Type::Int32;
-	v.valueInt32 = value;
-	m_entries[key] = std::move(v);
-}
-
-void Bundle::putInt64(const std::string& key, int64_t value) {
-	Value v;
-	v.type = Type::Int64;
-	v.valueInt64 = value;
-	m_entries[key] = std::move(v);
+const Bundle::Value* Bundle::findEntry(const std::string& key, Type expectedType) const {
+	const Entry* entry = findEntry(key);
+	if (entry && entry->value.index() == static_cast<size_t>(expectedType)) {
+		return &entry->value;
+	}
+	return nullptr;
 }
 
-void Bundle::putFloat(const std::string& key, float value) {
-	Value v;
-	v.type = Type::Float;
-	v.valueFloat = value;
-	m_entries[key] = std::move(v);
-}
+void Bundle::put(const std::string& key, Value&& value) {
+	Entry* first = entries();
+	Entry* last = first + m_size;
+	Entry* it = std::lower_bound(first, last, key, [](const Entry& e, const std::string& k) { return e.key < k; });
+	if (it != last && it->key == key) {
+		it->value = std::move(value);
+		return;
+	}
 
-void Bundle::putString(const std::string& key, const std::string& value) {
-	Value v;
-	v.type = Type::String;
-	v.valueString = value;
-	m_entries[key] = std::move(v);
-}
+	size_t pos = static_cast<size_t>(it - first);
 
-void Bundle::putBlob(const std::string& key, const std::vector<uint8_t>& value) {
-	Value v;
-	v.type = Type::Blob;
-	v.valueBlob = value;
-	m_entries[key] = std::move(v);
-}
+	if (m_spill.empty() && m_size < INLINE_CAPACITY) {
+		// Shift the tail right by one inside the inline buffer
+		std::move_backward(first + pos, last, last + 1);
+		m_inline[pos].key = key;
+		m_inline[pos].value = std::move(value);
+		m_size++;
+		return;
+	}
 
-void Bundle::putBlob(const std::string& key, std::vector<uint8_t>&& value) {
-	Value v;
-	v.type = Type::Blob;
-	v.valueBlob = std::move(value);
-	m_entries[key] = std::move(v);
-}
+	if (m_spill.empty()) {
+		// First spill: migrate the inline entries to the heap
+		m_spill.reserve(INLINE_CAPACITY * 2);
+		std::move(m_inline.begin(), m_inline.end(), std::back_inserter(m_spill));
+		for (auto& e: m_inline) {
+			e = Entry {};
+		}
+	}
 
-void Bundle::putBundle(const std::string& key, const Bundle& value) {
-	Value v;
-	v.type = Type::Bundle;
-	v.valueBundle = std::make_unique<Bundle>(value);
-	m_entries[key] = std::move(v);
+	m_spill.insert(m_spill.begin() + static_cast<ptrdiff_t>(pos), Entry {key, std::move(value)});
+	m_size++;
 }
 
 // ============================================================
-// Typed getters
+// Typed putters
 // ============================================================
 
-bool Bundle::getBool(const std::string& key) const {
-	auto it = m_entries.find(key);
-	return it != m_entries.end() ? it->second.valueBool : false;
-}
-
-int32_t Bundle::getInt32(const std::string& key) const {
-	auto it = m_entries.find(key);
-	return it != m_entries.end() ? it->second.valueInt32 : 0;
-}
+void Bundle::putBool(const std::string& key, bool value) { put(key, Value(std::in_place_type<bool>, value)); }
+void Bundle::putInt32(const std::string& key, int32_t value) { put(key, Value(std::in_place_type<int32_t>, value)); }
+void Bundle::putInt64(const std::string& key, int64_t value) { put(key, Value(std::in_place_type<int64_t>, value)); }
+void Bundle::putFloat(const std::string& key, float value) { put(key, Value(std::in_place_type<float>, value)); }
+void Bundle::putString(const std::string& key, const std::string& value) { put(key, Value(std::in_place_type<std::string>, value)); }
+void Bundle::putBlob(const std::string& key, const std::vector<uint8_t>& value) { put(key, Value(std::in_place_type<std::vector<uint8_t>>, value)); }
+void Bundle::putBlob(const std::string& key, std::vector<uint8_t>&& value) { put(key, Value(std::in_place_type<std::vector<uint8_t>>, std::move(value))); }
+void Bundle::putBundle(const std::string& key, const Bundle& value) { put(key, Value(std::in_place_type<NestedBundle>, value)); }
 
-int64_t Bundle::getInt64(const std::string& key) const {
-	auto it = m_entries.find(key);
-	return it != m_entries.end() ? it->second.valueInt64 : 0;
-}
+// ============================================================
+// Typed getters
+// ============================================================
 
-float Bundle::getFloat(const std::string& key) const {
-	auto it = m_entries.find(key);
-	return it != m_entries.end() ? it->second.valueFloat : 0.0f;
-}
+bool Bundle::getBool(const std::string& key) const { return getBoolOr(key, false); }
+int32_t Bundle::getInt32(const std::string& key) const { return getInt32Or(key, 0); }
+int64_t Bundle::getInt64(const std::string& key) const { return getInt64Or(key, 0); }
+float Bundle::getFloat(const std::string& key) const { return getFloatOr(key, 0.0f); }
 
 std::string Bundle::getString(const std::string& key) const {
-	auto it = m_entries.find(key);
-	return it != m_entries.end() ? it->second.valueString : "";
+	auto* v = findEntry(key, Type::String);
+	return v ? std::get<std::string>(*v) : std::string();
 }
 
 const std::vector<uint8_t>& Bundle::getBlob(const std::string& key) const {
 	static const std::vector<uint8_t> empty;
-	auto it = m_entries.find(key);
-	return it != m_entries.end() ? it->second.valueBlob : empty;
+	auto* v = findEntry(key, Type::Blob);
+	return v ? std::get<std::vector<uint8_t>>(*v) : empty;
 }
 
 const Bundle& Bundle::getBundle(const std::string& key) const {
 	static const Bundle empty;
-	auto it = m_entries.find(key);
-	if (it != m_entries.end() && it->second.valueBundle) {
-		return *it->second.valueBundle;
+	auto* v = findEntry(key, Type::Bundle);
+	if (v && std::get<NestedBundle>(*v).ptr) {
+		return *std::get<NestedBundle>(*v).ptr;
 	}
 	return empty;
 }
@@ -185,14 +148,6 @@ const Bundle& Bundle::getBundle(const std::string& key) const {
 // Type-checked presence queries
 // ============================================================
 
-const Bundle::Value* Bundle::findEntry(const std::string& key, Type expectedType) const {
-	auto it = m_entries.find(key);
-	if (it != m_entries.end() && it->second.type == expectedType) {
-		return &it->second;
-	}
-	return nullptr;
-}
-
 bool Bundle::hasBool(const std::string& key) const { return findEntry(key, Type::Bool) != nullptr; }
 bool Bundle::hasInt32(const std::string& key) const { return findEntry(key, Type::Int32) != nullptr; }
 bool Bundle::hasInt64(const std::string& key) const { return findEntry(key, Type::Int64) != nullptr; }
@@ -208,7 +163,7 @@ bool Bundle::hasBundle(const std::string& key) const { return findEntry(key, Typ
 bool Bundle::optBool(const std::string& key, bool& out) const {
 	auto* v = findEntry(key, Type::Bool);
 	if (v) {
-		out = v->valueBool;
+		out = std::get<bool>(*v);
 		return true;
 	}
 	return false;
@@ -217,7 +172,7 @@ bool Bundle::optBool(const std::string& key, bool& out) const {
 bool Bundle::optInt32(const std::string& key, int32_t& out) const {
 	auto* v = findEntry(key, Type::Int32);
 	if (v) {
-		out = v->valueInt32;
+		out = std::get<int32_t>(*v);
 		return true;
 	}
 	return false;
@@ -226,7 +181,7 @@ bool Bundle::optInt32(const std::string& key, int32_t& out) const {
 bool Bundle::optInt64(const std::string& key, int64_t& out) const {
 	auto* v = findEntry(key, Type::Int64);
 	if (v) {
-		out = v->valueInt64;
+		out = std::get<int64_t>(*v);
 		return true;
 	}
 	return false;
@@ -235,7 +190,7 @@ bool Bundle::optInt64(const std::string& key, int64_t& out) const {
 bool Bundle::optFloat(const std::string& key, float& out) const {
 	auto* v = findEntry(key, Type::Float);
 	if (v) {
-		out = v->valueFloat;
+		out = std::get<float>(*v);
 		return true;
 	}
 	return false;
@@ -244,7 +199,7 @@ bool Bundle::optFloat(const std::string& key, float& out) const {
 bool Bundle::optString(const std::string& key, std::string& out) const {
 	auto* v = findEntry(key, Type::String);
 	if (v) {
-		out = v->valueString;
+		out = std::get<std::string>(*v);
 		return true;
 	}
 	return false;
@@ -256,27 +211,27 @@ bool Bundle::optString(const std::string& key, std::string& out) const {
 
 bool Bundle::getBoolOr(const std::string& key, bool defaultValue) const {
 	auto* v = findEntry(key, Type::Bool);
-	return v ? v->valueBool : defaultValue;
+	return v ? std::get<bool>(*v) : defaultValue;
 }
 
 int32_t Bundle::getInt32Or(const std::string& key, int32_t defaultValue) const {
 	auto* v = findEntry(key, Type::Int32);
-	return v ? v->valueInt32 : defaultValue;
+	return v ? std::get<int32_t>(*v) : defaultValue;
 }
 
 int64_t Bundle::getInt64Or(const std::string& key, int64_t defaultValue) const {
 	auto* v = findEntry(key, Type::Int64);
-	return v ? v->valueInt64 : defaultValue;
+	return v ? std::get<int64_t>(*v) : defaultValue;
 }
 
 float Bundle::getFloatOr(const std::string& key, float defaultValue) const {
 	auto* v = findEntry(key, Type::Float);
-	return v ? v->valueFloat : defaultValue;
+	return v ? std::get<float>(*v) : defaultValue;
 }
 
 std::string Bundle::getStringOr(const std::string& key, const std::string& defaultValue) const {
 	auto* v = findEntry(key, Type::String);
-	return v ? v->valueString : defaultValue;
+	return v ? std::get<std::string>(*v) : defaultValue;
 }
 
 // ============================================================
@@ -284,18 +239,28 @@ std::string Bundle::getStringOr(const std::string& key, const std::string& defau
 // ============================================================
 
 bool Bundle::hasKey(const std::string& key) const {
-	return m_entries.find(key) != m_entries.end();
+	return findEntry(key) != nullptr;
 }
 
-size_t Bundle::size() const { return m_entries.size(); }
-bool Bundle::empty() const { return m_entries.empty(); }
-void Bundle::clear() { m_entries.clear(); }
+size_t Bundle::size() const { return m_size; }
+bool Bundle::empty() const { return m_size == 0; }
+
+void Bundle::clear() {
+	// Reset only the occupied inline slots; unused ones are already empty
+	size_t inlineUsed = m_spill.empty() ? std::min(m_size, INLINE_CAPACITY) : 0;
+	for (size_t i = 0; i < inlineUsed; i++) {
+		m_inline[i] = Entry {};
+	}
+	m_spill.clear();
+	m_size = 0;
+}
 
 std::vector<std::string> Bundle::keys() const {
 	std::vector<std::string> result;
-	result.reserve(m_entries.size());
-	for (const auto& [key, _]: m_entries) {
-		result.push_back(key);
+	result.reserve(m_size);
+	const Entry* first = entries();
+	for (size_t i = 0; i < m_size; i++) {
+		result.push_back(first[i].key);
 	}
 	return result;
 }
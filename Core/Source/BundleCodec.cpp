@@ -0,0 +1,461 @@
+#include <cstdio>
+#include <cstring>
+#include <flx/core/BundleCodec.hpp>
+#include <flx/core/Logger.hpp>
+#include <unistd.h>
+
+namespace flx::core {
+
+static constexpr const char* TAG = "BundleCodec";
+
+static constexpr size_t BODY_HEADER_SIZE = 6; // u32 length + u16 count
+static constexpr size_t ENTRY_HEADER_SIZE = 2; // u8 type + u8 key length
+
+// ============================================================
+// Little-endian helpers
+// ============================================================
+
+static uint16_t readU16(const uint8_t* p) {
+	return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t readU32(const uint8_t* p) {
+	return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static uint64_t readU64(const uint8_t* p) {
+	return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+static void writeU16(uint8_t* p, uint16_t v) {
+	p[0] = static_cast<uint8_t>(v);
+	p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+static void writeU32(uint8_t* p, uint32_t v) {
+	for (int i = 0; i < 4; i++) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+static void appendU32(std::vector<uint8_t>& out, uint32_t v) {
+	uint8_t buf[4];
+	writeU32(buf, v);
+	out.insert(out.end(), buf, buf + 4);
+}
+
+static void appendU64(std::vector<uint8_t>& out, uint64_t v) {
+	appendU32(out, static_cast<uint32_t>(v));
+	appendU32(out, static_cast<uint32_t>(v >> 32));
+}
+
+/**
+ * Size of a fixed-width payload, or 0 for length-prefixed types.
+ */
+static size_t fixedPayloadSize(Bundle::Type type) {
+	switch (type) {
+		case Bundle::Type::Bool:
+			return 1;
+		case Bundle::Type::Int32:
+		case Bundle::Type::Float:
+			return 4;
+		case Bundle::Type::Int64:
+			return 8;
+		default:
+			return 0;
+	}
+}
+
+// ============================================================
+// BundleView — validation
+// ============================================================
+
+bool BundleView::validateBody(const uint8_t* data, size_t size, size_t& consumed, int depth) {
+	if (depth > bundle_codec::MAX_DEPTH || size < BODY_HEADER_SIZE) return false;
+
+	size_t length = readU32(data);
+	uint16_t count = readU16(data + 4);
+	if (length > size - BODY_HEADER_SIZE) return false;
+
+	const uint8_t* p = data + BODY_HEADER_SIZE;
+	const uint8_t* end = p + length;
+
+	for (uint16_t i = 0; i < count; i++) {
+		if (static_cast<size_t>(end - p) < ENTRY_HEADER_SIZE) return false;
+		uint8_t type = p[0];
+		size_t keyLen = p[1];
+		if (type > static_cast<uint8_t>(Bundle::Type::Bundle)) return false;
+		p += ENTRY_HEADER_SIZE;
+		if (static_cast<size_t>(end - p) < keyLen) return false;
+		p += keyLen;
+
+		auto t = static_cast<Bundle::Type>(type);
+		size_t avail = static_cast<size_t>(end - p);
+		if (size_t fixed = fixedPayloadSize(t)) {
+			if (avail < fixed) return false;
+			p += fixed;
+		} else if (t == Bundle::Type::Bundle) {
+			size_t nested = 0;
+			if (!validateBody(p, avail, nested, depth + 1)) return false;
+			p += nested;
+		} else {
+			if (avail < 4) return false;
+			size_t len = readU32(p);
+			if (len > avail - 4) return false;
+			p += 4 + len;
+		}
+	}
+
+	if (p != end) return false;
+	consumed = BODY_HEADER_SIZE + length;
+	return true;
+}
+
+BundleView BundleView::parse(const uint8_t* data, size_t size) {
+	if (!data || size < bundle_codec::HEADER_SIZE + BODY_HEADER_SIZE) return {};
+	if (std::memcmp(data, bundle_codec::MAGIC, sizeof(bundle_codec::MAGIC)) != 0) return {};
+	if (data[3] == 0 || data[3] > bundle_codec::VERSION) return {};
+
+	const uint8_t* body = data + bundle_codec::HEADER_SIZE;
+	size_t bodySize = size - bundle_codec::HEADER_SIZE;
+	size_t consumed = 0;
+	if (!validateBody(body, bodySize, consumed, 0) || consumed != bodySize) return {};
+
+	return BundleView(body + BODY_HEADER_SIZE, readU32(body), readU16(body + 4));
+}
+
+// ============================================================
+// BundleView — queries (input already validated)
+// ============================================================
+
+bool BundleView::find(std::string_view key, Field& out) const {
+	const uint8_t* p = m_data;
+	for (uint16_t i = 0; i < m_count; i++) {
+		auto type = static_cast<Bundle::Type>(p[0]);
+		size_t keyLen = p[1];
+		std::string_view entryKey(reinterpret_cast<const char*>(p + ENTRY_HEADER_SIZE), keyLen);
+		p += ENTRY_HEADER_SIZE + keyLen;
+
+		size_t payloadSize = fixedPayloadSize(type);
+		if (payloadSize == 0) {
+			payloadSize = (type == Bundle::Type::Bundle ? BODY_HEADER_SIZE : 4) + readU32(p);
+		}
+
+		if (entryKey == key) {
+			out = {type, p, payloadSize};
+			return true;
+		}
+		p += payloadSize;
+	}
+	return false;
+}
+
+bool BundleView::hasKey(std::string_view key) const {
+	Field f;
+	return find(key, f);
+}
+
+bool BundleView::hasType(std::string_view key, Bundle::Type type) const {
+	Field f;
+	return find(key, f) && f.type == type;
+}
+
+bool BundleView::getBool(std::string_view key, bool defaultValue) const {
+	Field f;
+	return (find(key, f) && f.type == Bundle::Type::Bool) ? f.payload[0] != 0 : defaultValue;
+}
+
+int32_t BundleView::getInt32(std::string_view key, int32_t defaultValue) const {
+	Field f;
+	return (find(key, f) && f.type == Bundle::Type::Int32) ? static_cast<int32_t>(readU32(f.payload)) : defaultValue;
+}
+
+int64_t BundleView::getInt64(std::string_view key, int64_t defaultValue) const {
+	Field f;
+	return (find(key, f) && f.type == Bundle::Type::Int64) ? static_cast<int64_t>(readU64(f.payload)) : defaultValue;
+}
+
+float BundleView::getFloat(std::string_view key, float defaultValue) const {
+	Field f;
+	if (!find(key, f) || f.type != Bundle::Type::Float) return defaultValue;
+	uint32_t bits = readU32(f.payload);
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+std::string_view BundleView::getString(std::string_view key) const {
+	Field f;
+	if (!find(key, f) || f.type != Bundle::Type::String) return {};
+	return {reinterpret_cast<const char*>(f.payload + 4), f.payloadSize - 4};
+}
+
+BlobView BundleView::getBlob(std::string_view key) const {
+	Field f;
+	if (!find(key, f) || f.type != Bundle::Type::Blob) return {};
+	return {f.payload + 4, f.payloadSize - 4};
+}
+
+BundleView BundleView::getBundle(std::string_view key) const {
+	Field f;
+	if (!find(key, f) || f.type != Bundle::Type::Bundle) return {};
+	return BundleView(f.payload + BODY_HEADER_SIZE, readU32(f.payload), readU16(f.payload + 4));
+}
+
+Bundle BundleView::toBundle() const {
+	Bundle bundle;
+	const uint8_t* p = m_data;
+	for (uint16_t i = 0; i < m_count; i++) {
+		auto type = static_cast<Bundle::Type>(p[0]);
+		size_t keyLen = p[1];
+		std::string key(reinterpret_cast<const char*>(p + ENTRY_HEADER_SIZE), keyLen);
+		p += ENTRY_HEADER_SIZE + keyLen;
+
+		size_t payloadSize = fixedPayloadSize(type);
+		if (payloadSize == 0) {
+			payloadSize = (type == Bundle::Type::Bundle ? BODY_HEADER_SIZE : 4) + readU32(p);
+		}
+
+		switch (type) {
+			case Bundle::Type::Bool:
+				bundle.putBool(key, p[0] != 0);
+				break;
+			case Bundle::Type::Int32:
+				bundle.putInt32(key, static_cast<int32_t>(readU32(p)));
+				break;
+			case Bundle::Type::Int64:
+				bundle.putInt64(key, static_cast<int64_t>(readU64(p)));
+				break;
+			case Bundle::Type::Float: {
+				uint32_t bits = readU32(p);
+				float value;
+				std::memcpy(&value, &bits, sizeof(value));
+				bundle.putFloat(key, value);
+				break;
+			}
+			case Bundle::Type::String:
+				bundle.putString(key, std::string(reinterpret_cast<const char*>(p + 4), payloadSize - 4));
+				break;
+			case Bundle::Type::Blob:
+				bundle.putBlob(key, std::vector<uint8_t>(p + 4, p + payloadSize));
+				break;
+			case Bundle::Type::Bundle:
+				bundle.putBundle(key, BundleView(p + BODY_HEADER_SIZE, readU32(p), readU16(p + 4)).toBundle());
+				break;
+		}
+		p += payloadSize;
+	}
+	return bundle;
+}
+
+// ============================================================
+// BundleWriter
+// ============================================================
+
+BundleWriter::BundleWriter(std::vector<uint8_t>& out) : m_out(out) {
+	m_out.insert(m_out.end(), bundle_codec::MAGIC, bundle_codec::MAGIC + sizeof(bundle_codec::MAGIC));
+	m_out.push_back(bundle_codec::VERSION);
+	openBody();
+}
+
+void BundleWriter::openBody() {
+	m_frames.push_back({m_out.size(), 0});
+	m_out.resize(m_out.size() + BODY_HEADER_SIZE); // Patched in closeBody()
+}
+
+void BundleWriter::closeBody() {
+	const Frame& frame = m_frames.back();
+	size_t length = m_out.size() - frame.lengthOffset - BODY_HEADER_SIZE;
+	writeU32(m_out.data() + frame.lengthOffset, static_cast<uint32_t>(length));
+	writeU16(m_out.data() + frame.lengthOffset + 4, frame.count);
+	m_frames.pop_back();
+}
+
+bool BundleWriter::beginEntry(Bundle::Type type, std::string_view key) {
+	if (m_failed || m_finished || m_frames.empty()) return false;
+	if (key.size() > bundle_codec::MAX_KEY_LENGTH || m_frames.back().count == UINT16_MAX) {
+		m_failed = true;
+		return false;
+	}
+	m_frames.back().count++;
+	m_out.push_back(static_cast<uint8_t>(type));
+	m_out.push_back(static_cast<uint8_t>(key.size()));
+	m_out.insert(m_out.end(), key.begin(), key.end());
+	return true;
+}
+
+bool BundleWriter::putBool(std::string_view key, bool value) {
+	if (!beginEntry(Bundle::Type::Bool, key)) return false;
+	m_out.push_back(value ? 1 : 0);
+	return true;
+}
+
+bool BundleWriter::putInt32(std::string_view key, int32_t value) {
+	if (!beginEntry(Bundle::Type::Int32, key)) return false;
+	appendU32(m_out, static_cast<uint32_t>(value));
+	return true;
+}
+
+bool BundleWriter::putInt64(std::string_view key, int64_t value) {
+	if (!beginEntry(Bundle::Type::Int64, key)) return false;
+	appendU64(m_out, static_cast<uint64_t>(value));
+	return true;
+}
+
+bool BundleWriter::putFloat(std::string_view key, float value) {
+	if (!beginEntry(Bundle::Type::Float, key)) return false;
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	appendU32(m_out, bits);
+	return true;
+}
+
+bool BundleWriter::putString(std::string_view key, std::string_view value) {
+	if (!beginEntry(Bundle::Type::String, key)) return false;
+	appendU32(m_out, static_cast<uint32_t>(value.size()));
+	m_out.insert(m_out.end(), value.begin(), value.end());
+	return true;
+}
+
+bool BundleWriter::putBlob(std::string_view key, const uint8_t* data, size_t size) {
+	if (!beginEntry(Bundle::Type::Blob, key)) return false;
+	appendU32(m_out, static_cast<uint32_t>(size));
+	if (size > 0) m_out.insert(m_out.end(), data, data + size);
+	return true;
+}
+
+bool BundleWriter::beginBundle(std::string_view key) {
+	if (!beginEntry(Bundle::Type::Bundle, key)) return false;
+	openBody();
+	return true;
+}
+
+bool BundleWriter::endBundle() {
+	if (m_failed || m_finished || m_frames.size() < 2) {
+		m_failed = true;
+		return false;
+	}
+	closeBody();
+	return true;
+}
+
+bool BundleWriter::putBundle(std::string_view key, const Bundle& value) {
+	return beginBundle(key) && putAll(value) && endBundle();
+}
+
+bool BundleWriter::putAll(const Bundle& bundle) {
+	const Bundle::Entry* entries = bundle.entries();
+	for (size_t i = 0; i < bundle.m_size && ok(); i++) {
+		const auto& key = entries[i].key;
+		const auto& value = entries[i].value;
+		switch (static_cast<Bundle::Type>(value.index())) {
+			case Bundle::Type::Bool:
+				putBool(key, std::get<bool>(value));
+				break;
+			case Bundle::Type::Int32:
+				putInt32(key, std::get<int32_t>(value));
+				break;
+			case Bundle::Type::Int64:
+				putInt64(key, std::get<int64_t>(value));
+				break;
+			case Bundle::Type::Float:
+				putFloat(key, std::get<float>(value));
+				break;
+			case Bundle::Type::String:
+				putString(key, std::get<std::string>(value));
+				break;
+			case Bundle::Type::Blob: {
+				const auto& blob = std::get<std::vector<uint8_t>>(value);
+				putBlob(key, blob.data(), blob.size());
+				break;
+			}
+			case Bundle::Type::Bundle: {
+				const auto& nested = std::get<Bundle::NestedBundle>(value);
+				if (beginBundle(key)) {
+					if (nested.ptr) putAll(*nested.ptr);
+					endBundle();
+				}
+				break;
+			}
+		}
+	}
+	return ok();
+}
+
+bool BundleWriter::finish() {
+	if (m_finished) return ok();
+	if (m_failed || m_frames.size() != 1) {
+		m_failed = true;
+		return false;
+	}
+	closeBody();
+	m_finished = true;
+	return true;
+}
+
+// ============================================================
+// Convenience
+// ============================================================
+
+std::vector<uint8_t> encodeBundle(const Bundle& bundle) {
+	std::vector<uint8_t> out;
+	BundleWriter writer(out);
+	writer.putAll(bundle);
+	if (!writer.finish()) out.clear();
+	return out;
+}
+
+bool decodeBundle(const uint8_t* data, size_t size, Bundle& out) {
+	out.clear();
+	BundleView view = BundleView::parse(data, size);
+	if (!view.isValid()) return false;
+	out = view.toBundle();
+	return true;
+}
+
+bool saveBundleToFile(const std::string& path, const Bundle& bundle) {
+	std::vector<uint8_t> data = encodeBundle(bundle);
+	if (data.empty()) {
+		Log::error(TAG, "Failed to encode bundle for %s", path.c_str());
+		return false;
+	}
+
+	std::string tmpPath = path + ".tmp";
+	FILE* f = fopen(tmpPath.c_str(), "wb");
+	if (!f) {
+		Log::error(TAG, "Failed to open %s for writing", tmpPath.c_str());
+		return false;
+	}
+	bool written = fwrite(data.data(), 1, data.size(), f) == data.size();
+	fflush(f);
+	fsync(fileno(f));
+	fclose(f);
+
+	if (!written) {
+		Log::error(TAG, "Short write to %s", tmpPath.c_str());
+		unlink(tmpPath.c_str());
+		return false;
+	}
+	unlink(path.c_str());
+	return rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+bool loadBundleFromFile(const std::string& path, Bundle& out) {
+	out.clear();
+	FILE* f = fopen(path.c_str(), "rb");
+	if (!f) return false;
+
+	fseek(f, 0, SEEK_END);
+	long len = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	std::vector<uint8_t> data(len > 0 ? static_cast<size_t>(len) : 0);
+	bool read = !data.empty() && fread(data.data(), 1, data.size(), f) == data.size();
+	fclose(f);
+
+	if (!read || !decodeBundle(data.data(), data.size(), out)) {
+		Log::warn(TAG, "Invalid bundle file %s", path.c_str());
+		return false;
+	}
+	return true;
+}
+
+} // namespace flx::core
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <flx/core/EventBus.hpp>
 #include <flx/core/Logger.hpp>
 
@@ -5,55 +6,373 @@ namespace flx::core {
 
 static constexpr const char* TAG = "EventBus";
 
+static bool startsWith(const std::string& str, const std::string& prefix) {
+	return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
 EventBus& EventBus::getInstance() {
 	static EventBus instance;
 	return instance;
 }
 
-EventBus::SubscriptionId EventBus::subscribe(const std::string& event, Callback callback) {
-	std::lock_guard<std::mutex> lock(m_mutex);
+// ============================================================
+// Topic interning
+// ============================================================
+
+EventBus::TopicId EventBus::internLocked(const std::string& event) {
+	auto it = m_topicIndex.find(event);
+	if (it != m_topicIndex.end()) {
+		return it->second;
+	}
+
+	TopicId id = static_cast<TopicId>(m_topics.size());
+	Topic& topic = m_topics.emplace_back();
+	topic.name = event;
+	if (event == "*") {
+		topic.isWildcard = true;
+	} else if (event.size() > 2 && event.compare(event.size() - 2, 2, ".*") == 0) {
+		topic.isWildcard = true;
+		topic.wildcardPrefix = event.substr(0, event.size() - 1);
+	}
+	m_topicIndex.emplace(event, id);
+
+	rebuildDispatchLocked(topic);
+	return id;
+}
+
+EventBus::TopicId EventBus::registerTopic(const std::string& event) {
+	std::lock_guard<Mutex> lock(m_mutex);
+	return internLocked(event);
+}
+
+const std::string& EventBus::getTopicName(TopicId topic) const {
+	static const std::string empty;
+	std::lock_guard<Mutex> lock(m_mutex);
+	return topic < m_topics.size() ? m_topics[topic].name : empty;
+}
+
+// ============================================================
+// Dispatch list maintenance (subscribe/unsubscribe time only)
+// ============================================================
+
+EventBus::DispatchList EventBus::collectListenersLocked(const std::string& name, const Topic* topic) const {
+	DispatchList list = topic ? topic->subscribers : DispatchList {};
+
+	for (const auto& other: m_topics) {
+		if (&other == topic || !other.isWildcard || other.subscribers.empty()) continue;
+		if (startsWith(name, other.wildcardPrefix)) {
+			list.insert(list.end(), other.subscribers.begin(), other.subscribers.end());
+		}
+	}
+	list.insert(list.end(), m_globalSubscribers.begin(), m_globalSubscribers.end());
+
+	// Preserve subscription order across direct, wildcard and global listeners
+	std::sort(list.begin(), list.end(), [](const Subscription& a, const Subscription& b) { return a.id < b.id; });
+	return list;
+}
+
+void EventBus::rebuildDispatchLocked(Topic& topic) {
+	DispatchList list = collectListenersLocked(topic.name, &topic);
+
+	if (list.empty()) {
+		topic.dispatch.reset();
+	} else {
+		topic.dispatch = std::make_shared<const DispatchList>(std::move(list));
+	}
+}
+
+void EventBus::rebuildMatchingLocked(const Topic& pattern) {
+	for (auto& topic: m_topics) {
+		if (&topic == &pattern || startsWith(topic.name, pattern.wildcardPrefix)) {
+			rebuildDispatchLocked(topic);
+		}
+	}
+}
+
+void EventBus::rebuildAllLocked() {
+	for (auto& topic: m_topics) {
+		rebuildDispatchLocked(topic);
+	}
+}
+
+EventBus::SubscriptionId EventBus::addSubscriptionLocked(TopicId topicId, Callback callback) {
 	SubscriptionId id = m_nextId++;
-	m_subscriptions.push_back({id, event, std::move(callback)});
+	Subscription sub {id, std::make_shared<const Callback>(std::move(callback))};
+	m_subscriptionTopics[id] = topicId;
+
+	if (topicId == ALL_TOPICS) {
+		m_globalSubscribers.push_back(std::move(sub));
+		rebuildAllLocked();
+		return id;
+	}
+
+	Topic& topic = m_topics[topicId];
+	topic.subscribers.push_back(std::move(sub));
+	if (topic.isWildcard) {
+		m_wildcardSubscriptions++;
+		rebuildMatchingLocked(topic);
+	} else {
+		rebuildDispatchLocked(topic);
+	}
+	return id;
+}
+
+// ============================================================
+// Subscription API
+// ============================================================
+
+EventBus::SubscriptionId EventBus::subscribe(const std::string& event, Callback callback) {
+	SubscriptionId id = 0;
+	std::function<void(const std::string&)> hook;
+	{
+		std::lock_guard<Mutex> lock(m_mutex);
+		id = addSubscriptionLocked(internLocked(event), std::move(callback));
+		hook = m_subscribeHook;
+	}
 	Log::info(TAG, "Subscribed to '%s' (id=%lu)", event.c_str(), (unsigned long)id);
+	if (hook) hook(event);
+	return id;
+}
+
+EventBus::SubscriptionId EventBus::subscribe(TopicId topic, Callback callback) {
+	SubscriptionId id = 0;
+	std::string name;
+	std::function<void(const std::string&)> hook;
+	{
+		std::lock_guard<Mutex> lock(m_mutex);
+		if (topic >= m_topics.size()) {
+			Log::warn(TAG, "Subscribe to unknown topic id=%lu ignored", (unsigned long)topic);
+			return 0;
+		}
+		id = addSubscriptionLocked(topic, std::move(callback));
+		name = m_topics[topic].name;
+		hook = m_subscribeHook;
+	}
+	Log::info(TAG, "Subscribed to '%s' (id=%lu)", name.c_str(), (unsigned long)id);
+	if (hook) hook(name);
 	return id;
 }
 
 EventBus::SubscriptionId EventBus::subscribeAll(Callback callback) {
-	std::lock_guard<std::mutex> lock(m_mutex);
-	SubscriptionId id = m_nextId++;
-	m_subscriptions.push_back({id, "", std::move(callback)});
+	std::lock_guard<Mutex> lock(m_mutex);
+	SubscriptionId id = addSubscriptionLocked(ALL_TOPICS, std::move(callback));
 	Log::info(TAG, "Subscribed to all events (id=%lu)", (unsigned long)id);
 	return id;
 }
 
 void EventBus::unsubscribe(SubscriptionId id) {
-	std::lock_guard<std::mutex> lock(m_mutex);
-	for (auto it = m_subscriptions.begin(); it != m_subscriptions.end(); ++it) {
-		if (it->id == id) {
-			Log::info(TAG, "Unsubscribed id=%lu", (unsigned long)id);
-			m_subscriptions.erase(it);
-			return;
+	std::lock_guard<Mutex> lock(m_mutex);
+	auto it = m_subscriptionTopics.find(id);
+	if (it == m_subscriptionTopics.end()) return;
+
+	TopicId topicId = it->second;
+	m_subscriptionTopics.erase(it);
+
+	auto byId = [id](const Subscription& s) { return s.id == id; };
+
+	if (topicId == ALL_TOPICS) {
+		m_globalSubscribers.erase(std::remove_if(m_globalSubscribers.begin(), m_globalSubscribers.end(), byId), m_globalSubscribers.end());
+		rebuildAllLocked();
+	} else {
+		Topic& topic = m_topics[topicId];
+		topic.subscribers.erase(std::remove_if(topic.subscribers.begin(), topic.subscribers.end(), byId), topic.subscribers.end());
+		if (topic.isWildcard) {
+			m_wildcardSubscriptions--;
+			rebuildMatchingLocked(topic);
+		} else {
+			rebuildDispatchLocked(topic);
 		}
 	}
+	Log::info(TAG, "Unsubscribed id=%lu", (unsigned long)id);
 }
 
+// ============================================================
+// Publishing
+// ============================================================
+
 void EventBus::publish(const std::string& event, const Bundle& data) {
-	// Copy subscriptions under lock, then invoke outside lock to avoid deadlocks
-	std::vector<Callback> toNotify;
+	// Publishing never interns: a name nobody subscribed to (dynamic, or a
+	// typo) would otherwise stay in m_topics for good
+	TopicId topic = INVALID_TOPIC;
+	DispatchList listeners;
+	{
+		std::lock_guard<Mutex> lock(m_mutex);
+		auto it = m_topicIndex.find(event);
+		if (it != m_topicIndex.end()) {
+			topic = it->second;
+		} else if (!m_globalSubscribers.empty() || m_wildcardSubscriptions > 0) {
+			listeners = collectListenersLocked(event, nullptr);
+		}
+	}
+	if (topic != INVALID_TOPIC) {
+		publish(topic, data);
+		return;
+	}
+
+	for (const auto& sub: listeners) {
+		if (sub.callback && *sub.callback) {
+			(*sub.callback)(event, data);
+		}
+	}
+}
+
+void EventBus::publish(TopicId topicId, const Bundle& data) {
+	// Snapshot the dispatch list under lock (refcount bump only), then invoke
+	// outside the lock so callbacks may subscribe/unsubscribe/publish freely
+	std::shared_ptr<const DispatchList> toNotify;
+	const std::string* name = nullptr;
+	{
+		std::lock_guard<Mutex> lock(m_mutex);
+		if (topicId >= m_topics.size()) return;
+		const Topic& topic = m_topics[topicId];
+		toNotify = topic.dispatch;
+		name = &topic.name; // Topics are never removed, name is immutable
+	}
+
+	if (!toNotify) return;
+
+	for (const auto& sub: *toNotify) {
+		if (sub.callback && *sub.callback) {
+			(*sub.callback)(*name, data);
+		}
+	}
+}
+
+// ============================================================
+// Asynchronous delivery
+// ============================================================
+
+bool EventBus::publishAsync(const std::string& event, const Bundle& data, AsyncOptions options) {
+	TopicId topic = INVALID_TOPIC;
+	{
+		std::lock_guard<Mutex> lock(m_mutex);
+		auto it = m_topicIndex.find(event);
+		if (it != m_topicIndex.end()) {
+			topic = it->second;
+		} else if ((!m_globalSubscribers.empty() || m_wildcardSubscriptions > 0) && !collectListenersLocked(event, nullptr).empty()) {
+			// Queued events carry a topic id; intern only names someone listens to
+			topic = internLocked(event);
+		} else {
+			return true; // Nobody would receive it
+		}
+	}
+	return publishAsync(topic, data, options);
+}
+
+bool EventBus::publishAsync(TopicId topicId, const Bundle& data, AsyncOptions options) {
+	if (topicId == INVALID_TOPIC) return false;
+
+	const size_t prio = std::min(static_cast<size_t>(options.priority), PRIORITY_COUNT - 1);
+	std::function<void()> wakeup;
 	{
-		std::lock_guard<std::mutex> lock(m_mutex);
-		for (const auto& sub: m_subscriptions) {
-			if (sub.event.empty() || sub.event == event) {
-				toNotify.push_back(sub.callback);
+		std::lock_guard<std::mutex> lock(m_asyncMutex);
+		AsyncRing& ring = m_asyncRings[prio];
+
+		// Only the newest pending event is a coalescing candidate, so an event
+		// never overtakes something queued after its predecessor (show/clear/show)
+		if (options.coalesce && ring.count > 0) {
+			AsyncEvent& last = ring.slots[(ring.head + ring.count - 1) % ASYNC_QUEUE_DEPTH];
+			if (last.coalesce && last.topic == topicId) {
+				last.data = data; // Latest payload wins
+				m_asyncStats.coalesced++;
+				return true;
 			}
 		}
+
+		if (ring.count == ASYNC_QUEUE_DEPTH) {
+			m_asyncStats.overflow[prio]++;
+			return false;
+		}
+
+		AsyncEvent& slot = ring.slots[(ring.head + ring.count) % ASYNC_QUEUE_DEPTH];
+		slot.topic = topicId;
+		slot.coalesce = options.coalesce;
+		slot.data = data;
+		ring.count++;
+
+		m_asyncStats.enqueued[prio]++;
+		m_asyncStats.pending++;
+		m_asyncStats.highWater = std::max(m_asyncStats.highWater, m_asyncStats.pending);
+		wakeup = m_asyncWakeup;
 	}
 
-	for (const auto& cb: toNotify) {
-		if (cb) {
-			cb(event, data);
+	if (wakeup) wakeup();
+	return true;
+}
+
+size_t EventBus::drainAsync(size_t maxEvents) {
+	size_t delivered = 0;
+	AsyncEvent event;
+
+	while (delivered < maxEvents) {
+		{
+			std::lock_guard<std::mutex> lock(m_asyncMutex);
+			AsyncRing* ring = nullptr;
+			for (size_t p = PRIORITY_COUNT; p-- > 0;) {
+				if (m_asyncRings[p].count > 0) {
+					ring = &m_asyncRings[p];
+					break;
+				}
+			}
+			if (!ring) break;
+
+			AsyncEvent& slot = ring->slots[ring->head];
+			event.topic = slot.topic;
+			event.data = std::move(slot.data);
+			slot.data = Bundle();
+			slot.topic = INVALID_TOPIC;
+			ring->head = (ring->head + 1) % ASYNC_QUEUE_DEPTH;
+			ring->count--;
+			m_asyncStats.pending--;
+			m_asyncStats.delivered++;
 		}
+
+		publish(event.topic, event.data);
+		delivered++;
 	}
+	return delivered;
+}
+
+void EventBus::setAsyncWakeup(std::function<void()> wakeup) {
+	std::lock_guard<std::mutex> lock(m_asyncMutex);
+	m_asyncWakeup = std::move(wakeup);
+}
+
+void EventBus::setSubscribeHook(std::function<void(const std::string& event)> hook) {
+	std::lock_guard<Mutex> lock(m_mutex);
+	m_subscribeHook = std::move(hook);
+}
+
+EventBus::AsyncStats EventBus::getAsyncStats() const {
+	std::lock_guard<std::mutex> lock(m_asyncMutex);
+	return m_asyncStats;
+}
+
+void EventBus::resetAsyncStats() {
+	std::lock_guard<std::mutex> lock(m_asyncMutex);
+	uint32_t pending = m_asyncStats.pending;
+	m_asyncStats = {};
+	m_asyncStats.pending = pending;
+	m_asyncStats.highWater = pending;
+}
+
+// ============================================================
+// Diagnostics
+// ============================================================
+
+bool EventBus::hasSubscribers(TopicId topic) const {
+	std::lock_guard<Mutex> lock(m_mutex);
+	return topic < m_topics.size() && m_topics[topic].dispatch != nullptr;
+}
+
+size_t EventBus::getTopicCount() const {
+	std::lock_guard<Mutex> lock(m_mutex);
+	return m_topics.size();
+}
+
+size_t EventBus::getSubscriptionCount() const {
+	std::lock_guard<Mutex> lock(m_mutex);
+	return m_subscriptionTopics.size();
 }
 
 } // namespace flx::core
@@ -0,0 +1,188 @@
+#include "esp_cpu.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include <algorithm>
+#include <cstring>
+#include <flx/core/LockProfiler.hpp>
+#include <new>
+
+namespace flx::core {
+
+struct LockProfile::Stats {
+	uint32_t acquisitions;
+	uint32_t contended;
+	uint32_t maxWaitUs;
+	uint32_t maxHoldUs;
+	uint64_t totalWaitUs;
+	uint64_t totalHoldUs;
+	uint32_t otherSites;
+	uint32_t waitHistogram[LockProfiler::HISTOGRAM_BUCKETS];
+	uint32_t holdHistogram[LockProfiler::HISTOGRAM_BUCKETS];
+	LockProfiler::Site sites[LockProfiler::MAX_SITES];
+	size_t siteCount;
+};
+
+namespace {
+
+// Profiles live inside mutexes that are members of singletons, so the list
+// must be usable from any static initialiser
+struct Registry {
+	std::mutex mutex;
+	LockProfile* head = nullptr;
+};
+
+Registry& registry() {
+	static Registry instance;
+	return instance;
+}
+
+} // namespace
+
+// ============================================================
+// Profiler
+// ============================================================
+
+void LockProfiler::setEnabled(bool enabled) {
+	if (enabled) {
+		auto& reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		for (LockProfile* p = reg.head; p; p = p->m_next) {
+			if (!p->m_stats.load(std::memory_order_relaxed)) p->m_stats.store(new (std::nothrow) LockProfile::Stats {}, std::memory_order_release);
+		}
+	}
+	s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::vector<LockProfiler::Report> LockProfiler::getReport() {
+	std::vector<Report> reports;
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	for (LockProfile* p = reg.head; p; p = p->m_next) {
+		Report report {};
+		report.name = p->m_name;
+		if (LockProfile::Stats* stats = p->m_stats.load(std::memory_order_acquire)) {
+			std::lock_guard<std::mutex> statsLock(p->m_statsMutex);
+			report.acquisitions = stats->acquisitions;
+			report.contended = stats->contended;
+			report.maxWaitUs = stats->maxWaitUs;
+			report.maxHoldUs = stats->maxHoldUs;
+			report.totalWaitUs = stats->totalWaitUs;
+			report.totalHoldUs = stats->totalHoldUs;
+			report.otherSites = stats->otherSites;
+			std::memcpy(report.waitHistogram, stats->waitHistogram, sizeof(report.waitHistogram));
+			std::memcpy(report.holdHistogram, stats->holdHistogram, sizeof(report.holdHistogram));
+			report.sites.assign(stats->sites, stats->sites + stats->siteCount);
+		}
+		std::sort(report.sites.begin(), report.sites.end(), [](const Site& a, const Site& b) { return a.totalHoldUs > b.totalHoldUs; });
+		reports.push_back(std::move(report));
+	}
+	// The list is built by prepending
+	std::reverse(reports.begin(), reports.end());
+	return reports;
+}
+
+void LockProfiler::reset() {
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	for (LockProfile* p = reg.head; p; p = p->m_next) {
+		if (LockProfile::Stats* stats = p->m_stats.load(std::memory_order_acquire)) {
+			std::lock_guard<std::mutex> statsLock(p->m_statsMutex);
+			*stats = LockProfile::Stats {};
+		}
+	}
+}
+
+size_t LockProfiler::bucketOf(uint32_t us) {
+	if (us == 0) return 0;
+	return std::min<size_t>(32 - __builtin_clz(us), HISTOGRAM_BUCKETS - 1);
+}
+
+uint32_t LockProfiler::bucketFloorUs(size_t bucket) {
+	return bucket == 0 ? 0 : 1u << (bucket - 1);
+}
+
+// ============================================================
+// Per-lock profile
+// ============================================================
+
+LockProfile::LockProfile(const char* name) : m_name(name) {
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	if (LockProfiler::isEnabled()) m_stats.store(new (std::nothrow) Stats {}, std::memory_order_relaxed);
+	m_next = reg.head;
+	reg.head = this;
+}
+
+LockProfile::~LockProfile() {
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	for (LockProfile** p = &reg.head; *p; p = &(*p)->m_next) {
+		if (*p == this) {
+			*p = m_next;
+			break;
+		}
+	}
+	delete m_stats.load(std::memory_order_relaxed);
+}
+
+int64_t LockProfile::now() {
+	return esp_timer_get_time();
+}
+
+void LockProfile::begin(const LockSite& site, int64_t waitUs) {
+	m_tracking = m_stats.load(std::memory_order_acquire) != nullptr;
+	if (!m_tracking) return;
+	m_site = site;
+	m_waitUs = static_cast<uint32_t>(std::min<int64_t>(waitUs, UINT32_MAX));
+	m_holdStartUs = now();
+}
+
+void LockProfile::end(Hold& hold) {
+	hold.site = m_site;
+	hold.waitUs = m_waitUs;
+	hold.holdUs = static_cast<uint32_t>(std::min<int64_t>(now() - m_holdStartUs, UINT32_MAX));
+	m_tracking = false;
+}
+
+void LockProfile::record(const Hold& hold) {
+	Stats* stats = m_stats.load(std::memory_order_acquire);
+	if (!stats) return;
+
+	LockSite site = hold.site;
+	// Xtensa return addresses carry the call window size in the top bits
+	if (site.pc) site.pc = reinterpret_cast<const void*>(static_cast<uintptr_t>(esp_cpu_process_stack_pc(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(site.pc)))));
+
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+	stats->acquisitions++;
+	if (hold.waitUs > 0) stats->contended++;
+	stats->totalWaitUs += hold.waitUs;
+	stats->totalHoldUs += hold.holdUs;
+	stats->maxWaitUs = std::max(stats->maxWaitUs, hold.waitUs);
+	stats->maxHoldUs = std::max(stats->maxHoldUs, hold.holdUs);
+	stats->waitHistogram[LockProfiler::bucketOf(hold.waitUs)]++;
+	stats->holdHistogram[LockProfiler::bucketOf(hold.holdUs)]++;
+
+	LockProfiler::Site* entry = nullptr;
+	for (size_t i = 0; i < stats->siteCount; i++) {
+		if (stats->sites[i].site == site) {
+			entry = &stats->sites[i];
+			break;
+		}
+	}
+	if (!entry) {
+		if (stats->siteCount >= LockProfiler::MAX_SITES) {
+			stats->otherSites++;
+			return;
+		}
+		entry = &stats->sites[stats->siteCount++];
+		entry->site = site;
+	}
+	entry->count++;
+	entry->totalHoldUs += hold.holdUs;
+	entry->totalWaitUs += hold.waitUs;
+	entry->maxHoldUs = std::max(entry->maxHoldUs, hold.holdUs);
+	strncpy(entry->task, pcTaskGetName(nullptr), sizeof(entry->task) - 1);
+	entry->task[sizeof(entry->task) - 1] = '\0';
+}
+
+} // namespace flx::core
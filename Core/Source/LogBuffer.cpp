@@ -0,0 +1,599 @@
+#include "freertos/FreeRTOS.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <flx/core/LogBuffer.hpp>
+#include <flx/core/Logger.hpp>
+#include <mutex>
+#include <new>
+
+namespace flx::core {
+
+namespace {
+
+constexpr size_t RING_MASK = LogBuffer::RING_CAPACITY - 1;
+static_assert((LogBuffer::RING_CAPACITY & RING_MASK) == 0, "RING_CAPACITY must be a power of two");
+
+constexpr size_t CORE_COUNT = std::min<size_t>(portNUM_PROCESSORS, LogBuffer::MAX_CORES);
+
+// ============================================================
+// Format specifier parsing (shared by capture and drain)
+// ============================================================
+
+enum class Length : uint8_t { None, Char, Short, Long, LongLong, IntMax, Size, PtrDiff, LongDouble };
+
+enum class ArgKind : uint8_t { Int, Long, LongLong, IntMax, Size, PtrDiff, Double, String, Pointer, Unsupported };
+
+struct Spec {
+	const char* begin; // '%'
+	const char* end; // One past the conversion character
+	bool starWidth;
+	bool starPrecision;
+	int precision; // Literal precision, -1 if none
+	ArgKind kind;
+};
+
+/**
+ * Parse the specifier starting at @p p (which points at '%').
+ * Callers handle "%%" themselves.
+ */
+Spec parseSpec(const char* p) {
+	Spec spec {p, p, false, false, -1, ArgKind::Unsupported};
+	++p;
+	while (*p && std::strchr("-+ #0", *p)) ++p;
+	if (*p == '*') {
+		spec.starWidth = true;
+		++p;
+	} else {
+		while (*p >= '0' && *p <= '9') ++p;
+	}
+	if (*p == '.') {
+		++p;
+		if (*p == '*') {
+			spec.starPrecision = true;
+			++p;
+		} else {
+			spec.precision = 0;
+			while (*p >= '0' && *p <= '9') spec.precision = spec.precision * 10 + (*p++ - '0');
+		}
+	}
+
+	Length length = Length::None;
+	switch (*p) {
+		case 'h':
+			++p;
+			length = (*p == 'h') ? (++p, Length::Char) : Length::Short;
+			break;
+		case 'l':
+			++p;
+			length = (*p == 'l') ? (++p, Length::LongLong) : Length::Long;
+			break;
+		case 'j':
+			++p;
+			length = Length::IntMax;
+			break;
+		case 'z':
+			++p;
+			length = Length::Size;
+			break;
+		case 't':
+			++p;
+			length = Length::PtrDiff;
+			break;
+		case 'L':
+			++p;
+			length = Length::LongDouble;
+			break;
+		default:
+			break;
+	}
+
+	char conv = *p;
+	if (conv) ++p;
+	spec.end = p;
+
+	switch (conv) {
+		case 'd':
+		case 'i':
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X':
+			switch (length) {
+				case Length::Long: spec.kind = ArgKind::Long; break;
+				case Length::LongLong: spec.kind = ArgKind::LongLong; break;
+				case Length::IntMax: spec.kind = ArgKind::IntMax; break;
+				case Length::Size: spec.kind = ArgKind::Size; break;
+				case Length::PtrDiff: spec.kind = ArgKind::PtrDiff; break;
+				case Length::LongDouble: break;
+				default: spec.kind = ArgKind::Int; break;
+			}
+			break;
+		case 'c':
+			if (length == Length::None) spec.kind = ArgKind::Int;
+			break;
+		case 'f':
+		case 'F':
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			if (length != Length::LongDouble) spec.kind = ArgKind::Double;
+			break;
+		case 's':
+			if (length == Length::None) spec.kind = ArgKind::String;
+			break;
+		case 'p':
+			spec.kind = ArgKind::Pointer;
+			break;
+		default:
+			break; // %n, wide characters, long double: format synchronously
+	}
+	return spec;
+}
+
+// ============================================================
+// Argument encoding
+// ============================================================
+
+class ArgWriter {
+public:
+
+	explicit ArgWriter(LogBuffer::Record& record) : m_record(record) {}
+
+	template<typename T>
+	void put(T value) {
+		if (m_full || m_record.argLength + sizeof(T) > LogBuffer::ARG_CAPACITY) {
+			m_full = true;
+			return;
+		}
+		std::memcpy(m_record.args + m_record.argLength, &value, sizeof(T));
+		m_record.argLength += sizeof(T);
+	}
+
+	/** @p maxLen is the conversion's precision; the string need not be terminated within it */
+	void putString(const char* str, size_t maxLen) {
+		if (!str) str = "(null)";
+		size_t room = LogBuffer::ARG_CAPACITY - m_record.argLength;
+		if (m_full || room < 2) {
+			m_full = true;
+			return;
+		}
+		size_t len = strnlen(str, std::min({LogBuffer::MAX_STRING_ARG, room - 1, maxLen}));
+		m_record.args[m_record.argLength] = static_cast<uint8_t>(len);
+		std::memcpy(m_record.args + m_record.argLength + 1, str, len);
+		m_record.argLength += static_cast<uint8_t>(len + 1);
+	}
+
+	bool full() const { return m_full; }
+
+private:
+
+	LogBuffer::Record& m_record;
+	bool m_full = false;
+};
+
+class ArgReader {
+public:
+
+	explicit ArgReader(const LogBuffer::Record& record) : m_record(record) {}
+
+	template<typename T>
+	bool get(T& out) {
+		if (m_offset + sizeof(T) > m_record.argLength) return false;
+		std::memcpy(&out, m_record.args + m_offset, sizeof(T));
+		m_offset += sizeof(T);
+		return true;
+	}
+
+	bool getString(char* out, size_t size) {
+		if (m_offset >= m_record.argLength) return false;
+		size_t len = m_record.args[m_offset];
+		if (m_offset + 1 + len > m_record.argLength) return false;
+		len = std::min(len, size - 1);
+		std::memcpy(out, m_record.args + m_offset + 1, len);
+		out[len] = '\0';
+		m_offset += 1 + m_record.args[m_offset];
+		return true;
+	}
+
+private:
+
+	const LogBuffer::Record& m_record;
+	size_t m_offset = 0;
+};
+
+/**
+ * Pull every argument named by @p fmt off @p args into @p record.
+ * @return false if the format uses a conversion that cannot be deferred
+ */
+bool encodeArgs(LogBuffer::Record& record, const char* fmt, va_list args) {
+	ArgWriter writer(record);
+	for (const char* p = fmt; *p; ++p) {
+		if (*p != '%') continue;
+		if (p[1] == '%') {
+			++p;
+			continue;
+		}
+		Spec spec = parseSpec(p);
+		if (spec.kind == ArgKind::Unsupported) return false;
+		p = spec.end - 1;
+
+		// va_arg must run for every argument even once the record is full
+		if (spec.starWidth) writer.put(va_arg(args, int));
+		int precision = spec.precision;
+		if (spec.starPrecision) {
+			precision = va_arg(args, int);
+			writer.put(precision);
+		}
+		switch (spec.kind) {
+			case ArgKind::Int: writer.put(va_arg(args, int)); break;
+			case ArgKind::Long: writer.put(va_arg(args, long)); break;
+			case ArgKind::LongLong: writer.put(va_arg(args, long long)); break;
+			case ArgKind::IntMax: writer.put(va_arg(args, intmax_t)); break;
+			case ArgKind::Size: writer.put(va_arg(args, size_t)); break;
+			case ArgKind::PtrDiff: writer.put(va_arg(args, ptrdiff_t)); break;
+			case ArgKind::Double: writer.put(va_arg(args, double)); break;
+			case ArgKind::String: writer.putString(va_arg(args, const char*), precision >= 0 ? static_cast<size_t>(precision) : SIZE_MAX); break;
+			case ArgKind::Pointer: writer.put(va_arg(args, void*)); break;
+			case ArgKind::Unsupported: return false;
+		}
+	}
+	record.truncated = writer.full();
+	return true;
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+
+template<typename T>
+int formatOne(char* out, size_t size, const char* spec, const int* stars, int starCount, T value) {
+	switch (starCount) {
+		case 0: return std::snprintf(out, size, spec, value);
+		case 1: return std::snprintf(out, size, spec, stars[0], value);
+		default: return std::snprintf(out, size, spec, stars[0], stars[1], value);
+	}
+}
+
+#pragma GCC diagnostic pop
+
+// ============================================================
+// Per-core ring (Vyukov bounded MPMC)
+// ============================================================
+
+/**
+ * Producers claim a cell with a CAS on the enqueue position and publish it
+ * through the cell's sequence number. The consumer side is serialised by
+ * the drain mutex, which lets drain() peek at the head of each ring to
+ * merge cores in timestamp order.
+ */
+class RecordRing {
+public:
+
+	struct Cell {
+		std::atomic<uint32_t> sequence;
+		LogBuffer::Record record;
+	};
+
+	bool init() {
+		m_cells = new (std::nothrow) Cell[LogBuffer::RING_CAPACITY];
+		if (!m_cells) return false;
+		for (uint32_t i = 0; i < LogBuffer::RING_CAPACITY; i++) {
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		return true;
+	}
+
+	bool push(const LogBuffer::Record& record) {
+		Cell* cell;
+		uint32_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			cell = &m_cells[pos & RING_MASK];
+			uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+			int32_t diff = static_cast<int32_t>(seq - pos);
+			if (diff == 0) {
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+			} else if (diff < 0) {
+				return false; // Full
+			} else {
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		// Copy only the used part of the argument area
+		std::memcpy(&cell->record, &record, offsetof(LogBuffer::Record, args) + record.argLength);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	const LogBuffer::Record* front() const {
+		uint32_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+		const Cell& cell = m_cells[pos & RING_MASK];
+		if (cell.sequence.load(std::memory_order_acquire) != pos + 1) return nullptr;
+		return &cell.record;
+	}
+
+	void pop() {
+		uint32_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+		m_cells[pos & RING_MASK].sequence.store(pos + LogBuffer::RING_CAPACITY, std::memory_order_release);
+		m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+	}
+
+	size_t size() const {
+		return m_enqueuePos.load(std::memory_order_relaxed) - m_dequeuePos.load(std::memory_order_relaxed);
+	}
+
+private:
+
+	Cell* m_cells = nullptr;
+	std::atomic<uint32_t> m_enqueuePos {0};
+	std::atomic<uint32_t> m_dequeuePos {0};
+};
+
+struct State {
+	RecordRing rings[CORE_COUNT];
+	std::atomic<uint32_t> captured[CORE_COUNT] {};
+	std::atomic<uint32_t> dropped[CORE_COUNT] {};
+	std::atomic<uint32_t> truncated {0};
+	std::atomic<uint32_t> fallback {0};
+	std::atomic<uint32_t> drained {0};
+	std::atomic<uint32_t> highWater {0};
+	std::mutex drainMutex; // Serialises consumers and first-time allocation
+};
+
+std::atomic<State*> s_state {nullptr};
+
+} // namespace
+
+// ============================================================
+// Capture
+// ============================================================
+
+void LogBuffer::setDeferred(bool enabled) {
+	if (enabled && !s_state.load(std::memory_order_acquire)) {
+		static std::mutex initMutex;
+		std::lock_guard<std::mutex> lock(initMutex);
+		if (!s_state.load(std::memory_order_relaxed)) {
+			auto* state = new (std::nothrow) State();
+			if (!state) return;
+			for (auto& ring: state->rings) {
+				if (!ring.init()) return; // Leak is fine: allocation failure at boot is terminal anyway
+			}
+			s_state.store(state, std::memory_order_release);
+		}
+	}
+	s_deferred.store(enabled, std::memory_order_relaxed);
+}
+
+bool LogBuffer::capture(esp_log_level_t level, std::string_view tag, const char* fmt, va_list args) {
+	State* state = s_state.load(std::memory_order_acquire);
+	if (!state) return false;
+
+	Record record;
+	record.fmt = fmt;
+	record.timestamp = esp_log_timestamp();
+	record.level = static_cast<uint8_t>(level);
+	record.tagLength = static_cast<uint8_t>(std::min(tag.size(), TAG_CAPACITY));
+	record.argLength = 0;
+	std::memcpy(record.tag, tag.data(), record.tagLength);
+
+	va_list copy;
+	va_copy(copy, args);
+	bool ok = encodeArgs(record, fmt, copy);
+	va_end(copy);
+	if (!ok) {
+		state->fallback.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	if (record.truncated) state->truncated.fetch_add(1, std::memory_order_relaxed);
+
+	// The task may migrate after this read; the ring is multi-producer so that is harmless
+	size_t core = static_cast<size_t>(xPortGetCoreID()) % CORE_COUNT;
+	RecordRing& ring = state->rings[core];
+	if (!ring.push(record)) {
+		state->dropped[core].fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	state->captured[core].fetch_add(1, std::memory_order_relaxed);
+
+	uint32_t depth = static_cast<uint32_t>(ring.size());
+	uint32_t high = state->highWater.load(std::memory_order_relaxed);
+	while (depth > high && !state->highWater.compare_exchange_weak(high, depth, std::memory_order_relaxed)) {}
+	return true;
+}
+
+// ============================================================
+// Drain
+// ============================================================
+
+size_t LogBuffer::format(const Record& record, char* out, size_t size) {
+	if (size == 0) return 0;
+	ArgReader reader(record);
+	size_t pos = 0;
+	out[0] = '\0';
+
+	auto append = [&](int written) {
+		if (written > 0) pos = std::min(pos + static_cast<size_t>(written), size - 1);
+	};
+
+	for (const char* p = record.fmt; *p && pos < size - 1;) {
+		if (*p != '%') {
+			const char* next = std::strchr(p, '%');
+			size_t len = next ? static_cast<size_t>(next - p) : std::strlen(p);
+			len = std::min(len, size - 1 - pos);
+			std::memcpy(out + pos, p, len);
+			pos += len;
+			out[pos] = '\0';
+			p += len;
+			continue;
+		}
+		if (p[1] == '%') {
+			out[pos++] = '%';
+			out[pos] = '\0';
+			p += 2;
+			continue;
+		}
+
+		Spec spec = parseSpec(p);
+		char specBuf[32];
+		size_t specLen = std::min(static_cast<size_t>(spec.end - spec.begin), sizeof(specBuf) - 1);
+		std::memcpy(specBuf, spec.begin, specLen);
+		specBuf[specLen] = '\0';
+		p = spec.end;
+
+		int stars[2] = {0, 0};
+		int starCount = 0;
+		bool ok = true;
+		if (spec.starWidth) ok = ok && reader.get(stars[starCount++]);
+		if (spec.starPrecision) ok = ok && reader.get(stars[starCount++]);
+
+		char* dst = out + pos;
+		size_t room = size - pos;
+		switch (spec.kind) {
+			case ArgKind::Int: {
+				int v;
+				if ((ok = ok && reader.get(v))) append(formatOne(dst, room, specBuf, stars, starCount, v));
+				break;
+			}
+			case ArgKind::Long: {
+				long v;
+				if ((ok = ok && reader.get(v))) append(formatOne(dst, room, specBuf, stars, starCount, v));
+				break;
+			}
+			case ArgKind::LongLong: {
+				long long v;
+				if ((ok = ok && reader.get(v))) append(formatOne(dst, room, specBuf, stars, starCount, v));
+				break;
+			}
+			case ArgKind::IntMax: {
+				intmax_t v;
+				if ((ok = ok && reader.get(v))) append(formatOne(dst, room, specBuf, stars, starCount, v));
+				break;
+			}
+			case ArgKind::Size: {
+				size_t v;
+				if ((ok = ok && reader.get(v))) append(formatOne(dst, room, specBuf, stars, starCount, v));
+				break;
+			}
+			case ArgKind::PtrDiff: {
+				ptrdiff_t v;
+				if ((ok = ok && reader.get(v))) append(formatOne(dst, room, specBuf, stars, starCount, v));
+				break;
+			}
+			case ArgKind::Double: {
+				double v;
+				if ((ok = ok && reader.get(v))) append(formatOne(dst, room, specBuf, stars, starCount, v));
+				break;
+			}
+			case ArgKind::String: {
+				char str[MAX_STRING_ARG + 1];
+				if ((ok = ok && reader.getString(str, sizeof(str)))) append(formatOne(dst, room, specBuf, stars, starCount, static_cast<const char*>(str)));
+				break;
+			}
+			case ArgKind::Pointer: {
+				void* v;
+				if ((ok = ok && reader.get(v))) append(formatOne(dst, room, specBuf, stars, starCount, v));
+				break;
+			}
+			case ArgKind::Unsupported:
+				ok = false;
+				break;
+		}
+
+		if (!ok) {
+			// Arguments were cut at capture time
+			append(std::snprintf(out + pos, size - pos, "<...>"));
+			break;
+		}
+	}
+	return pos;
+}
+
+size_t LogBuffer::drain(size_t maxRecords) {
+	State* state = s_state.load(std::memory_order_acquire);
+	if (!state) return 0;
+
+	std::lock_guard<std::mutex> lock(state->drainMutex);
+	size_t count = 0;
+	char line[LogWriter::LINE_CAPACITY];
+
+	while (count < maxRecords) {
+		// Oldest head across cores first, so interleaved output stays in order
+		RecordRing* oldest = nullptr;
+		const Record* record = nullptr;
+		for (auto& ring: state->rings) {
+			const Record* head = ring.front();
+			if (head && (!record || static_cast<int32_t>(head->timestamp - record->timestamp) < 0)) {
+				record = head;
+				oldest = &ring;
+			}
+		}
+		if (!record) break;
+
+		// Copy what emit() needs, then release the cell before the slow UART write
+		char tagBuf[TAG_CAPACITY];
+		std::memcpy(tagBuf, record->tag, record->tagLength);
+		std::string_view tag(tagBuf, record->tagLength);
+		auto level = static_cast<esp_log_level_t>(record->level);
+		int pos = LogWriter::formatPrefix(line, sizeof(line), level, record->timestamp, tag);
+		bool fits = pos >= 0 && pos < static_cast<int>(sizeof(line) - LogWriter::RESET_RESERVE);
+		if (fits) {
+			format(*record, line + pos, sizeof(line) - static_cast<size_t>(pos) - LogWriter::RESET_RESERVE);
+		}
+		oldest->pop();
+		if (fits) {
+			LogWriter::emit(level, tag, line);
+		}
+		count++;
+	}
+
+	if (count) state->drained.fetch_add(static_cast<uint32_t>(count), std::memory_order_relaxed);
+	return count;
+}
+
+// ============================================================
+// Statistics
+// ============================================================
+
+size_t LogBuffer::pending() {
+	State* state = s_state.load(std::memory_order_acquire);
+	if (!state) return 0;
+	size_t total = 0;
+	for (auto& ring: state->rings) {
+		total += ring.size();
+	}
+	return total;
+}
+
+LogBuffer::Stats LogBuffer::getStats() {
+	Stats stats {};
+	State* state = s_state.load(std::memory_order_acquire);
+	if (!state) return stats;
+	for (size_t i = 0; i < CORE_COUNT; i++) {
+		stats.captured[i] = state->captured[i].load(std::memory_order_relaxed);
+		stats.dropped[i] = state->dropped[i].load(std::memory_order_relaxed);
+	}
+	stats.truncated = state->truncated.load(std::memory_order_relaxed);
+	stats.fallback = state->fallback.load(std::memory_order_relaxed);
+	stats.drained = state->drained.load(std::memory_order_relaxed);
+	stats.highWater = state->highWater.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void LogBuffer::resetStats() {
+	State* state = s_state.load(std::memory_order_acquire);
+	if (!state) return;
+	for (size_t i = 0; i < CORE_COUNT; i++) {
+		state->captured[i].store(0, std::memory_order_relaxed);
+		state->dropped[i].store(0, std::memory_order_relaxed);
+	}
+	state->truncated.store(0, std::memory_order_relaxed);
+	state->fallback.store(0, std::memory_order_relaxed);
+	state->drained.store(0, std::memory_order_relaxed);
+	state->highWater.store(0, std::memory_order_relaxed);
+}
+
+} // namespace flx::core
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cstring>
+#include <flx/core/LogLevels.hpp>
+#include <mutex>
+
+namespace flx {
+
+namespace {
+std::mutex s_writeMutex; // Serialises writers; readers never lock
+} // namespace
+
+esp_log_level_t LogLevels::lookup(std::string_view tag, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		const Slot& slot = s_slots[i];
+		if (slot.length == tag.size() && std::memcmp(slot.tag, tag.data(), tag.size()) == 0) {
+			return slot.level.load(std::memory_order_relaxed);
+		}
+	}
+	return s_default.load(std::memory_order_relaxed);
+}
+
+void LogLevels::refreshMaxLevel() {
+	esp_log_level_t maxLevel = s_default.load(std::memory_order_relaxed);
+	size_t count = s_count.load(std::memory_order_relaxed);
+	for (size_t i = 0; i < count; i++) {
+		maxLevel = std::max(maxLevel, s_slots[i].level.load(std::memory_order_relaxed));
+	}
+	s_maxLevel.store(maxLevel, std::memory_order_relaxed);
+}
+
+void LogLevels::setDefault(esp_log_level_t level) {
+	std::lock_guard<std::mutex> lock(s_writeMutex);
+	s_default.store(level, std::memory_order_relaxed);
+	// Like esp_log_level_set("*"), resetting the default overrides every tag
+	size_t count = s_count.load(std::memory_order_relaxed);
+	for (size_t i = 0; i < count; i++) {
+		s_slots[i].level.store(level, std::memory_order_relaxed);
+	}
+	refreshMaxLevel();
+}
+
+bool LogLevels::set(std::string_view tag, esp_log_level_t level) {
+	if (tag.empty() || tag.size() >= TAG_CAPACITY) return false;
+
+	std::lock_guard<std::mutex> lock(s_writeMutex);
+	size_t count = s_count.load(std::memory_order_relaxed);
+	for (size_t i = 0; i < count; i++) {
+		Slot& slot = s_slots[i];
+		if (slot.length == tag.size() && std::memcmp(slot.tag, tag.data(), tag.size()) == 0) {
+			slot.level.store(level, std::memory_order_relaxed);
+			refreshMaxLevel();
+			return true;
+		}
+	}
+	if (count == MAX_OVERRIDES) return false;
+
+	// Fill the slot completely before publishing it through the count
+	Slot& slot = s_slots[count];
+	std::memcpy(slot.tag, tag.data(), tag.size());
+	slot.tag[tag.size()] = '\0';
+	slot.length = static_cast<uint8_t>(tag.size());
+	slot.level.store(level, std::memory_order_relaxed);
+	s_count.store(count + 1, std::memory_order_release);
+	refreshMaxLevel();
+	return true;
+}
+
+esp_log_level_t LogLevels::get(std::string_view tag) {
+	return lookup(tag, s_count.load(std::memory_order_acquire));
+}
+
+size_t LogLevels::list(Override* out, size_t capacity) {
+	std::lock_guard<std::mutex> lock(s_writeMutex);
+	size_t count = std::min(s_count.load(std::memory_order_relaxed), capacity);
+	for (size_t i = 0; i < count; i++) {
+		std::memcpy(out[i].tag, s_slots[i].tag, TAG_CAPACITY);
+		out[i].level = s_slots[i].level.load(std::memory_order_relaxed);
+	}
+	return count;
+}
+
+} // namespace flx
@@ -0,0 +1,270 @@
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include <algorithm>
+#include <cstring>
+#include <flx/core/Trace.hpp>
+#include <mutex>
+#include <new>
+
+namespace flx::core {
+
+namespace {
+
+constexpr size_t RING_MASK = Trace::RING_CAPACITY - 1;
+static_assert((Trace::RING_CAPACITY & RING_MASK) == 0, "RING_CAPACITY must be a power of two");
+
+constexpr size_t CORE_COUNT = std::min<size_t>(portNUM_PROCESSORS, Trace::MAX_CORES);
+
+// ============================================================
+// Per-core ring
+// ============================================================
+
+/**
+ * Producers claim a position with fetch_add and publish the slot through
+ * its sequence number (position + 1, 0 while being written). Positions
+ * keep counting across start() calls; a session only accepts slots at or
+ * after its base position, so clearing never has to touch the slots and
+ * a write still in flight from the previous session is simply ignored.
+ *
+ * Every field is a relaxed atomic so snapshot() can read while tasks keep
+ * recording; it re-checks the sequence to discard torn slots.
+ */
+struct Slot {
+	std::atomic<uint32_t> sequence {0};
+	std::atomic<const char*> name {nullptr};
+	std::atomic<uint32_t> timestamp {0};
+	std::atomic<TaskHandle_t> task {nullptr};
+	std::atomic<char> phase {0};
+};
+
+struct Ring {
+	Slot* slots = nullptr;
+	std::atomic<uint32_t> head {0};
+	std::atomic<uint32_t> base {0};
+	std::atomic<uint32_t> recorded {0};
+	std::atomic<uint32_t> dropped {0};
+};
+
+struct State {
+	Ring rings[CORE_COUNT];
+	std::atomic<Trace::Mode> mode {Trace::Mode::ONESHOT};
+	std::atomic<uint32_t> startTimestamp {0};
+	int64_t startUs = 0; // Guarded by controlMutex
+	std::mutex controlMutex;
+};
+
+std::atomic<State*> s_state {nullptr};
+
+State* acquireState() {
+	if (State* state = s_state.load(std::memory_order_acquire)) return state;
+
+	static std::mutex initMutex;
+	std::lock_guard<std::mutex> lock(initMutex);
+	if (State* state = s_state.load(std::memory_order_relaxed)) return state;
+
+	auto* state = new (std::nothrow) State();
+	if (!state) return nullptr;
+	for (auto& ring: state->rings) {
+		// Traces are read rarely and written often; PSRAM is fine for both
+		void* mem = heap_caps_malloc_prefer(sizeof(Slot) * Trace::RING_CAPACITY, 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+		if (!mem) return nullptr; // Leak is fine: the rings are never freed anyway
+		ring.slots = new (mem) Slot[Trace::RING_CAPACITY];
+	}
+	s_state.store(state, std::memory_order_release);
+	return state;
+}
+
+void writeJsonString(FILE* out, const char* str) {
+	fputc('"', out);
+	for (const char* p = str ? str : "?"; *p; ++p) {
+		if (*p == '"' || *p == '\\') {
+			fputc('\\', out);
+			fputc(*p, out);
+		} else if (static_cast<unsigned char>(*p) < 0x20) {
+			fprintf(out, "\\u%04x", static_cast<unsigned>(*p));
+		} else {
+			fputc(*p, out);
+		}
+	}
+	fputc('"', out);
+}
+
+} // namespace
+
+// ============================================================
+// Recording
+// ============================================================
+
+bool Trace::start(Mode mode) {
+	State* state = acquireState();
+	if (!state) return false;
+
+	std::lock_guard<std::mutex> lock(state->controlMutex);
+	s_enabled.store(false, std::memory_order_relaxed);
+	for (auto& ring: state->rings) {
+		ring.base.store(ring.head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		ring.recorded.store(0, std::memory_order_relaxed);
+		ring.dropped.store(0, std::memory_order_relaxed);
+	}
+	int64_t const now = esp_timer_get_time();
+	state->mode.store(mode, std::memory_order_relaxed);
+	state->startUs = now;
+	state->startTimestamp.store(static_cast<uint32_t>(now), std::memory_order_relaxed);
+	s_enabled.store(true, std::memory_order_release);
+	return true;
+}
+
+void Trace::stop() {
+	s_enabled.store(false, std::memory_order_relaxed);
+}
+
+void Trace::record(const char* name, char phase) {
+	if (!s_enabled.load(std::memory_order_acquire)) return;
+	State* state = s_state.load(std::memory_order_acquire);
+	if (!state) return;
+
+	// The task may migrate after this read; the ring is multi-producer so that is harmless
+	size_t const core = static_cast<size_t>(xPortGetCoreID()) % CORE_COUNT;
+	Ring& ring = state->rings[core];
+
+	uint32_t const pos = ring.head.fetch_add(1, std::memory_order_relaxed);
+	if (state->mode.load(std::memory_order_relaxed) == Mode::ONESHOT && pos - ring.base.load(std::memory_order_relaxed) >= RING_CAPACITY) {
+		ring.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Slot& slot = ring.slots[pos & RING_MASK];
+	slot.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.timestamp.store(static_cast<uint32_t>(esp_timer_get_time()), std::memory_order_relaxed);
+	slot.task.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+	slot.phase.store(phase, std::memory_order_relaxed);
+	slot.sequence.store(pos + 1, std::memory_order_release);
+	ring.recorded.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================================================
+// Reading
+// ============================================================
+
+std::vector<Trace::Event> Trace::snapshot() {
+	std::vector<Event> events;
+	State* state = s_state.load(std::memory_order_acquire);
+	if (!state) return events;
+
+	struct Entry {
+		Event event;
+		uint32_t pos;
+	};
+	std::vector<Entry> entries;
+	uint32_t const startTimestamp = state->startTimestamp.load(std::memory_order_relaxed);
+	bool const oneshot = state->mode.load(std::memory_order_relaxed) == Mode::ONESHOT;
+	for (size_t core = 0; core < CORE_COUNT; core++) {
+		const Ring& ring = state->rings[core];
+		uint32_t const base = ring.base.load(std::memory_order_relaxed);
+		uint32_t const head = ring.head.load(std::memory_order_relaxed);
+		uint32_t const count = std::min<uint32_t>(head - base, RING_CAPACITY);
+		// One-shot keeps the first events, ring mode the latest
+		uint32_t const first = oneshot ? base : head - count;
+
+		for (uint32_t pos = first; pos != first + count; pos++) {
+			const Slot& slot = ring.slots[pos & RING_MASK];
+			uint32_t const sequence = slot.sequence.load(std::memory_order_acquire);
+			if (sequence != pos + 1) continue; // Still being written, or already overwritten
+			Entry entry {};
+			entry.event.name = slot.name.load(std::memory_order_relaxed);
+			entry.event.timestampUs = slot.timestamp.load(std::memory_order_relaxed) - startTimestamp;
+			entry.event.task = slot.task.load(std::memory_order_relaxed);
+			entry.event.core = static_cast<uint8_t>(core);
+			entry.event.phase = slot.phase.load(std::memory_order_relaxed);
+			entry.pos = pos;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+			entries.push_back(entry);
+		}
+	}
+
+	// A task can be preempted between claiming a slot and stamping it, so
+	// ring order is not time order; each task's own events still are
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+		if (a.event.timestampUs != b.event.timestampUs) return a.event.timestampUs < b.event.timestampUs;
+		if (a.event.core != b.event.core) return a.event.core < b.event.core;
+		return a.pos < b.pos;
+	});
+	events.reserve(entries.size());
+	for (const auto& entry: entries) events.push_back(entry.event);
+	return events;
+}
+
+size_t Trace::writeChromeJson(FILE* out) {
+	std::vector<Event> const events = snapshot();
+
+	// One track per task, named from the tasks still alive
+	struct Track {
+		TaskHandle_t task;
+		int depth;
+	};
+	std::vector<Track> tracks;
+	auto trackOf = [&](TaskHandle_t task) -> size_t {
+		for (size_t i = 0; i < tracks.size(); i++) {
+			if (tracks[i].task == task) return i;
+		}
+		tracks.push_back({task, 0});
+		return tracks.size() - 1;
+	};
+
+	std::vector<TaskStatus_t> tasks(uxTaskGetNumberOfTasks() + 4);
+	tasks.resize(uxTaskGetSystemState(tasks.data(), tasks.size(), nullptr));
+
+	fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"FlxOS\"}}");
+
+	size_t written = 0;
+	for (const auto& event: events) {
+		size_t const track = trackOf(event.task);
+		if (event.phase == 'E') {
+			if (tracks[track].depth == 0) continue; // Its begin was overwritten
+			tracks[track].depth--;
+		} else {
+			tracks[track].depth++;
+		}
+		fprintf(out, ",\n{\"name\":");
+		writeJsonString(out, event.name);
+		fprintf(out, ",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%u,\"args\":{\"core\":%u}}", event.phase, (unsigned long)event.timestampUs, (unsigned)(track + 1), (unsigned)event.core);
+		written++;
+	}
+
+	for (size_t i = 0; i < tracks.size(); i++) {
+		const char* name = nullptr;
+		for (const auto& task: tasks) {
+			if (task.xHandle == tracks[i].task) name = task.pcTaskName;
+		}
+		fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", (unsigned)(i + 1));
+		if (name) {
+			writeJsonString(out, name);
+		} else {
+			fprintf(out, "\"task %p\"", (void*)tracks[i].task);
+		}
+		fprintf(out, "}}");
+	}
+	fprintf(out, "\n]}\n");
+	return written;
+}
+
+Trace::Stats Trace::getStats() {
+	Stats stats {};
+	stats.enabled = isEnabled();
+	State* state = s_state.load(std::memory_order_acquire);
+	if (!state) return stats;
+	std::lock_guard<std::mutex> lock(state->controlMutex);
+	stats.mode = state->mode.load(std::memory_order_relaxed);
+	stats.startUs = state->startUs;
+	for (size_t core = 0; core < CORE_COUNT; core++) {
+		stats.recorded[core] = state->rings[core].recorded.load(std::memory_order_relaxed);
+		stats.dropped[core] = state->rings[core].dropped.load(std::memory_order_relaxed);
+	}
+	return stats;
+}
+
+} // namespace flx::core
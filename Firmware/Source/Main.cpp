@@ -4,7 +4,10 @@
 // Profile must be selected at build time via profile.yaml
 static_assert(flx::config::profile.id[0] != '\0', "No device profile selected.");
 
+#include <flx/core/BootTimeline.hpp>
 #include <flx/core/Logger.hpp>
+#include <flx/core/Trace.hpp>
+#include <flx/kernel/TaskArena.hpp>
 #include <flx/system/SystemManager.hpp>
 
 #if !CONFIG_FLXOS_HEADLESS_MODE
@@ -33,7 +36,13 @@ static_assert(flx::config::profile.id[0] != '\0', "No device profile selected.")
 static constexpr std::string_view TAG = "Main";
 
 extern "C" void app_main(void) {
+	flx::core::BootTimeline::mark("app_main");
 	Log::info(TAG, "Starting FlxOS...");
+	// Reserve static task memory before anything else can fragment the heap
+	flx::kernel::TaskArena::getInstance();
+#if CONFIG_FLXOS_TRACE_BOOT
+	flx::core::Trace::start(flx::core::Trace::Mode::ONESHOT);
+#endif
 	flx::system::SystemManager::getInstance().initHardware();
 	flx::system::SystemManager::getInstance().initServices();
 
@@ -72,7 +81,11 @@ extern "C" void app_main(void) {
 	auto* guiTask = new flx::ui::GuiTask();
 	guiTask->start();
 #else
-	// Headless mode behavior
+	// Headless mode behavior: the boot ends here, without a first frame
+	flx::core::BootTimeline::mark("boot_done");
+	flx::core::BootTimeline::freeze();
+	flx::core::BootTimeline::save();
+
 	Log::info(TAG, "Running in headless mode - GUI disabled");
 	Log::info(TAG, "Services initialized: WiFi, Hotspot, Bluetooth available");
 
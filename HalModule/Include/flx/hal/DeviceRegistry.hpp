@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IDevice.hpp"
+#include <flx/core/LockProfiler.hpp>
 #include <flx/core/Singleton.hpp>
 #include <functional>
 #include <memory>
@@ -146,7 +147,8 @@ private:
 
 	DeviceRegistry() = default;
 
-	mutable std::recursive_mutex m_mutex;
+	using Mutex = flx::core::ProfiledMutex<std::recursive_mutex>;
+	mutable Mutex m_mutex {"device_registry"};
 	std::vector<std::shared_ptr<IDevice>> m_devices;
 	std::vector<std::pair<int, DeviceChangeCallback>> m_observers;
 	int m_nextSubscriptionId = 0;
@@ -67,6 +67,7 @@ public:
 		uint64_t freeBytes = 0; ///< Free space in bytes
 		std::string fsType; ///< "FAT32", "exFAT", etc.
 		uint32_t maxFreqKhz = 0; ///< Maximum clock frequency in kHz
+		uint32_t serial = 0; ///< CID serial number, tells one card from another
 	};
 
 	/**
@@ -78,6 +79,13 @@ public:
 		(void)info;
 		return false;
 	}
+
+	/**
+     * @brief Card identity and capacity only, read from the registers the
+     * driver kept at mount. Leaves freeBytes at 0 and skips the free space
+     * query, which may have to walk the FAT.
+     */
+	virtual bool getCardIdentity(CardInfo& info) const { return getCardInfo(info); }
 };
 
 } // namespace flx::hal::sdcard
@@ -32,6 +32,13 @@ public:
 	std::string getMountPath() const override;
 	std::recursive_mutex& getLock() override;
 	bool getCardInfo(CardInfo& info) const override;
+	bool getCardIdentity(CardInfo& info) const override;
+
+	/**
+	 * @brief Cap the clock negotiated at the next mount (0 = profile maximum).
+	 * Lets a warm boot skip the high-speed switch for a card known not to take it.
+	 */
+	void setMaxFreqKhz(uint32_t khz) { m_maxFreqKhz = khz; }
 
 private:
 
@@ -40,6 +47,7 @@ private:
 	std::recursive_mutex m_spiLock;
 	void* m_card {nullptr};
 	bool m_spiOwner {false};
+	uint32_t m_maxFreqKhz {0};
 
 	void initSpiBus();
 };
@@ -15,7 +15,7 @@ void DeviceRegistry::registerDevice(std::shared_ptr<IDevice> device) {
 	}
 
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+		std::lock_guard<Mutex> lock(m_mutex);
 		// Check for duplicate ID
 		for (const auto& d: m_devices) {
 			if (d->getId() == device->getId()) {
@@ -35,7 +35,7 @@ void DeviceRegistry::deregisterDevice(IDevice::Id id) {
 	std::shared_ptr<IDevice> removed;
 
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+		std::lock_guard<Mutex> lock(m_mutex);
 		auto it = std::find_if(m_devices.begin(), m_devices.end(), [id](const auto& d) { return d->getId() == id; });
 
 		if (it == m_devices.end()) {
@@ -54,7 +54,7 @@ void DeviceRegistry::deregisterDevice(IDevice::Id id) {
 // ── Queries ───────────────────────────────────────────────────────────────
 
 std::shared_ptr<IDevice> DeviceRegistry::findById(IDevice::Id id) const {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	for (const auto& d: m_devices) {
 		if (d->getId() == id) return d;
 	}
@@ -62,7 +62,7 @@ std::shared_ptr<IDevice> DeviceRegistry::findById(IDevice::Id id) const {
 }
 
 std::shared_ptr<IDevice> DeviceRegistry::findByName(std::string_view name) const {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	for (const auto& d: m_devices) {
 		if (d->getName() == name) return d;
 	}
@@ -70,7 +70,7 @@ std::shared_ptr<IDevice> DeviceRegistry::findByName(std::string_view name) const
 }
 
 std::vector<std::shared_ptr<IDevice>> DeviceRegistry::findByType(IDevice::Type type) const {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	std::vector<std::shared_ptr<IDevice>> result;
 	for (const auto& d: m_devices) {
 		if (d->getType() == type) {
@@ -81,12 +81,12 @@ std::vector<std::shared_ptr<IDevice>> DeviceRegistry::findByType(IDevice::Type t
 }
 
 std::vector<std::shared_ptr<IDevice>> DeviceRegistry::getAll() const {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	return m_devices;
 }
 
 bool DeviceRegistry::hasDevice(IDevice::Type type) const {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	for (const auto& d: m_devices) {
 		if (d->getType() == type) return true;
 	}
@@ -94,21 +94,21 @@ bool DeviceRegistry::hasDevice(IDevice::Type type) const {
 }
 
 size_t DeviceRegistry::count() const {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	return m_devices.size();
 }
 
 // ── Observers ─────────────────────────────────────────────────────────────
 
 int DeviceRegistry::subscribe(DeviceChangeCallback callback) {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	int id = m_nextSubscriptionId++;
 	m_observers.emplace_back(id, std::move(callback));
 	return id;
 }
 
 void DeviceRegistry::unsubscribe(int subscriptionId) {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	m_observers.erase(
 		std::remove_if(m_observers.begin(), m_observers.end(), [subscriptionId](const auto& pair) { return pair.first == subscriptionId; }),
 		m_observers.end()
@@ -119,7 +119,7 @@ void DeviceRegistry::notifyObservers(const std::shared_ptr<IDevice>& device, boo
 	// Snapshot observers to avoid holding the lock during callbacks
 	std::vector<std::pair<int, DeviceChangeCallback>> snapshot;
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+		std::lock_guard<Mutex> lock(m_mutex);
 		snapshot = m_observers;
 	}
 	for (auto& [id, cb]: snapshot) {
@@ -130,7 +130,7 @@ void DeviceRegistry::notifyObservers(const std::shared_ptr<IDevice>& device, boo
 // ── Health ────────────────────────────────────────────────────────────────
 
 DeviceRegistry::HealthReport DeviceRegistry::getHealthReport() const {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	HealthReport report;
 	report.totalDevices = m_devices.size();
 
@@ -148,7 +148,7 @@ DeviceRegistry::HealthReport DeviceRegistry::getHealthReport() const {
 // ── Debug ─────────────────────────────────────────────────────────────────
 
 void DeviceRegistry::dumpDevices() const {
-	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	std::lock_guard<Mutex> lock(m_mutex);
 	flx::Log::info(TAG, "=== HAL Device Registry (%zu devices) ===", m_devices.size());
 	for (const auto& d: m_devices) {
 		flx::Log::info(TAG, "  [%2" PRIu32 "] %-10s %-24.*s %s", d->getId(), IDevice::typeToString(d->getType()), (int)d->getName().size(), d->getName().data(), IDevice::stateToString(d->getState()));
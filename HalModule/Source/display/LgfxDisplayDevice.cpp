@@ -1,5 +1,6 @@
 #include <cinttypes>
 #include <flx/core/Logger.hpp>
+#include <flx/core/Trace.hpp>
 #include <flx/hal/display/LgfxDisplayDevice.hpp>
 
 static constexpr const char* TAG = "LgfxDisplay";
@@ -17,6 +18,17 @@ static constexpr const char* TAG = "LgfxDisplay";
 
 namespace flx::hal::display {
 
+#if !CONFIG_FLXOS_HEADLESS_MODE
+// LVGL sends these around each flush_cb call (CPU time of the push, not the DMA tail)
+static void onFlushEvent(lv_event_t* e) {
+	if (lv_event_get_code(e) == LV_EVENT_FLUSH_START) {
+		flx::core::Trace::begin("display.flush");
+	} else {
+		flx::core::Trace::end("display.flush");
+	}
+}
+#endif
+
 LgfxDisplayDevice::LgfxDisplayDevice() {
 	this->setState(State::Uninitialized);
 }
@@ -94,6 +106,10 @@ bool LgfxDisplayDevice::start() {
 		}
 	}
 
+	// Flushes show up as spans when tracing is on
+	lv_display_add_event_cb(m_lvDisplay, onFlushEvent, LV_EVENT_FLUSH_START, nullptr);
+	lv_display_add_event_cb(m_lvDisplay, onFlushEvent, LV_EVENT_FLUSH_FINISH, nullptr);
+
 	// ── 5. Apply initial rotation from profile config ─────────────────────
 	const int rotation = flx::config::display.rotation;
 	lv_display_set_rotation(m_lvDisplay, static_cast<lv_display_rotation_t>(rotation / 90));
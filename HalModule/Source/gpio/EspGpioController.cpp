@@ -1,3 +1,4 @@
+#include "Config.hpp"
 #include <flx/core/Logger.hpp>
 #include <flx/hal/gpio/EspGpioController.hpp>
 
@@ -27,7 +28,7 @@ bool EspGpioController::start() {
 	}
 
 	m_taskRunning = true;
-	if (xTaskCreate(debounceTaskRunner, "gpio_debounce", 3072, this, 10, &m_debounceTaskHandle) != pdPASS) {
+	if (xTaskCreatePinnedToCore(debounceTaskRunner, "gpio_debounce", flx::config::taskStackSize("gpio_debounce", 3072), this, flx::config::taskPriority("gpio_debounce", 10), &m_debounceTaskHandle, flx::config::taskCore("gpio_debounce", tskNO_AFFINITY)) != pdPASS) {
 		flx::Log::error(TAG, "Failed to create debounce task");
 		vQueueDelete(m_debounceQueue);
 		m_debounceQueue = nullptr;
@@ -1,3 +1,4 @@
+#include "Config.hpp"
 #include <cstdlib>
 #include <cstring>
 #include <flx/core/Logger.hpp>
@@ -36,7 +37,7 @@ bool UartGpsDevice::start() {
 	}
 
 	TaskHandle_t handle = nullptr;
-	if (xTaskCreate(rxTaskRunner, "gps_rx_task", 4096, this, 5, &handle) != pdPASS) {
+	if (xTaskCreatePinnedToCore(rxTaskRunner, "gps_rx_task", flx::config::taskStackSize("gps_rx_task", 4096), this, flx::config::taskPriority("gps_rx_task", 5), &handle, flx::config::taskCore("gps_rx_task", tskNO_AFFINITY)) != pdPASS) {
 		flx::Log::error(TAG, "Failed to create GPS RX task");
 		m_isRunning = false;
 		if (m_uart) m_uart->close();
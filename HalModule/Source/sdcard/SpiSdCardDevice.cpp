@@ -115,6 +115,9 @@ bool SpiSdCardDevice::mount(const std::string& mountPath) {
 	sdmmc_host_t host = SDSPI_HOST_DEFAULT();
 	host.slot = host_id;
 	host.max_freq_khz = flx::config::sdcard.maxFreqKhz;
+	if (m_maxFreqKhz != 0 && m_maxFreqKhz < static_cast<uint32_t>(host.max_freq_khz)) {
+		host.max_freq_khz = static_cast<int>(m_maxFreqKhz);
+	}
 
 	sdspi_device_config_t slot_config = SDSPI_DEVICE_CONFIG_DEFAULT();
 	slot_config.gpio_cs = static_cast<gpio_num_t>(flx::config::sdcard.cs);
@@ -185,16 +188,27 @@ bool SpiSdCardDevice::getCardInfo(CardInfo& info) const {
 	flx::core::GuiLockGuard lock;
 	flx::hal::BusManager::ScopedBusLock busLock(flx::config::sdcard.spiHost);
 
+	if (!getCardIdentity(info)) return false;
+
+	esp_vfs_fat_info(m_mountPath.c_str(), &info.totalBytes, &info.freeBytes);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool SpiSdCardDevice::getCardIdentity(CardInfo& info) const {
+#if FLXOS_SD_CARD_ENABLED
 	if (m_mountState != MountState::Mounted || !m_card) return false;
 
 	auto* card = static_cast<sdmmc_card_t*>(m_card);
 	info.totalBytes = static_cast<uint64_t>(card->csd.capacity) * card->csd.sector_size;
 	info.freeBytes = 0;
 	info.maxFreqKhz = card->max_freq_khz;
+	info.serial = static_cast<uint32_t>(card->cid.serial);
 	info.fsType = "FAT";
 
-	esp_vfs_fat_info(m_mountPath.c_str(), &info.totalBytes, &info.freeBytes);
-
 	return true;
 #else
 	return false;
@@ -0,0 +1,425 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <flx/core/Bundle.hpp>
+#include <flx/core/EventBus.hpp>
+#include <flx/kernel/Executor.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace flx::kernel::co {
+
+/**
+ * @brief Single-task scheduler for coroutines
+ *
+ * Every coroutine started with spawn() runs on the one "co_runtime" task, so
+ * any number of waiting activities share its stack; a suspended coroutine
+ * only keeps its heap-allocated frame. Awaitables resume their coroutine by
+ * handing it back to the runtime with schedule(), whichever task the wake-up
+ * came from (EventBus publisher, Observable setter, Executor worker).
+ *
+ * Coroutines must not block the runtime task (vTaskDelay, GuiLock, file I/O);
+ * use co::delay() and co::offload() instead.
+ *
+ * The task is created by the first spawn(), so firmware that never uses a
+ * coroutine does not pay for its stack.
+ */
+class Runtime {
+public:
+
+	static constexpr uint32_t STACK_SIZE = 6 * 1024;
+	static constexpr UBaseType_t PRIORITY = 3;
+
+	struct Stats {
+		uint32_t live; ///< Spawned coroutines that have not finished
+		uint32_t spawned;
+		uint32_t resumes;
+		uint32_t timersFired;
+		size_t timersPending;
+		size_t readyHighWater;
+	};
+
+	static Runtime& getInstance();
+
+	/** Create the runtime task; spawn() calls this, so it rarely needs calling directly */
+	bool start();
+	bool isRunning() const;
+
+	/** Queue @p handle to be resumed on the runtime task (any task, not ISR) */
+	void schedule(std::coroutine_handle<> handle);
+
+	/** Run @p fn on the runtime task once @p delayMs has elapsed */
+	void callAfter(uint32_t delayMs, std::function<void()> fn);
+
+	bool isRuntimeTask() const;
+
+	Stats getStats() const;
+
+	void onSpawn() { m_spawned.fetch_add(1, std::memory_order_relaxed); }
+	void onFinish() { m_finished.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+
+	class RuntimeTask;
+
+	struct Timer {
+		int64_t dueUs;
+		uint32_t seq; // FIFO among timers due at the same time
+		std::function<void()> fn;
+	};
+
+	Runtime();
+	~Runtime();
+	Runtime(const Runtime&) = delete;
+	Runtime& operator=(const Runtime&) = delete;
+
+	void loop(RuntimeTask& task);
+	void wake();
+
+	std::unique_ptr<RuntimeTask> m_task; // Written once, under m_startMutex
+	std::atomic<bool> m_started {false};
+	std::mutex m_startMutex {};
+	mutable std::mutex m_mutex {};
+	std::vector<std::coroutine_handle<>> m_ready {};
+	std::vector<Timer> m_timers {}; // Min-heap on (dueUs, seq)
+	uint32_t m_timerSeq = 0;
+	size_t m_readyHighWater = 0;
+
+	std::atomic<uint32_t> m_spawned {0};
+	std::atomic<uint32_t> m_finished {0};
+	std::atomic<uint32_t> m_resumes {0};
+	std::atomic<uint32_t> m_timersFired {0};
+};
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+struct PromiseBase {
+	std::coroutine_handle<> continuation {};
+	bool detached = false;
+
+	struct FinalAwaiter {
+		bool await_ready() const noexcept { return false; }
+
+		template<typename P>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept {
+			auto& promise = handle.promise();
+			if (promise.continuation) return promise.continuation;
+			if (promise.detached) {
+				handle.destroy();
+				Runtime::getInstance().onFinish();
+			}
+			return std::noop_coroutine();
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	std::suspend_always initial_suspend() const noexcept { return {}; }
+	FinalAwaiter final_suspend() const noexcept { return {}; }
+	void unhandled_exception() const noexcept { std::terminate(); }
+};
+
+template<typename T>
+struct Promise : PromiseBase {
+	std::optional<T> value {};
+
+	Task<T> get_return_object();
+	void return_value(T v) { value.emplace(std::move(v)); }
+};
+
+template<>
+struct Promise<void> : PromiseBase {
+	Task<void> get_return_object();
+	void return_void() const noexcept {}
+};
+
+/** One-shot wake-up shared by a suspended coroutine and its wakers */
+template<typename V>
+struct Signal {
+	std::atomic<bool> fired {false};
+	std::optional<V> value {}; // Empty when woken by the timeout
+	std::coroutine_handle<> handle {};
+
+	void fire(std::optional<V> v) {
+		if (fired.exchange(true, std::memory_order_acq_rel)) return;
+		value = std::move(v);
+		Runtime::getInstance().schedule(handle);
+	}
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine returning @p T
+ *
+ * A Task does nothing until it is awaited (`co_await child()`) or handed to
+ * spawn(). Awaiting transfers control straight into the child and back, so
+ * nested calls cost no extra scheduling round trip.
+ */
+template<typename T>
+class [[nodiscard]] Task {
+public:
+
+	using promise_type = detail::Promise<T>;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	Task() = default;
+	explicit Task(Handle handle) : m_handle(handle) {}
+	Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+	Task& operator=(Task&& other) noexcept {
+		if (this != &other) {
+			if (m_handle) m_handle.destroy();
+			m_handle = std::exchange(other.m_handle, {});
+		}
+		return *this;
+	}
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+	~Task() {
+		if (m_handle) m_handle.destroy();
+	}
+
+	auto operator co_await() && noexcept {
+		struct Awaiter {
+			Handle handle;
+
+			bool await_ready() const noexcept { return !handle || handle.done(); }
+
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+				handle.promise().continuation = caller;
+				return handle;
+			}
+
+			T await_resume() {
+				if constexpr (!std::is_void_v<T>) {
+					return std::move(*handle.promise().value);
+				}
+			}
+		};
+		return Awaiter {m_handle};
+	}
+
+	/** Give up ownership; the frame frees itself when the coroutine finishes */
+	Handle detach() {
+		if (m_handle) m_handle.promise().detached = true;
+		return std::exchange(m_handle, {});
+	}
+
+private:
+
+	Handle m_handle {};
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> Promise<T>::get_return_object() {
+	return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() {
+	return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+/** Start @p task on the runtime; it runs until it finishes, then frees itself */
+inline void spawn(Task<void>&& task) {
+	auto handle = task.detach();
+	if (!handle) return;
+	auto& runtime = Runtime::getInstance();
+	runtime.start();
+	runtime.onSpawn();
+	runtime.schedule(handle);
+}
+
+// ──────── Awaitables ────────
+
+/** `co_await co::delay(ms)` — suspend for at least @p ms */
+inline auto delay(uint32_t ms) {
+	struct Awaiter {
+		uint32_t ms;
+
+		bool await_ready() const noexcept { return ms == 0; }
+		void await_suspend(std::coroutine_handle<> handle) const {
+			Runtime::getInstance().callAfter(ms, [handle]() { handle.resume(); });
+		}
+		void await_resume() const noexcept {}
+	};
+	return Awaiter {ms};
+}
+
+/**
+ * @brief Awaits the next publish of an EventBus topic
+ *
+ * Resumes with the event's Bundle, or with std::nullopt if @p timeoutMs
+ * (when non-zero) passes first. The subscription lives only while waiting.
+ */
+class EventAwaiter {
+public:
+
+	EventAwaiter(flx::core::EventBus::TopicId topic, uint32_t timeoutMs)
+		: m_topic(topic), m_timeoutMs(timeoutMs) {}
+
+	bool await_ready() const noexcept { return false; }
+
+	void await_suspend(std::coroutine_handle<> handle) {
+		m_signal->handle = handle;
+		auto signal = m_signal;
+		m_subscription = flx::core::EventBus::getInstance().subscribe(m_topic, [signal](const std::string& /*event*/, const flx::core::Bundle& data) {
+			signal->fire(data);
+		});
+		if (m_timeoutMs > 0) {
+			Runtime::getInstance().callAfter(m_timeoutMs, [signal]() { signal->fire(std::nullopt); });
+		}
+	}
+
+	std::optional<flx::core::Bundle> await_resume() {
+		flx::core::EventBus::getInstance().unsubscribe(m_subscription);
+		return std::move(m_signal->value);
+	}
+
+private:
+
+	flx::core::EventBus::TopicId m_topic;
+	uint32_t m_timeoutMs;
+	flx::core::EventBus::SubscriptionId m_subscription = 0;
+	std::shared_ptr<detail::Signal<flx::core::Bundle>> m_signal = std::make_shared<detail::Signal<flx::core::Bundle>>();
+};
+
+/** `auto data = co_await co::event("wifi.connected", 10000);` */
+inline EventAwaiter event(const std::string& name, uint32_t timeoutMs = 0) {
+	return {flx::core::EventBus::getInstance().registerTopic(name), timeoutMs};
+}
+
+inline EventAwaiter event(flx::core::EventBus::TopicId topic, uint32_t timeoutMs = 0) {
+	return {topic, timeoutMs};
+}
+
+/**
+ * @brief Awaits the next change notification of an Observable
+ *
+ * Resumes with the new value, or std::nullopt on timeout. Works with any
+ * flx::Observable specialization (subscribe/unsubscribe by id).
+ *
+ * With a predicate, only values it accepts wake the coroutine, and the
+ * current value is checked after subscribing, so a change that lands
+ * between a caller's own check and the wait is not missed.
+ */
+template<typename O>
+class ChangeAwaiter {
+public:
+
+	using Value = std::decay_t<decltype(std::declval<O&>().get())>;
+	using Predicate = std::function<bool(const Value&)>;
+
+	ChangeAwaiter(O& observable, uint32_t timeoutMs, Predicate accept = nullptr)
+		: m_observable(observable), m_timeoutMs(timeoutMs), m_accept(std::move(accept)) {}
+
+	bool await_ready() const noexcept { return false; }
+
+	void await_suspend(std::coroutine_handle<> handle) {
+		m_signal->handle = handle;
+		auto signal = m_signal;
+		m_index = m_observable.subscribe([signal, accept = m_accept](const Value& value) {
+			if (!accept || accept(value)) signal->fire(value);
+		});
+		if (m_accept) {
+			Value const current = m_observable.get();
+			if (m_accept(current)) {
+				signal->fire(current);
+				return;
+			}
+		}
+		if (m_timeoutMs > 0) {
+			Runtime::getInstance().callAfter(m_timeoutMs, [signal]() { signal->fire(std::nullopt); });
+		}
+	}
+
+	std::optional<Value> await_resume() {
+		m_observable.unsubscribe(m_index);
+		return std::move(m_signal->value);
+	}
+
+private:
+
+	O& m_observable;
+	uint32_t m_timeoutMs;
+	Predicate m_accept;
+	size_t m_index = 0;
+	std::shared_ptr<detail::Signal<Value>> m_signal = std::make_shared<detail::Signal<Value>>();
+};
+
+/** `auto v = co_await co::changed(obs, 5000);` */
+template<typename O>
+ChangeAwaiter<O> changed(O& observable, uint32_t timeoutMs = 0) {
+	return {observable, timeoutMs};
+}
+
+/** `auto v = co_await co::until(obs, [](bool on) { return on; }, 5000);` — resumes at once if already true */
+template<typename O, typename P>
+ChangeAwaiter<O> until(O& observable, P&& accept, uint32_t timeoutMs = 0) {
+	return {observable, timeoutMs, std::forward<P>(accept)};
+}
+
+/**
+ * @brief Runs blocking work on the Executor and resumes with its result
+ *
+ * The coroutine is suspended (the runtime keeps serving others) while
+ * @p fn runs on a pool worker; it then resumes on the runtime task.
+ */
+template<typename F>
+class OffloadAwaiter {
+public:
+
+	using Result = std::invoke_result_t<F&>;
+
+	explicit OffloadAwaiter(F fn) : m_fn(std::move(fn)) {}
+
+	bool await_ready() const noexcept { return false; }
+
+	void await_suspend(std::coroutine_handle<> handle) {
+		auto future = flx::kernel::Executor::getInstance().submit(std::move(m_fn));
+		if constexpr (std::is_void_v<Result>) {
+			future.then([handle]() { Runtime::getInstance().schedule(handle); });
+		} else {
+			future.then([this, handle](const Result& value) {
+				m_result.emplace(value);
+				Runtime::getInstance().schedule(handle);
+			});
+		}
+	}
+
+	Result await_resume() {
+		if constexpr (!std::is_void_v<Result>) {
+			return std::move(*m_result);
+		}
+	}
+
+private:
+
+	F m_fn;
+	std::optional<std::conditional_t<std::is_void_v<Result>, bool, Result>> m_result {};
+};
+
+/** `auto bytes = co_await co::offload([] { return readFile(path); });` */
+template<typename F>
+OffloadAwaiter<std::decay_t<F>> offload(F&& fn) {
+	return OffloadAwaiter<std::decay_t<F>>(std::forward<F>(fn));
+}
+
+} // namespace flx::kernel::co
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <flx/kernel/TaskManager.hpp>
+
+namespace flx::kernel {
+
+/**
+ * @brief Drains EventBus::publishAsync() queues on a dedicated task
+ *
+ * Sleeps on a task notification that publishAsync() raises through the
+ * EventBus wakeup hook, then delivers pending events highest priority first.
+ */
+class EventDispatcherTask : public Task {
+public:
+
+	static EventDispatcherTask& getInstance();
+
+protected:
+
+	void run(void* data) override;
+
+private:
+
+	EventDispatcherTask();
+	~EventDispatcherTask() override = default;
+	EventDispatcherTask(const EventDispatcherTask&) = delete;
+	EventDispatcherTask& operator=(const EventDispatcherTask&) = delete;
+};
+
+} // namespace flx::kernel
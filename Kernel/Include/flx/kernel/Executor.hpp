@@ -0,0 +1,255 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace flx::kernel {
+
+/** Where a job or continuation runs */
+enum class RunOn {
+	Pool, ///< Any executor worker
+	Gui ///< The GUI task, via the dispatcher it installs
+};
+
+template<typename T>
+class Future;
+
+namespace detail {
+
+template<typename T>
+struct FutureState {
+	using Value = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+	std::mutex mutex {};
+	std::condition_variable cv {};
+	std::optional<Value> value {};
+	std::function<void()> continuation {};
+
+	void complete(Value v) {
+		std::function<void()> next;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			value.emplace(std::move(v));
+			next = std::move(continuation);
+		}
+		cv.notify_all();
+		if (next) next();
+	}
+};
+
+} // namespace detail
+
+/**
+ * @brief Work-stealing pool for background jobs
+ *
+ * One worker per core, each with its own deque. A worker pops its own newest
+ * job first (cache-warm, LIFO) and, when empty, steals the oldest job from
+ * another worker (FIFO). Jobs posted from outside the pool are spread round
+ * robin; jobs posted from a worker stay on that worker's deque.
+ *
+ * submit() returns a Future whose then() chains continuations on the pool
+ * or, with RunOn::Gui, on the GUI task. The GUI task installs the dispatcher
+ * that performs the hop (setGuiDispatcher); without one, GUI jobs run on the
+ * pool. Before start() (or after stop()) jobs run inline on the caller.
+ *
+ * Only FreeRTOS tasks, task notifications and std primitives are used, so the
+ * pool runs unchanged on the FreeRTOS POSIX port.
+ */
+class Executor {
+public:
+
+	using Job = std::function<void()>;
+	using GuiDispatcher = std::function<void(Job)>;
+
+	static constexpr size_t MAX_WORKERS = portNUM_PROCESSORS;
+	static constexpr uint32_t WORKER_STACK_SIZE = 8 * 1024;
+	static constexpr UBaseType_t WORKER_PRIORITY = 2;
+
+	struct Stats {
+		uint32_t executed[MAX_WORKERS];
+		uint32_t stolen[MAX_WORKERS]; ///< Jobs this worker took from another deque
+		uint32_t inlineRuns; ///< Jobs run on the caller because the pool was not running
+		uint32_t guiHops;
+		size_t pending;
+		size_t highWater; ///< Deepest single deque seen
+	};
+
+	static Executor& getInstance();
+
+	bool start();
+	void stop();
+	bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+	void post(Job job, RunOn where = RunOn::Pool);
+
+	/** Run @p fn on the pool and return a Future for its result */
+	template<typename F>
+	auto submit(F&& fn, RunOn where = RunOn::Pool) -> Future<std::invoke_result_t<std::decay_t<F>&>>;
+
+	void setGuiDispatcher(GuiDispatcher dispatcher);
+
+	Stats getStats() const;
+	void resetStats();
+
+private:
+
+	class Worker;
+
+	struct Queue {
+		mutable std::mutex mutex {};
+		std::deque<Job> jobs {};
+	};
+
+	Executor();
+	~Executor();
+	Executor(const Executor&) = delete;
+	Executor& operator=(const Executor&) = delete;
+
+	void postToPool(Job job);
+	void postToGui(Job job);
+	bool popLocal(size_t index, Job& out);
+	bool steal(size_t thief, Job& out);
+	int currentWorker() const;
+	void wake(size_t index);
+	void workerLoop(Worker& worker, size_t index);
+
+	std::array<Queue, MAX_WORKERS> m_queues {};
+	std::array<std::unique_ptr<Worker>, MAX_WORKERS> m_workers {};
+	std::array<std::atomic<bool>, MAX_WORKERS> m_idle {};
+	std::atomic<bool> m_running {false};
+	std::atomic<size_t> m_nextQueue {0};
+
+	std::mutex m_guiMutex {};
+	GuiDispatcher m_guiDispatcher {};
+
+	std::array<std::atomic<uint32_t>, MAX_WORKERS> m_executed {};
+	std::array<std::atomic<uint32_t>, MAX_WORKERS> m_stolen {};
+	std::atomic<uint32_t> m_inlineRuns {0};
+	std::atomic<uint32_t> m_guiHops {0};
+	std::atomic<size_t> m_highWater {0};
+};
+
+/**
+ * @brief Result of a job submitted to the Executor
+ *
+ * A Future is a cheap shared handle. get() blocks the caller; prefer then()
+ * on the GUI task, which must never wait on a job that itself needs the GUI.
+ * Each Future takes at most one continuation.
+ */
+template<typename T>
+class Future {
+public:
+
+	using State = detail::FutureState<T>;
+
+	Future() = default;
+	explicit Future(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+
+	bool valid() const { return m_state != nullptr; }
+
+	bool isReady() const {
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		return m_state->value.has_value();
+	}
+
+	/** Block until the result is available, or @p timeoutMs elapses */
+	bool waitFor(uint32_t timeoutMs) const {
+		std::unique_lock<std::mutex> lock(m_state->mutex);
+		return m_state->cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return m_state->value.has_value(); });
+	}
+
+	void wait() const {
+		std::unique_lock<std::mutex> lock(m_state->mutex);
+		m_state->cv.wait(lock, [this] { return m_state->value.has_value(); });
+	}
+
+	T get() const {
+		wait();
+		if constexpr (!std::is_void_v<T>) {
+			return *m_state->value;
+		}
+	}
+
+	/**
+	 * Run @p fn with the result once it is ready, on the pool or GUI task.
+	 * @return Future for the value @p fn returns
+	 */
+	template<typename F>
+	auto then(F&& fn, RunOn where = RunOn::Pool) {
+		using R = std::remove_cvref_t<decltype(invokeWith(fn, std::declval<typename State::Value&>()))>;
+		auto next = std::make_shared<detail::FutureState<R>>();
+		auto state = m_state;
+		auto job = [state, next, fn = std::forward<F>(fn)]() mutable {
+			if constexpr (std::is_void_v<R>) {
+				invokeWith(fn, *state->value);
+				next->complete({});
+			} else {
+				next->complete(invokeWith(fn, *state->value));
+			}
+		};
+
+		std::unique_lock<std::mutex> lock(m_state->mutex);
+		if (m_state->value.has_value()) {
+			lock.unlock();
+			Executor::getInstance().post(std::move(job), where);
+		} else {
+			m_state->continuation = [job = std::move(job), where]() mutable {
+				Executor::getInstance().post(std::move(job), where);
+			};
+		}
+		return Future<R>(next);
+	}
+
+private:
+
+	template<typename F, typename V>
+	static decltype(auto) invokeWith(F& fn, V& value) {
+		if constexpr (std::is_void_v<T>) {
+			return fn();
+		} else {
+			return fn(value);
+		}
+	}
+
+	std::shared_ptr<State> m_state {};
+};
+
+/** A Future that already holds @p value (for early-out paths) */
+template<typename T>
+Future<std::decay_t<T>> makeReadyFuture(T&& value) {
+	auto state = std::make_shared<detail::FutureState<std::decay_t<T>>>();
+	state->complete(std::forward<T>(value));
+	return Future<std::decay_t<T>>(state);
+}
+
+template<typename F>
+auto Executor::submit(F&& fn, RunOn where) -> Future<std::invoke_result_t<std::decay_t<F>&>> {
+	using R = std::invoke_result_t<std::decay_t<F>&>;
+	auto state = std::make_shared<detail::FutureState<R>>();
+	auto job = [state, fn = std::forward<F>(fn)]() mutable {
+		if constexpr (std::is_void_v<R>) {
+			fn();
+			state->complete({});
+		} else {
+			state->complete(fn());
+		}
+	};
+	post(std::move(job), where);
+	return Future<R>(state);
+}
+
+} // namespace flx::kernel
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <flx/kernel/TaskManager.hpp>
+
+namespace flx::kernel {
+
+/**
+ * @brief Formats and writes deferred log records (see flx::core::LogBuffer)
+ *
+ * Switches Log into deferred mode when it starts if
+ * CONFIG_FLXOS_DEFERRED_LOGGING is set ('logbuf on' does so at runtime),
+ * then polls the per-core rings at low priority. Producers never wake this task, so capturing a
+ * record costs no more than a ring push.
+ */
+class LogDrainTask : public Task {
+public:
+
+	static LogDrainTask& getInstance();
+
+protected:
+
+	void run(void* data) override;
+
+private:
+
+	LogDrainTask();
+	~LogDrainTask() override = default;
+	LogDrainTask(const LogDrainTask&) = delete;
+	LogDrainTask& operator=(const LogDrainTask&) = delete;
+};
+
+} // namespace flx::kernel
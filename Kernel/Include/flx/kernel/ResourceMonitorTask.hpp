@@ -1,12 +1,37 @@
 #pragma once
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <flx/kernel/TaskManager.hpp>
+#include <vector>
 
 namespace flx::kernel {
+
+/**
+ * @brief Periodic heap and per-task load sampler
+ *
+ * Every sample period (100 ms at the fastest) the monitor records heap
+ * figures plus, for each task, the CPU it used since the previous sample
+ * and its stack high-water mark. Samples go into a fixed ring (PSRAM when
+ * present), so recent history is always available to see which task spiked
+ * around a frame drop.
+ *
+ * The monitor task is the only writer. Readers never block it: each ring
+ * slot and the task directory are guarded by sequence counters, and a
+ * reader that races a write simply copies again.
+ */
 class ResourceMonitorTask : public Task {
 public:
 
+	static constexpr uint32_t MIN_SAMPLE_PERIOD_MS = 100;
+	static constexpr uint32_t DEFAULT_SAMPLE_PERIOD_MS = 10000; // 'tasks rate <ms>' samples faster while chasing a spike
+	static constexpr size_t MAX_TRACKED_TASKS = 40;
+	static constexpr size_t HISTORY_DEPTH_PSRAM = 128;
+	static constexpr size_t HISTORY_DEPTH_INTERNAL = 16;
+
 	static ResourceMonitorTask& getInstance();
 
 	struct Stats {
@@ -16,23 +41,119 @@ public:
 		uint32_t uptimeSeconds;
 	};
 
+	struct TaskLoad {
+		char name[configMAX_TASK_NAME_LEN];
+		TaskHandle_t handle;
+		float cpuPercent; ///< Over the sample interval; 100 = one fully loaded core
+		uint32_t stackHighWater; ///< Bytes never used (saturates at 65535)
+		int core; ///< tskNO_AFFINITY when unpinned
+		UBaseType_t priority;
+	};
+
+	struct Sample {
+		uint32_t number; ///< Monotonic sample counter
+		int64_t timestampUs;
+		uint32_t intervalUs; ///< Time covered by the CPU figures
+		size_t freeHeap;
+		size_t minFreeHeap;
+		size_t freePsram;
+		size_t largestFreeBlock;
+		std::vector<TaskLoad> tasks;
+	};
+
 	Stats getLatestStats() const;
 
+	/** Up to @p maxSamples most recent samples, oldest first (0 = whole ring) */
+	std::vector<Sample> getHistory(size_t maxSamples = 0) const;
+
+	/** Most recent sample; false until the first one is taken */
+	bool getLatestSample(Sample& out) const;
+
+	struct LoadSummary {
+		TaskHandle_t handle;
+		float cpuPercent; ///< In the latest sample
+		float peakPercent; ///< Highest over the samples read
+	};
+
+	/**
+	 * Current and peak CPU of each task in the latest sample, over the last
+	 * @p maxSamples samples (0 = whole ring). Walks the raw ring one slot at
+	 * a time, so unlike getHistory() it allocates only the result.
+	 */
+	std::vector<LoadSummary> getLoadSummary(size_t maxSamples = 0) const;
+
+	void setSamplePeriod(uint32_t periodMs);
+	uint32_t getSamplePeriod() const { return m_samplePeriodMs.load(std::memory_order_relaxed); }
+	size_t getHistoryDepth() const { return m_depth; }
+
 protected:
 
 	void run(void* data) override;
 
 private:
 
+	struct RawTask {
+		uint16_t cpuPermille; // Of one core
+		uint16_t stackFree;
+		uint8_t directory; // Index into m_directory
+		uint8_t priority;
+	};
+
+	struct RawSample {
+		uint32_t number;
+		int64_t timestampUs;
+		uint32_t intervalUs;
+		uint32_t freeHeap;
+		uint32_t minFreeHeap;
+		uint32_t freePsram;
+		uint32_t largestFreeBlock;
+		uint16_t count;
+		RawTask tasks[MAX_TRACKED_TASKS];
+	};
+
+	struct RingSlot {
+		std::atomic<uint32_t> seq {0}; // Odd while the monitor rewrites the slot
+		RawSample data;
+	};
+
+	struct DirectoryEntry {
+		TaskHandle_t handle;
+		char name[configMAX_TASK_NAME_LEN];
+		BaseType_t core;
+		bool used;
+		uint32_t lastRuntime;
+		uint32_t firstSeen; // Sample numbers; an entry is only reused once
+		uint32_t lastSeen; // no retained sample refers to it
+	};
+
 	ResourceMonitorTask();
-	~ResourceMonitorTask() override = default;
+	~ResourceMonitorTask() override;
 	ResourceMonitorTask(const ResourceMonitorTask&) = delete;
 	ResourceMonitorTask& operator=(const ResourceMonitorTask&) = delete;
 
+	void allocateHistory();
+	void takeSample();
+	int findOrAddTask(TaskHandle_t handle, const char* name, BaseType_t core, uint32_t number, bool& added);
+	bool readSlot(uint32_t number, RawSample& out) const;
+	void readDirectory(DirectoryEntry* out) const;
+	Sample expand(const RawSample& raw, const DirectoryEntry* directory) const;
+
 	std::atomic<size_t> m_freeHeap {0};
 	std::atomic<size_t> m_minFreeHeap {0};
 	std::atomic<size_t> m_freePsram {0};
 	std::atomic<uint32_t> m_uptimeSeconds {0};
+
+	std::atomic<uint32_t> m_samplePeriodMs {DEFAULT_SAMPLE_PERIOD_MS};
+	RingSlot* m_ring = nullptr;
+	size_t m_depth = 0;
+	std::atomic<uint32_t> m_written {0}; // Samples published so far
+
+	DirectoryEntry m_directory[MAX_TRACKED_TASKS] {};
+	std::atomic<uint32_t> m_directorySeq {0};
+
+	std::vector<TaskStatus_t> m_status {}; // uxTaskGetSystemState scratch
+	uint32_t m_lastTotalRuntime = 0;
+	int64_t m_lastSampleUs = 0;
 };
 
 } // namespace flx::kernel
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace flx::kernel {
+
+/**
+ * @brief Worst-case stack usage per task name, with right-sizing advice
+ *
+ * FreeRTOS paints every new stack with a fill pattern and reports how much
+ * of it was never overwritten (the high-water mark), so the figure is
+ * already a worst case since the task was created. The profiler keeps the
+ * lowest value seen for each task name across restarts of that task: the
+ * resource monitor feeds it every sample, and Task records a final reading
+ * when it exits or is stopped, so short-lived tasks are covered too.
+ *
+ * After a soak run the recommendation (used bytes plus a safety margin,
+ * rounded up) can be copied into the profile's scheduling section, which
+ * the build applies to the task at construction.
+ */
+class StackProfiler {
+public:
+
+	static constexpr uint32_t DEFAULT_MARGIN_PERCENT = 25;
+	static constexpr uint32_t MIN_HEADROOM_BYTES = 512; // Margin floor for small stacks
+	static constexpr uint32_t ROUND_BYTES = 256;
+	static constexpr size_t MAX_ENTRIES = 64;
+
+	struct Entry {
+		char name[configMAX_TASK_NAME_LEN];
+		uint32_t stackSize; ///< Bytes; 0 when it could not be determined
+		uint32_t minFree; ///< Lowest high-water mark seen, bytes
+		uint32_t maxUsed; ///< Peak bytes used (0 while the size is unknown)
+		uint32_t samples;
+		uint32_t instances; ///< Distinct task handles seen under this name
+		int64_t worstAtUs; ///< When minFree was recorded
+		bool alive; ///< Still seen in the latest sample
+	};
+
+	struct Report {
+		Entry entry;
+		uint32_t recommended; ///< Suggested stack size (0 if the size is unknown)
+	};
+
+	static StackProfiler& getInstance();
+
+	/**
+	 * Record a high-water mark for @p name.
+	 * @param stackSize Allocated bytes, or 0 to keep the size already known
+	 */
+	void record(TaskHandle_t handle, const char* name, uint32_t stackSize, uint32_t freeBytes);
+
+	/** Record one uxTaskGetSystemState() entry, resolving its stack size */
+	void sample(const TaskStatus_t& status);
+
+	/** Start a full pass over all tasks; tasks not sampled in it count as gone */
+	void beginSample();
+
+	std::vector<Report> getReport() const;
+	/** Peak usage plus the safety margin, rounded up to ROUND_BYTES */
+	uint32_t recommend(uint32_t usedBytes) const;
+
+	void setMarginPercent(uint32_t percent) { m_marginPercent.store(percent); }
+	uint32_t getMarginPercent() const { return m_marginPercent.load(); }
+	int64_t getSinceUs() const;
+	void reset();
+
+private:
+
+	struct Slot {
+		Entry entry;
+		TaskHandle_t handle;
+		uint32_t lastSample;
+	};
+
+	StackProfiler();
+	~StackProfiler() = default;
+	StackProfiler(const StackProfiler&) = delete;
+	StackProfiler& operator=(const StackProfiler&) = delete;
+
+	Slot* findLocked(const char* name);
+	Slot* recordLocked(TaskHandle_t handle, const char* name, uint32_t stackSize, uint32_t freeBytes);
+	static uint32_t resolveStackSize(const TaskStatus_t& status);
+
+	mutable std::mutex m_mutex {};
+	std::vector<Slot> m_slots {};
+	uint32_t m_sampleNumber = 0;
+	std::atomic<uint32_t> m_marginPercent {DEFAULT_MARGIN_PERCENT};
+	int64_t m_sinceUs = 0;
+};
+
+} // namespace flx::kernel
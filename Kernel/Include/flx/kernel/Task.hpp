@@ -19,6 +19,14 @@ public:
 		REBOOT_SYSTEM
 	};
 
+	/// Where start() gets the TCB and stack from
+	enum class StackMemory {
+		HEAP, // xTaskCreate on every start
+		INTERNAL, // TaskArena block in internal RAM, kept across restarts
+		PSRAM // TaskArena block with the stack in PSRAM; the task must not
+		// touch flash (NVS, SPIFFS, OTA) while the cache is disabled
+	};
+
 	Task(const std::string& name, uint32_t stackSize, UBaseType_t priority, BaseType_t coreId = tskNO_AFFINITY);
 	virtual ~Task();
 
@@ -63,6 +71,10 @@ public:
 	}
 	uint32_t getStackSize() const { return m_stackSize; }
 
+	/** Takes effect on the next start(); falls back to the heap if the arena is full */
+	void setStackMemory(StackMemory memory) { m_stackMemory = memory; }
+	StackMemory getStackMemory() const { return m_stackMemory; }
+
 	void setRestartPolicy(RestartPolicy policy) { m_restartPolicy.store(policy); }
 	RestartPolicy getRestartPolicy() const { return m_restartPolicy.load(); }
 
@@ -76,7 +88,10 @@ protected:
 
 private:
 
+	static constexpr uint32_t TCB_RELEASE_WAIT_MS = 100;
+
 	static void taskEntry(void* param);
+	TaskHandle_t createStatic();
 	std::string m_name {};
 	uint32_t m_stackSize;
 	UBaseType_t m_priority;
@@ -87,6 +102,9 @@ private:
 	std::atomic<uint64_t> m_lastHeartbeat {0};
 	std::atomic<uint32_t> m_watchdogTimeoutMs {0};
 	std::atomic<RestartPolicy> m_restartPolicy {RestartPolicy::REBOOT_SYSTEM};
+	StackMemory m_stackMemory = StackMemory::HEAP;
+	int m_arenaBlock = -1; // TaskArena block, held until destruction
+	std::atomic<bool> m_runningStatic {false};
 };
 
 } // namespace flx::kernel
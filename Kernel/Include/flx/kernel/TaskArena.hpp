@@ -0,0 +1,119 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace flx::kernel {
+
+/**
+ * @brief Boot-time memory for statically created tasks
+ *
+ * Two regions (internal RAM and PSRAM) are reserved once, before the heap
+ * has had a chance to fragment. A task that opts in gets a block holding
+ * its TCB (always internal) and its stack, keeps it across restarts, and
+ * hands it back when the Task object is destroyed, so restarting a task
+ * never touches the heap.
+ *
+ * FreeRTOS may still reference a TCB after vTaskDelete() until the idle
+ * task cleans it up. Each block therefore stays "live" until the kernel's
+ * thread-local-storage deletion callback reports the TCB released; a
+ * block is only reused, by its owner or anyone else, after that.
+ */
+class TaskArena {
+public:
+
+	enum class Region : uint8_t {
+		INTERNAL,
+		PSRAM
+	};
+
+	static constexpr int INVALID_BLOCK = -1;
+	static constexpr size_t MAX_BLOCKS = 24;
+	/// TLS slot 0 belongs to pthread; needs CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS >= 2
+	static constexpr BaseType_t TLS_INDEX = 1;
+
+	struct Stats {
+		size_t internalSize;
+		size_t internalUsed; ///< Carved so far (TCBs and internal stacks)
+		size_t psramSize;
+		size_t psramUsed;
+		uint32_t blocks; ///< Carved blocks
+		uint32_t owned; ///< Blocks currently held by a Task
+		uint32_t creates; ///< Static task creations
+		uint32_t reuses; ///< Creations that reused a block handed back by another task
+		uint32_t fallbacks; ///< Starts that fell back to the heap
+	};
+
+	static TaskArena& getInstance();
+
+	/** Whether static creation can work at all in this build */
+	static bool isSupported();
+
+	/**
+	 * Get a block with room for a @p stackBytes stack in @p region.
+	 * PSRAM requests fall back to internal RAM when there is no PSRAM
+	 * region. Returns INVALID_BLOCK when the arena is full.
+	 */
+	int acquire(Region region, uint32_t stackBytes);
+
+	/** Give a block back; it is reused once its TCB has been released */
+	void release(int block);
+
+	/**
+	 * Create a task in @p block. Waits up to @p waitMs for the previous
+	 * TCB in the block to be released. Returns nullptr on failure.
+	 */
+	TaskHandle_t create(int block, TaskFunction_t entry, const char* name, uint32_t stackBytes, void* arg, UBaseType_t priority, BaseType_t coreId, uint32_t waitMs);
+
+	/** Called first thing by the task itself, so the kernel reports its TCB's release */
+	void arm(int block);
+
+	/** Called after deleting a task that may never have reached arm() */
+	void deleted(int block);
+
+	void noteFallback() { m_fallbacks.fetch_add(1, std::memory_order_relaxed); }
+
+	Stats getStats() const;
+
+private:
+
+	struct Block {
+		StaticTask_t* tcb;
+		StackType_t* stack;
+		uint32_t stackBytes;
+		Region region;
+		bool owned;
+		std::atomic<bool> live {false}; // Kernel may still reference the TCB
+		std::atomic<bool> armed {false}; // Deletion callback installed
+	};
+
+	struct Pool {
+		uint8_t* base = nullptr;
+		size_t size = 0;
+		size_t used = 0;
+		void* carve(size_t bytes);
+	};
+
+	TaskArena();
+	~TaskArena() = default;
+	TaskArena(const TaskArena&) = delete;
+	TaskArena& operator=(const TaskArena&) = delete;
+
+	static void onTcbDeleted(int index, void* block);
+
+	mutable std::mutex m_mutex {};
+	Pool m_internal {};
+	Pool m_psram {};
+	std::array<Block, MAX_BLOCKS> m_blocks {};
+	size_t m_blockCount = 0;
+	std::atomic<uint32_t> m_creates {0};
+	std::atomic<uint32_t> m_reuses {0};
+	std::atomic<uint32_t> m_fallbacks {0};
+};
+
+} // namespace flx::kernel
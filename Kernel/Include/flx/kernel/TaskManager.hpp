@@ -22,10 +22,47 @@ public:
 	void unregisterTask(Task* task);
 	Task* getTask(const std::string& name);
 
+	/** Allocated stack of a task this manager created, in bytes; 0 if unknown */
+	uint32_t getStackSizeOf(TaskHandle_t handle);
+
 	void initWatchdog(uint32_t checkIntervalMs = 1000);
 	void checkTasks(uint64_t nowMs);
 	static bool checkHeapIntegrity();
 
+	/**
+	 * @brief Heap verification statistics
+	 *
+	 * The watchdog checks whole heaps (one per internal RAM region type, and
+	 * the PSRAM heap) in turn, until the per-tick budget is used up, so a
+	 * pass is spread over several ticks. ESP-IDF cannot check part of a
+	 * heap, so the pause is bounded by the slowest heap, not by the budget.
+	 * PSRAM is the slowest by far and is only checked every
+	 * PSRAM_CHECK_INTERVAL_MS.
+	 */
+	struct HeapCheckStats {
+		uint32_t budgetUs;
+		uint32_t heaps; ///< Heaps in a pass, PSRAM included
+		uint32_t passes; ///< Completed passes
+		uint32_t psramChecks; ///< PSRAM heap checks
+		uint32_t ticksPerPass; ///< Watchdog ticks the last pass took
+		uint32_t lastPassMs; ///< Wall time of the last pass
+		uint32_t lastTickUs; ///< Time spent checking in the most recent tick
+		uint32_t worstTickUs; ///< Longest pause the checker introduced
+		uint32_t worstHeapUs; ///< Slowest single heap (a floor for the pause)
+		uint32_t worstHeapIndex;
+	};
+
+	static constexpr uint32_t PSRAM_CHECK_INTERVAL_MS = 60000;
+
+	/**
+	 * Check heaps until @p budgetUs is spent. At least one heap is checked
+	 * per tick, so 0 means "one heap per tick".
+	 */
+	void setHeapCheckBudget(uint32_t budgetUs) { m_heapCheckBudgetUs.store(budgetUs); }
+	uint32_t getHeapCheckBudget() const { return m_heapCheckBudgetUs.load(); }
+	HeapCheckStats getHeapCheckStats() const;
+	void resetHeapCheckStats();
+
 	void printTasks();
 
 private:
@@ -37,10 +74,37 @@ private:
 
 	static void watchdogTaskEntry(void* param);
 
+	struct HeapRegion {
+		intptr_t start;
+		size_t size;
+		uint8_t probe; // Which address in the region is used to find its heap
+		bool psram; // Whole SPIRAM heap (not in the SoC region table)
+		bool verified; // Probe address is known to be inside a heap
+		bool disabled; // Region holds no heap
+	};
+
+	static constexpr uint32_t DEFAULT_HEAP_CHECK_BUDGET_US = 500;
+	static constexpr uint32_t WATCHDOG_STACK_SIZE = 3072;
+
+	bool checkHeapIntegrityStep();
+	static bool checkHeapRegion(HeapRegion& region);
+	void buildHeapRegions();
+
 	std::vector<Task*> m_tasks {};
 	std::mutex m_mutex {};
 	TaskHandle_t m_watchdogTaskHandle = nullptr;
+	uint32_t m_watchdogStackSize = WATCHDOG_STACK_SIZE;
 	uint32_t m_checkIntervalMs = 1000;
+
+	// Heap regions are only touched by the watchdog task
+	std::vector<HeapRegion> m_heapRegions {};
+	size_t m_heapCursor = 0;
+	uint32_t m_passTicks = 0;
+	int64_t m_passStartUs = 0;
+	int64_t m_psramDueUs = 0;
+	std::atomic<uint32_t> m_heapCheckBudgetUs {DEFAULT_HEAP_CHECK_BUDGET_US};
+	mutable std::mutex m_heapStatsMutex {};
+	HeapCheckStats m_heapStats {};
 };
 
 } // namespace flx::kernel
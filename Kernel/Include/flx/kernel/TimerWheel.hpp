@@ -0,0 +1,145 @@
+#pragma once
+
+#include "esp_timer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace flx::kernel {
+
+/**
+ * @brief Hierarchical timer wheel shared by all software timers
+ *
+ * Four levels of 64 slots over a 10 ms tick (0.64 s, 41 s, 44 min, 47 h
+ * horizons). Timers live in intrusive lists, so start/stop are O(1); a
+ * per-level occupancy bitmap finds the next non-empty slot without scanning.
+ *
+ * The wheel is tickless: a single one-shot esp_timer is armed for the next
+ * deadline only, so an idle system does not wake. Each timer carries a slack
+ * (how late it may fire); the wake-up is placed at the earliest
+ * deadline + slack, and every timer due by then fires in the same wake-up.
+ *
+ * Callbacks run on the esp_timer task (like ESP_TIMER_TASK dispatch) and
+ * must not block. Handles stay valid until destroy(); a stale handle is
+ * rejected by its generation count.
+ */
+class TimerWheel {
+public:
+
+	using TimerId = uint32_t;
+	using Callback = std::function<void()>;
+
+	static constexpr TimerId INVALID_TIMER = 0;
+	static constexpr uint32_t TICK_MS = 10;
+	static constexpr size_t LEVELS = 4;
+	static constexpr size_t SLOTS = 64;
+
+	struct TimerStats {
+		const char* name;
+		uint32_t periodMs; ///< 0 for one-shot
+		uint32_t slackMs;
+		bool active;
+		uint32_t fires;
+		uint32_t overruns; ///< Periods skipped because the callback ran too late
+		uint32_t avgLateUs; ///< Mean delay past the nominal deadline
+		uint32_t maxLateUs;
+		uint32_t maxRunUs; ///< Longest callback
+	};
+
+	struct Stats {
+		uint32_t timers; ///< Created and not destroyed
+		uint32_t active;
+		uint32_t wakeups; ///< esp_timer expiries that advanced the wheel
+		uint32_t fired;
+		uint32_t coalesced; ///< Fires that shared a wake-up with an earlier one
+		uint32_t cascades; ///< Timers moved down a level
+	};
+
+	static TimerWheel& getInstance();
+
+	/**
+	 * Create a stopped timer.
+	 * @param name   Static string shown in stats
+	 * @param slackMs How late the timer may fire so wake-ups can be shared
+	 */
+	TimerId create(const char* name, Callback callback, uint32_t slackMs = 0);
+
+	/** Fire once after @p delayMs; restarts the timer if already running */
+	bool startOnce(TimerId id, uint32_t delayMs);
+
+	/** Fire every @p periodMs; restarts the timer if already running */
+	bool startPeriodic(TimerId id, uint32_t periodMs);
+
+	bool stop(TimerId id);
+	void destroy(TimerId id);
+	bool isActive(TimerId id) const;
+
+	std::vector<TimerStats> getTimerStats() const;
+	Stats getStats() const;
+	void resetStats();
+
+private:
+
+	static constexpr int32_t NIL = -1;
+
+	struct Node {
+		Callback callback {};
+		const char* name = nullptr;
+		uint64_t expiry = 0; // Tick
+		uint32_t periodTicks = 0;
+		uint32_t periodMs = 0;
+		uint32_t slackMs = 0;
+		int32_t prev = NIL;
+		int32_t next = NIL;
+		uint16_t generation = 1;
+		uint8_t level = 0;
+		uint8_t slot = 0;
+		bool inUse = false;
+		bool linked = false;
+
+		uint32_t fires = 0;
+		uint32_t overruns = 0;
+		uint64_t totalLateUs = 0;
+		uint32_t maxLateUs = 0;
+		uint32_t maxRunUs = 0;
+	};
+
+	TimerWheel();
+	~TimerWheel();
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	Node* lookupLocked(TimerId id);
+	const Node* lookupLocked(TimerId id) const;
+	bool startLocked(TimerId id, uint32_t delayMs, uint32_t periodMs);
+	void linkLocked(int32_t index);
+	void unlinkLocked(int32_t index);
+	void advanceLocked(uint64_t toTick, std::vector<int32_t>& expired);
+	uint64_t nextWakeTickLocked() const;
+	void rearmLocked();
+	uint64_t nowTick() const;
+
+	static void onExpiry(void* arg);
+	void process();
+
+	mutable std::mutex m_mutex {};
+	std::vector<Node> m_nodes {};
+	std::vector<int32_t> m_free {};
+	std::array<std::array<int32_t, SLOTS>, LEVELS> m_slots {};
+	std::array<uint64_t, LEVELS> m_occupied {};
+	uint64_t m_currentTick = 0;
+	int64_t m_epochUs = 0;
+
+	esp_timer_handle_t m_wakeTimer = nullptr;
+	uint64_t m_armedTick = UINT64_MAX; // Wake-up currently programmed
+
+	uint32_t m_wakeups = 0;
+	uint32_t m_fired = 0;
+	uint32_t m_coalesced = 0;
+	uint32_t m_cascades = 0;
+};
+
+} // namespace flx::kernel
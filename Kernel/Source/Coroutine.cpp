@@ -0,0 +1,172 @@
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <algorithm>
+#include <flx/core/Logger.hpp>
+#include <flx/kernel/Coroutine.hpp>
+#include <flx/kernel/TaskManager.hpp>
+#include <string_view>
+
+static constexpr std::string_view TAG = "CoRuntime";
+
+// Upper bound on an idle sleep; also paces the heartbeat
+static constexpr uint32_t IDLE_WAIT_MS = 1000;
+
+namespace flx::kernel::co {
+
+// ============================================================
+// Runtime task
+// ============================================================
+
+class Runtime::RuntimeTask : public flx::kernel::Task {
+public:
+
+	RuntimeTask() : Task("co_runtime", STACK_SIZE, PRIORITY, tskNO_AFFINITY) {}
+
+protected:
+
+	void run(void* /*data*/) override { Runtime::getInstance().loop(*this); }
+};
+
+// ============================================================
+// Lifecycle
+// ============================================================
+
+Runtime& Runtime::getInstance() {
+	static Runtime instance;
+	return instance;
+}
+
+Runtime::Runtime() {
+	// The runtime task unregisters from TaskManager on destruction
+	TaskManager::getInstance();
+}
+
+Runtime::~Runtime() = default;
+
+bool Runtime::start() {
+	if (m_started.load(std::memory_order_acquire)) return true;
+	std::lock_guard<std::mutex> lock(m_startMutex);
+	if (m_started.load(std::memory_order_relaxed)) return true;
+	if (!m_task) m_task = std::make_unique<RuntimeTask>();
+	if (!m_task->start()) {
+		Log::error(TAG, "Failed to start coroutine runtime");
+		return false;
+	}
+	m_started.store(true, std::memory_order_release);
+	Log::info(TAG, "Coroutine runtime started");
+	return true;
+}
+
+bool Runtime::isRunning() const {
+	return m_started.load(std::memory_order_acquire) && m_task->isRunning();
+}
+
+bool Runtime::isRuntimeTask() const {
+	return m_started.load(std::memory_order_acquire) && m_task->getHandle() == xTaskGetCurrentTaskHandle();
+}
+
+// ============================================================
+// Scheduling
+// ============================================================
+
+void Runtime::wake() {
+	if (!m_started.load(std::memory_order_acquire)) return;
+	if (TaskHandle_t handle = m_task->getHandle()) xTaskNotifyGive(handle);
+}
+
+void Runtime::schedule(std::coroutine_handle<> handle) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_ready.push_back(handle);
+		m_readyHighWater = std::max(m_readyHighWater, m_ready.size());
+	}
+	if (!isRuntimeTask()) wake();
+}
+
+static bool timerAfter(int64_t aDue, uint32_t aSeq, int64_t bDue, uint32_t bSeq) {
+	return aDue != bDue ? aDue > bDue : (int32_t)(aSeq - bSeq) > 0;
+}
+
+void Runtime::callAfter(uint32_t delayMs, std::function<void()> fn) {
+	int64_t const due = esp_timer_get_time() + (int64_t)delayMs * 1000;
+	bool earliest;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_timers.push_back({due, m_timerSeq++, std::move(fn)});
+		std::push_heap(m_timers.begin(), m_timers.end(), [](const Timer& a, const Timer& b) {
+			return timerAfter(a.dueUs, a.seq, b.dueUs, b.seq);
+		});
+		earliest = m_timers.front().seq == m_timerSeq - 1;
+	}
+	// The runtime may be sleeping until a later deadline
+	if (earliest && !isRuntimeTask()) wake();
+}
+
+void Runtime::loop(RuntimeTask& task) {
+	auto later = [](const Timer& a, const Timer& b) { return timerAfter(a.dueUs, a.seq, b.dueUs, b.seq); };
+	std::vector<std::coroutine_handle<>> batch;
+
+	while (!task.shouldStop()) {
+		task.heartbeat();
+
+		// Due timers first; their callbacks resume or schedule coroutines
+		int64_t const now = esp_timer_get_time();
+		while (true) {
+			std::function<void()> fn;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_timers.empty() || m_timers.front().dueUs > now) break;
+				std::pop_heap(m_timers.begin(), m_timers.end(), later);
+				fn = std::move(m_timers.back().fn);
+				m_timers.pop_back();
+			}
+			fn();
+			m_timersFired.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Resume everything that became ready; coroutines scheduled while
+		// this batch runs wait for the next pass, so timers are not starved
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			batch.swap(m_ready);
+		}
+		for (auto handle: batch) {
+			handle.resume();
+			m_resumes.fetch_add(1, std::memory_order_relaxed);
+		}
+		batch.clear();
+
+		TickType_t wait;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_ready.empty()) {
+				wait = 0;
+			} else if (!m_timers.empty()) {
+				int64_t const remainingUs = m_timers.front().dueUs - esp_timer_get_time();
+				uint32_t const remainingMs = remainingUs <= 0 ? 0 : (uint32_t)std::min<int64_t>((remainingUs + 999) / 1000, IDLE_WAIT_MS);
+				wait = remainingMs == 0 ? 0 : std::max<TickType_t>(1, pdMS_TO_TICKS(remainingMs));
+			} else {
+				wait = pdMS_TO_TICKS(IDLE_WAIT_MS);
+			}
+		}
+		if (wait > 0) {
+			ulTaskNotifyTake(pdTRUE, wait);
+		}
+	}
+}
+
+Runtime::Stats Runtime::getStats() const {
+	Stats stats {};
+	uint32_t const spawned = m_spawned.load(std::memory_order_relaxed);
+	stats.spawned = spawned;
+	stats.live = spawned - m_finished.load(std::memory_order_relaxed);
+	stats.resumes = m_resumes.load(std::memory_order_relaxed);
+	stats.timersFired = m_timersFired.load(std::memory_order_relaxed);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	stats.timersPending = m_timers.size();
+	stats.readyHighWater = m_readyHighWater;
+	return stats;
+}
+
+} // namespace flx::kernel::co
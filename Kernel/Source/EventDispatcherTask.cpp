@@ -0,0 +1,45 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <flx/core/EventBus.hpp>
+#include <flx/core/Logger.hpp>
+#include <flx/kernel/EventDispatcherTask.hpp>
+#include <string_view>
+
+static constexpr std::string_view TAG = "EventDispatcher";
+
+// Bound a single drain pass so the heartbeat keeps ticking under event storms
+static constexpr size_t MAX_EVENTS_PER_PASS = 32;
+
+namespace flx::kernel {
+EventDispatcherTask& EventDispatcherTask::getInstance() {
+	static EventDispatcherTask instance;
+	return instance;
+}
+
+EventDispatcherTask::EventDispatcherTask()
+	: Task("event_dispatch", 4096, 4, tskNO_AFFINITY) {}
+
+void EventDispatcherTask::run(void* /*data*/) {
+	auto& bus = flx::core::EventBus::getInstance();
+
+	bus.setAsyncWakeup([this]() {
+		TaskHandle_t handle = getHandle();
+		if (handle) xTaskNotifyGive(handle);
+	});
+
+	Log::info(TAG, "Event dispatcher running");
+
+	while (true) {
+		heartbeat();
+
+		// Events queued before the wakeup hook was installed are picked up here too
+		if (bus.drainAsync(MAX_EVENTS_PER_PASS) == MAX_EVENTS_PER_PASS) {
+			taskYIELD();
+			continue;
+		}
+
+		ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+	}
+}
+
+} // namespace flx::kernel
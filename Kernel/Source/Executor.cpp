@@ -0,0 +1,254 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <algorithm>
+#include <flx/core/Logger.hpp>
+#include <flx/kernel/Executor.hpp>
+#include <flx/kernel/TaskManager.hpp>
+#include <string>
+#include <string_view>
+
+static constexpr std::string_view TAG = "Executor";
+
+// Idle workers re-check the other deques this often, in case a wake-up was
+// consumed by a sibling that stole the job first
+static constexpr uint32_t IDLE_POLL_MS = 1000;
+
+namespace flx::kernel {
+
+// ============================================================
+// Worker task
+// ============================================================
+
+class Executor::Worker : public Task {
+public:
+
+	Worker(size_t index)
+		: Task("exec_" + std::to_string(index), WORKER_STACK_SIZE, WORKER_PRIORITY, static_cast<BaseType_t>(index)),
+		  m_index(index) {}
+
+protected:
+
+	void run(void* /*data*/) override { Executor::getInstance().workerLoop(*this, m_index); }
+
+private:
+
+	size_t m_index;
+};
+
+// ============================================================
+// Lifecycle
+// ============================================================
+
+Executor& Executor::getInstance() {
+	static Executor instance;
+	return instance;
+}
+
+Executor::Executor() {
+	// Workers unregister from TaskManager on destruction; make sure it outlives us
+	TaskManager::getInstance();
+}
+
+Executor::~Executor() {
+	stop();
+}
+
+bool Executor::start() {
+	if (m_running.load()) return true;
+
+	for (size_t i = 0; i < MAX_WORKERS; i++) {
+		if (!m_workers[i]) m_workers[i] = std::make_unique<Worker>(i);
+		if (!m_workers[i]->start()) {
+			Log::error(TAG, "Failed to start worker %u", (unsigned)i);
+			stop();
+			return false;
+		}
+	}
+
+	m_running.store(true, std::memory_order_release);
+	Log::info(TAG, "Started %u workers", (unsigned)MAX_WORKERS);
+	return true;
+}
+
+void Executor::stop() {
+	m_running.store(false, std::memory_order_release);
+	for (size_t i = 0; i < MAX_WORKERS; i++) {
+		if (m_workers[i] && m_workers[i]->isRunning()) {
+			m_workers[i]->requestStop();
+			wake(i);
+		}
+	}
+	for (auto& worker: m_workers) {
+		if (worker) worker->join();
+	}
+
+	// Anything still queued runs here so no Future is left pending
+	for (auto& queue: m_queues) {
+		std::deque<Job> jobs;
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			jobs.swap(queue.jobs);
+		}
+		for (auto& job: jobs) {
+			job();
+		}
+	}
+}
+
+// ============================================================
+// Posting
+// ============================================================
+
+void Executor::post(Job job, RunOn where) {
+	if (where == RunOn::Gui) {
+		postToGui(std::move(job));
+	} else {
+		postToPool(std::move(job));
+	}
+}
+
+void Executor::postToPool(Job job) {
+	if (!m_running.load(std::memory_order_acquire)) {
+		m_inlineRuns.fetch_add(1, std::memory_order_relaxed);
+		job();
+		return;
+	}
+
+	// Work spawned by a job stays with its worker; outside work is spread
+	int const self = currentWorker();
+	size_t const index = self >= 0 ? static_cast<size_t>(self) : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % MAX_WORKERS;
+
+	size_t depth;
+	{
+		std::lock_guard<std::mutex> lock(m_queues[index].mutex);
+		m_queues[index].jobs.push_back(std::move(job));
+		depth = m_queues[index].jobs.size();
+	}
+
+	size_t highWater = m_highWater.load(std::memory_order_relaxed);
+	while (depth > highWater && !m_highWater.compare_exchange_weak(highWater, depth, std::memory_order_relaxed)) {
+	}
+
+	if (static_cast<int>(index) != self) wake(index);
+
+	// Let one idle sibling steal if the owner is busy
+	for (size_t i = 0; i < MAX_WORKERS; i++) {
+		if (i != index && m_idle[i].load(std::memory_order_relaxed)) {
+			wake(i);
+			break;
+		}
+	}
+}
+
+void Executor::postToGui(Job job) {
+	GuiDispatcher dispatcher;
+	{
+		std::lock_guard<std::mutex> lock(m_guiMutex);
+		dispatcher = m_guiDispatcher;
+	}
+
+	if (!dispatcher) {
+		postToPool(std::move(job));
+		return;
+	}
+	m_guiHops.fetch_add(1, std::memory_order_relaxed);
+	dispatcher(std::move(job));
+}
+
+void Executor::setGuiDispatcher(GuiDispatcher dispatcher) {
+	std::lock_guard<std::mutex> lock(m_guiMutex);
+	m_guiDispatcher = std::move(dispatcher);
+}
+
+// ============================================================
+// Workers
+// ============================================================
+
+bool Executor::popLocal(size_t index, Job& out) {
+	auto& queue = m_queues[index];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.jobs.empty()) return false;
+	out = std::move(queue.jobs.back());
+	queue.jobs.pop_back();
+	return true;
+}
+
+bool Executor::steal(size_t thief, Job& out) {
+	for (size_t offset = 1; offset < MAX_WORKERS; offset++) {
+		auto& queue = m_queues[(thief + offset) % MAX_WORKERS];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty()) continue;
+		out = std::move(queue.jobs.front());
+		queue.jobs.pop_front();
+		return true;
+	}
+	return false;
+}
+
+int Executor::currentWorker() const {
+	TaskHandle_t const self = xTaskGetCurrentTaskHandle();
+	for (size_t i = 0; i < MAX_WORKERS; i++) {
+		if (m_workers[i] && m_workers[i]->getHandle() == self) return static_cast<int>(i);
+	}
+	return -1;
+}
+
+void Executor::wake(size_t index) {
+	if (!m_workers[index]) return;
+	if (TaskHandle_t handle = m_workers[index]->getHandle()) xTaskNotifyGive(handle);
+}
+
+void Executor::workerLoop(Worker& worker, size_t index) {
+	while (!worker.shouldStop()) {
+		worker.heartbeat();
+
+		Job job;
+		if (popLocal(index, job)) {
+			job();
+			m_executed[index].fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+		if (steal(index, job)) {
+			job();
+			m_executed[index].fetch_add(1, std::memory_order_relaxed);
+			m_stolen[index].fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		// A post between the checks above and here leaves a pending
+		// notification, so the take returns at once
+		m_idle[index].store(true, std::memory_order_relaxed);
+		ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IDLE_POLL_MS));
+		m_idle[index].store(false, std::memory_order_relaxed);
+	}
+}
+
+// ============================================================
+// Stats
+// ============================================================
+
+Executor::Stats Executor::getStats() const {
+	Stats stats {};
+	for (size_t i = 0; i < MAX_WORKERS; i++) {
+		stats.executed[i] = m_executed[i].load(std::memory_order_relaxed);
+		stats.stolen[i] = m_stolen[i].load(std::memory_order_relaxed);
+		std::lock_guard<std::mutex> lock(m_queues[i].mutex);
+		stats.pending += m_queues[i].jobs.size();
+	}
+	stats.inlineRuns = m_inlineRuns.load(std::memory_order_relaxed);
+	stats.guiHops = m_guiHops.load(std::memory_order_relaxed);
+	stats.highWater = m_highWater.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void Executor::resetStats() {
+	for (size_t i = 0; i < MAX_WORKERS; i++) {
+		m_executed[i].store(0, std::memory_order_relaxed);
+		m_stolen[i].store(0, std::memory_order_relaxed);
+	}
+	m_inlineRuns.store(0, std::memory_order_relaxed);
+	m_guiHops.store(0, std::memory_order_relaxed);
+	m_highWater.store(0, std::memory_order_relaxed);
+}
+
+} // namespace flx::kernel
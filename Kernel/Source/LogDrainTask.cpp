@@ -0,0 +1,49 @@
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+#include <flx/core/LogBuffer.hpp>
+#include <flx/core/Logger.hpp>
+#include <flx/kernel/LogDrainTask.hpp>
+#include <cstdint>
+#include <string_view>
+
+static constexpr std::string_view TAG = "LogDrain";
+
+// Bound a single pass so the heartbeat keeps ticking under log storms
+static constexpr size_t MAX_RECORDS_PER_PASS = 32;
+
+// A full ring (64 records) at this interval is ~3000 lines/s per core
+static constexpr uint32_t POLL_INTERVAL_MS = 20;
+
+namespace flx::kernel {
+LogDrainTask& LogDrainTask::getInstance() {
+	static LogDrainTask instance;
+	return instance;
+}
+
+LogDrainTask::LogDrainTask()
+	: Task("log_drain", 4096, 1, tskNO_AFFINITY) {}
+
+void LogDrainTask::run(void* /*data*/) {
+#if CONFIG_FLXOS_DEFERRED_LOGGING
+	flx::core::LogBuffer::setDeferred(true);
+	Log::info(TAG, "Deferred logging %s", flx::core::LogBuffer::isDeferred() ? "enabled" : "unavailable");
+#endif
+
+	// Write out whatever is still buffered before esp_restart() resets the chip
+	esp_register_shutdown_handler([]() { flx::core::LogBuffer::drain(SIZE_MAX); });
+
+	while (true) {
+		heartbeat();
+
+		if (flx::core::LogBuffer::drain(MAX_RECORDS_PER_PASS) == MAX_RECORDS_PER_PASS) {
+			taskYIELD();
+			continue;
+		}
+
+		vTaskDelay(pdMS_TO_TICKS(POLL_INTERVAL_MS));
+	}
+}
+
+} // namespace flx::kernel
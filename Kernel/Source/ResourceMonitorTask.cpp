@@ -1,14 +1,28 @@
 #include "esp_heap_caps.h"
 
+#include "esp_system.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include <algorithm>
+#include <cstring>
 #include <flx/core/Logger.hpp>
 #include <flx/kernel/ResourceMonitorTask.hpp>
+#include <flx/kernel/StackProfiler.hpp>
+#include <new>
 #include <string_view>
 
 static constexpr std::string_view TAG = "ResourceMonitor";
 
+static constexpr size_t LOW_HEAP_THRESHOLD = 32768;
+static constexpr int64_t LOW_HEAP_WARN_INTERVAL_US = 10 * 1000000LL;
+static constexpr int64_t STATS_LOG_INTERVAL_US = 60 * 1000000LL;
+
+// A reader racing the writer retries this often before giving up on a slot
+static constexpr int SEQ_READ_ATTEMPTS = 8;
+
 namespace flx::kernel {
+
 ResourceMonitorTask& ResourceMonitorTask::getInstance() {
 	static ResourceMonitorTask instance;
 	return instance;
@@ -17,13 +31,30 @@ ResourceMonitorTask& ResourceMonitorTask::getInstance() {
 ResourceMonitorTask::ResourceMonitorTask()
 	: Task("res_monitor", 4096, 2, tskNO_AFFINITY) {}
 
+ResourceMonitorTask::~ResourceMonitorTask() {
+	if (m_ring) heap_caps_free(m_ring);
+}
+
 ResourceMonitorTask::Stats ResourceMonitorTask::getLatestStats() const {
 	return {m_freeHeap.load(), m_minFreeHeap.load(), m_freePsram.load(), m_uptimeSeconds.load()};
 }
 
+void ResourceMonitorTask::setSamplePeriod(uint32_t periodMs) {
+	m_samplePeriodMs.store(std::max(periodMs, MIN_SAMPLE_PERIOD_MS), std::memory_order_relaxed);
+}
+
+// ============================================================
+// Sampling
+// ============================================================
+
 void ResourceMonitorTask::run(void* /*data*/) {
 
 	setWatchdogTimeout(15000);
+	allocateHistory();
+
+	int64_t lastLogUs = 0;
+	int64_t lastLowHeapWarnUs = -LOW_HEAP_WARN_INTERVAL_US;
+	TickType_t lastWake = xTaskGetTickCount();
 
 	while (true) {
 		heartbeat();
@@ -33,18 +64,281 @@ void ResourceMonitorTask::run(void* /*data*/) {
 		m_freePsram = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
 		m_uptimeSeconds = (uint32_t)(esp_timer_get_time() / 1000000);
 
+		if (m_ring) takeSample();
+
 		// PowerManager refresh removed to decouple Kernel from System.
 		// TODO: Implement self-updating mechanism in PowerManager or use EventBus.
 
-		if (m_freeHeap < 32768) {
+		int64_t const now = esp_timer_get_time();
+		if (m_freeHeap < LOW_HEAP_THRESHOLD && now - lastLowHeapWarnUs >= LOW_HEAP_WARN_INTERVAL_US) {
 			Log::warn(TAG, "LOW HEAP MEMORY: %lu bytes", (unsigned long)m_freeHeap.load());
+			lastLowHeapWarnUs = now;
 		}
 
-		if (m_uptimeSeconds % 60 == 0) {
+		if (now - lastLogUs >= STATS_LOG_INTERVAL_US) {
 			Log::info(TAG, "Stats - Heap: %lu, PSRAM: %lu, Uptime: %lu s", (unsigned long)m_freeHeap.load(), (unsigned long)m_freePsram.load(), (unsigned long)m_uptimeSeconds.load());
+			lastLogUs = now;
 		}
-		vTaskDelay(pdMS_TO_TICKS(10000));
+
+		xTaskDelayUntil(&lastWake, std::max<TickType_t>(1, pdMS_TO_TICKS(getSamplePeriod())));
+	}
+}
+
+void ResourceMonitorTask::allocateHistory() {
+	size_t depth = HISTORY_DEPTH_PSRAM;
+	void* mem = heap_caps_calloc(depth, sizeof(RingSlot), MALLOC_CAP_SPIRAM);
+	if (!mem) {
+		depth = HISTORY_DEPTH_INTERNAL;
+		mem = heap_caps_calloc(depth, sizeof(RingSlot), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
 	}
+	if (!mem) {
+		Log::warn(TAG, "No memory for task history; sampling heap only");
+		return;
+	}
+
+	auto* ring = static_cast<RingSlot*>(mem);
+	for (size_t i = 0; i < depth; i++) {
+		new (&ring[i]) RingSlot();
+	}
+	m_depth = depth;
+	m_ring = ring;
+	Log::info(TAG, "Task history: %u samples every %lu ms", (unsigned)depth, (unsigned long)getSamplePeriod());
+}
+
+int ResourceMonitorTask::findOrAddTask(TaskHandle_t handle, const char* name, BaseType_t core, uint32_t number, bool& added) {
+	added = false;
+	int reusable = -1;
+	for (size_t i = 0; i < MAX_TRACKED_TASKS; i++) {
+		auto& entry = m_directory[i];
+		if (entry.used && entry.handle == handle && strncmp(entry.name, name, sizeof(entry.name)) == 0) {
+			return (int)i;
+		}
+		// Free, or last seen before the oldest sample still in the ring
+		bool const stale = !entry.used || entry.lastSeen + m_depth < number;
+		if (stale && (reusable < 0 || !entry.used)) reusable = (int)i;
+	}
+	if (reusable < 0) return -1;
+
+	auto& entry = m_directory[reusable];
+	entry.handle = handle;
+	strncpy(entry.name, name, sizeof(entry.name) - 1);
+	entry.name[sizeof(entry.name) - 1] = '\0';
+	entry.core = core;
+	entry.used = true;
+	entry.lastRuntime = 0;
+	entry.firstSeen = number;
+	entry.lastSeen = number;
+	added = true;
+	return reusable;
+}
+
+void ResourceMonitorTask::takeSample() {
+	UBaseType_t const taskCount = uxTaskGetNumberOfTasks();
+	if (m_status.size() < taskCount + 2) m_status.resize(taskCount + 8);
+
+	uint32_t totalRuntime = 0;
+	UBaseType_t const count = uxTaskGetSystemState(m_status.data(), m_status.size(), &totalRuntime);
+	int64_t const now = esp_timer_get_time();
+
+	uint32_t const number = m_written.load(std::memory_order_relaxed) + 1;
+	uint32_t const runtimeDelta = totalRuntime - m_lastTotalRuntime;
+	m_lastTotalRuntime = totalRuntime;
+
+	RingSlot& slot = m_ring[number % m_depth];
+	uint32_t const slotSeq = slot.seq.load(std::memory_order_relaxed);
+	slot.seq.store(slotSeq + 1, std::memory_order_relaxed);
+	uint32_t const dirSeq = m_directorySeq.load(std::memory_order_relaxed);
+	m_directorySeq.store(dirSeq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	RawSample& raw = slot.data;
+	raw.number = number;
+	raw.timestampUs = now;
+	raw.intervalUs = m_lastSampleUs ? (uint32_t)(now - m_lastSampleUs) : 0;
+	raw.count = 0;
+
+	for (UBaseType_t i = 0; i < count; i++) {
+		const TaskStatus_t& status = m_status[i];
+		bool added;
+		int const index = findOrAddTask(status.xHandle, status.pcTaskName, status.xCoreID, number, added);
+		if (index < 0) continue;
+
+		auto& entry = m_directory[index];
+		// A task seen for the first time ran at most since the last sample
+		uint32_t delta = number == 1 ? 0 : (added ? status.ulRunTimeCounter : status.ulRunTimeCounter - entry.lastRuntime);
+		if (delta > runtimeDelta) delta = 0; // Counter wrap or task restarted under the same handle
+		entry.lastRuntime = status.ulRunTimeCounter;
+		entry.lastSeen = number;
+
+		// Same normalisation as SystemInfoService: 100% is one fully loaded core
+		uint32_t const maxPermille = 1000u * portNUM_PROCESSORS;
+		uint32_t const permille = runtimeDelta ? (uint32_t)std::min<uint64_t>((uint64_t)delta * maxPermille / runtimeDelta, maxPermille) : 0;
+
+		raw.tasks[raw.count++] = {
+			.cpuPermille = (uint16_t)permille,
+			.stackFree = (uint16_t)std::min<uint32_t>(status.usStackHighWaterMark, UINT16_MAX),
+			.directory = (uint8_t)index,
+			.priority = (uint8_t)std::min<UBaseType_t>(status.uxCurrentPriority, UINT8_MAX),
+		};
+	}
+
+	raw.freeHeap = m_freeHeap.load(std::memory_order_relaxed);
+	raw.minFreeHeap = m_minFreeHeap.load(std::memory_order_relaxed);
+	raw.freePsram = m_freePsram.load(std::memory_order_relaxed);
+	raw.largestFreeBlock = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+	m_lastSampleUs = now;
+
+	m_directorySeq.store(dirSeq + 2, std::memory_order_release);
+	slot.seq.store(slotSeq + 2, std::memory_order_release);
+	m_written.store(number, std::memory_order_release);
+
+	// Outside the write section so history readers are not held up
+	auto& profiler = StackProfiler::getInstance();
+	profiler.beginSample();
+	for (UBaseType_t i = 0; i < count; i++) {
+		profiler.sample(m_status[i]);
+	}
+}
+
+// ============================================================
+// Readers
+// ============================================================
+
+bool ResourceMonitorTask::readSlot(uint32_t number, RawSample& out) const {
+	const RingSlot& slot = m_ring[number % m_depth];
+	for (int attempt = 0; attempt < SEQ_READ_ATTEMPTS; attempt++) {
+		uint32_t const before = slot.seq.load(std::memory_order_acquire);
+		if (before & 1) {
+			taskYIELD();
+			continue;
+		}
+		memcpy(&out, &slot.data, sizeof(out));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.seq.load(std::memory_order_relaxed) != before) continue;
+		// A newer sample may already have replaced the requested one
+		return out.number == number;
+	}
+	return false;
+}
+
+void ResourceMonitorTask::readDirectory(DirectoryEntry* out) const {
+	for (int attempt = 0; attempt < SEQ_READ_ATTEMPTS; attempt++) {
+		uint32_t const before = m_directorySeq.load(std::memory_order_acquire);
+		if (before & 1) {
+			taskYIELD();
+			continue;
+		}
+		memcpy(out, m_directory, sizeof(m_directory));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (m_directorySeq.load(std::memory_order_relaxed) == before) return;
+	}
+	// Still racing: names resolve to "?" rather than risk a torn entry
+	memset(out, 0, sizeof(m_directory));
+}
+
+ResourceMonitorTask::Sample ResourceMonitorTask::expand(const RawSample& raw, const DirectoryEntry* directory) const {
+	Sample sample {
+		.number = raw.number,
+		.timestampUs = raw.timestampUs,
+		.intervalUs = raw.intervalUs,
+		.freeHeap = raw.freeHeap,
+		.minFreeHeap = raw.minFreeHeap,
+		.freePsram = raw.freePsram,
+		.largestFreeBlock = raw.largestFreeBlock,
+		.tasks = {},
+	};
+	sample.tasks.reserve(raw.count);
+	for (size_t i = 0; i < raw.count && i < MAX_TRACKED_TASKS; i++) {
+		const RawTask& task = raw.tasks[i];
+		const DirectoryEntry& entry = directory[task.directory];
+		// The entry may since have been handed to another task
+		bool const valid = entry.used && entry.firstSeen <= raw.number && raw.number <= entry.lastSeen;
+
+		TaskLoad load {};
+		strncpy(load.name, valid ? entry.name : "?", sizeof(load.name) - 1);
+		load.handle = valid ? entry.handle : nullptr;
+		load.cpuPercent = (float)task.cpuPermille / 10.0F;
+		load.stackHighWater = task.stackFree;
+		load.core = valid ? (int)entry.core : (int)tskNO_AFFINITY;
+		load.priority = task.priority;
+		sample.tasks.push_back(load);
+	}
+	return sample;
+}
+
+std::vector<ResourceMonitorTask::Sample> ResourceMonitorTask::getHistory(size_t maxSamples) const {
+	std::vector<Sample> history;
+	uint32_t const written = m_written.load(std::memory_order_acquire);
+	if (written == 0 || !m_ring) return history;
+
+	size_t available = std::min<size_t>(written, m_depth);
+	if (maxSamples > 0) available = std::min(available, maxSamples);
+
+	std::vector<RawSample> raws;
+	raws.reserve(available);
+	RawSample raw;
+	for (uint32_t number = written - (uint32_t)available + 1; number <= written; number++) {
+		if (readSlot(number, raw)) raws.push_back(raw);
+	}
+
+	// Read after the slots so every entry they reference is already present
+	std::vector<DirectoryEntry> directory(MAX_TRACKED_TASKS);
+	readDirectory(directory.data());
+
+	history.reserve(raws.size());
+	for (auto& r: raws) {
+		history.push_back(expand(r, directory.data()));
+	}
+	return history;
+}
+
+std::vector<ResourceMonitorTask::LoadSummary> ResourceMonitorTask::getLoadSummary(size_t maxSamples) const {
+	std::vector<LoadSummary> summary;
+	uint32_t const written = m_written.load(std::memory_order_acquire);
+	if (written == 0 || !m_ring) return summary;
+
+	size_t available = std::min<size_t>(written, m_depth);
+	if (maxSamples > 0) available = std::min(available, maxSamples);
+
+	// Per directory entry; an entry is not reused while a sample in the ring refers to it
+	uint16_t peak[MAX_TRACKED_TASKS] = {};
+	uint32_t firstNumber[MAX_TRACKED_TASKS] = {};
+	RawSample raw;
+	RawSample latest {};
+	bool haveLatest = false;
+	for (uint32_t number = written - (uint32_t)available + 1; number <= written; number++) {
+		if (!readSlot(number, raw)) continue;
+		for (size_t i = 0; i < raw.count && i < MAX_TRACKED_TASKS; i++) {
+			const RawTask& task = raw.tasks[i];
+			if (!firstNumber[task.directory]) firstNumber[task.directory] = number;
+			peak[task.directory] = std::max(peak[task.directory], task.cpuPermille);
+		}
+		memcpy(&latest, &raw, sizeof(raw));
+		haveLatest = true;
+	}
+	if (!haveLatest) return summary;
+
+	// Read after the slots so every entry they reference is already present
+	std::vector<DirectoryEntry> directory(MAX_TRACKED_TASKS);
+	readDirectory(directory.data());
+
+	summary.reserve(latest.count);
+	for (size_t i = 0; i < latest.count && i < MAX_TRACKED_TASKS; i++) {
+		const RawTask& task = latest.tasks[i];
+		const DirectoryEntry& entry = directory[task.directory];
+		if (!entry.used || entry.firstSeen > latest.number || latest.number > entry.lastSeen) continue;
+		// A racing reuse would mix in another task's samples; report the current load only
+		uint16_t const top = entry.firstSeen <= firstNumber[task.directory] ? peak[task.directory] : task.cpuPermille;
+		summary.push_back({entry.handle, (float)task.cpuPermille / 10.0F, (float)top / 10.0F});
+	}
+	return summary;
+}
+
+bool ResourceMonitorTask::getLatestSample(Sample& out) const {
+	auto history = getHistory(1);
+	if (history.empty()) return false;
+	out = std::move(history.back());
+	return true;
 }
 
 } // namespace flx::kernel
@@ -0,0 +1,143 @@
+#include "esp_private/freertos_debug.h"
+#include "esp_timer.h"
+#include <algorithm>
+#include <cstring>
+#include <flx/kernel/StackProfiler.hpp>
+#include <flx/kernel/TaskManager.hpp>
+
+namespace flx::kernel {
+
+// ============================================================
+// Lifecycle
+// ============================================================
+
+StackProfiler& StackProfiler::getInstance() {
+	static StackProfiler instance;
+	return instance;
+}
+
+StackProfiler::StackProfiler() : m_sinceUs(esp_timer_get_time()) {
+	m_slots.reserve(MAX_ENTRIES);
+}
+
+void StackProfiler::reset() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_slots.clear();
+	m_sinceUs = esp_timer_get_time();
+}
+
+int64_t StackProfiler::getSinceUs() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_sinceUs;
+}
+
+// ============================================================
+// Recording
+// ============================================================
+
+StackProfiler::Slot* StackProfiler::findLocked(const char* name) {
+	for (auto& slot: m_slots) {
+		if (strncmp(slot.entry.name, name, sizeof(slot.entry.name)) == 0) return &slot;
+	}
+	return nullptr;
+}
+
+StackProfiler::Slot* StackProfiler::recordLocked(TaskHandle_t handle, const char* name, uint32_t stackSize, uint32_t freeBytes) {
+	Slot* slot = findLocked(name);
+	if (!slot) {
+		if (m_slots.size() >= MAX_ENTRIES) return nullptr;
+		slot = &m_slots.emplace_back();
+		strncpy(slot->entry.name, name, sizeof(slot->entry.name) - 1);
+		slot->entry.name[sizeof(slot->entry.name) - 1] = '\0';
+		slot->entry.minFree = UINT32_MAX;
+	}
+
+	auto& entry = slot->entry;
+	if (handle != slot->handle) {
+		slot->handle = handle;
+		entry.instances++;
+	}
+	if (stackSize) entry.stackSize = stackSize;
+	entry.samples++;
+	if (freeBytes < entry.minFree) {
+		entry.minFree = freeBytes;
+		entry.worstAtUs = esp_timer_get_time();
+	}
+	// Usage rather than the free figure drives the advice, so instances
+	// created with different sizes under one name still compare correctly
+	if (stackSize > freeBytes) entry.maxUsed = std::max(entry.maxUsed, stackSize - freeBytes);
+	return slot;
+}
+
+void StackProfiler::record(TaskHandle_t handle, const char* name, uint32_t stackSize, uint32_t freeBytes) {
+	if (!name) return;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	recordLocked(handle, name, stackSize, freeBytes);
+}
+
+uint32_t StackProfiler::resolveStackSize(const TaskStatus_t& status) {
+	// Tasks created through flx::kernel::Task report the size they asked for
+	if (uint32_t const size = TaskManager::getInstance().getStackSizeOf(status.xHandle)) return size;
+
+	// Anything else (IDF tasks, raw xTaskCreate users): measure the stack
+	// bounds. pxEndOfStack is the aligned top word, so this can come out a
+	// few bytes under the requested size.
+	TaskSnapshot_t snapshot {};
+	if (status.pxStackBase && vTaskGetSnapshot(status.xHandle, &snapshot) == pdTRUE && snapshot.pxEndOfStack > status.pxStackBase) {
+		return (uint32_t)((uintptr_t)snapshot.pxEndOfStack - (uintptr_t)status.pxStackBase) + sizeof(StackType_t);
+	}
+	return 0;
+}
+
+void StackProfiler::beginSample() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_sampleNumber++;
+}
+
+void StackProfiler::sample(const TaskStatus_t& status) {
+	uint32_t known = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Slot* slot = findLocked(status.pcTaskName);
+		if (slot && slot->handle == status.xHandle) known = slot->entry.stackSize;
+	}
+	// Resolved outside the lock: TaskManager may call record() while it
+	// holds its own mutex (stopping a task), so never take them in reverse
+	uint32_t const stackSize = known ? known : resolveStackSize(status);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (Slot* slot = recordLocked(status.xHandle, status.pcTaskName, stackSize, status.usStackHighWaterMark)) {
+		slot->lastSample = m_sampleNumber;
+	}
+}
+
+// ============================================================
+// Report
+// ============================================================
+
+uint32_t StackProfiler::recommend(uint32_t usedBytes) const {
+	if (usedBytes == 0) return 0;
+	uint32_t const margin = std::max<uint32_t>((uint64_t)usedBytes * getMarginPercent() / 100, MIN_HEADROOM_BYTES);
+	return (usedBytes + margin + ROUND_BYTES - 1) / ROUND_BYTES * ROUND_BYTES;
+}
+
+std::vector<StackProfiler::Report> StackProfiler::getReport() const {
+	std::vector<Report> report;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		report.reserve(m_slots.size());
+		for (const auto& slot: m_slots) {
+			Report item {};
+			item.entry = slot.entry;
+			// Tolerate a pass that is still in progress
+			item.entry.alive = slot.lastSample != 0 && slot.lastSample + 1 >= m_sampleNumber;
+			report.push_back(item);
+		}
+	}
+	for (auto& item: report) {
+		item.recommended = recommend(item.entry.maxUsed);
+	}
+	return report;
+}
+
+} // namespace flx::kernel
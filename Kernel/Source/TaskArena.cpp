@@ -0,0 +1,177 @@
+#include "Config.hpp"
+#include "esp_heap_caps.h"
+#include "freertos/idf_additions.h"
+#include "sdkconfig.h"
+#include <flx/core/Logger.hpp>
+#include <flx/kernel/TaskArena.hpp>
+#include <string_view>
+
+static constexpr std::string_view TAG = "TaskArena";
+
+// FreeRTOS lays stacks out on this boundary; carve everything to it
+static constexpr size_t ARENA_ALIGN = 16;
+
+// The preprocessor cannot see TLS_INDEX; keep "> 1" in step with it
+#if configSUPPORT_STATIC_ALLOCATION && configNUM_THREAD_LOCAL_STORAGE_POINTERS > 1 && CONFIG_FREERTOS_TLSP_DELETION_CALLBACKS
+#define FLX_TASK_ARENA_SUPPORTED 1
+#else
+#define FLX_TASK_ARENA_SUPPORTED 0
+#endif
+
+namespace flx::kernel {
+
+static size_t alignUp(size_t bytes) { return (bytes + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1); }
+
+// ============================================================
+// Lifecycle
+// ============================================================
+
+TaskArena& TaskArena::getInstance() {
+	static TaskArena instance;
+	return instance;
+}
+
+bool TaskArena::isSupported() { return FLX_TASK_ARENA_SUPPORTED; }
+
+TaskArena::TaskArena() {
+	if (!isSupported()) {
+		Log::warn(TAG, "Static tasks disabled: needs CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS >= 2 and TLSP deletion callbacks");
+		return;
+	}
+
+	size_t const internalBytes = alignUp(flx::config::taskArena.internalBytes);
+	if (internalBytes > 0) {
+		m_internal.base = static_cast<uint8_t*>(heap_caps_aligned_alloc(ARENA_ALIGN, internalBytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+		m_internal.size = m_internal.base ? internalBytes : 0;
+	}
+
+#if CONFIG_SPIRAM_ALLOW_STACK_EXTERNAL_MEMORY
+	size_t const psramBytes = alignUp(flx::config::taskArena.psramBytes);
+	if (psramBytes > 0) {
+		m_psram.base = static_cast<uint8_t*>(heap_caps_aligned_alloc(ARENA_ALIGN, psramBytes, MALLOC_CAP_SPIRAM));
+		m_psram.size = m_psram.base ? psramBytes : 0;
+	}
+#endif
+
+	Log::info(TAG, "Reserved %u B internal, %u B PSRAM for static tasks", (unsigned)m_internal.size, (unsigned)m_psram.size);
+}
+
+void* TaskArena::Pool::carve(size_t bytes) {
+	bytes = alignUp(bytes);
+	if (!base || used + bytes > size) return nullptr;
+	void* p = base + used;
+	used += bytes;
+	return p;
+}
+
+// ============================================================
+// Blocks
+// ============================================================
+
+int TaskArena::acquire(Region region, uint32_t stackBytes) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Region const want = (region == Region::PSRAM && m_psram.size > 0) ? Region::PSRAM : Region::INTERNAL;
+
+	// Smallest handed-back block that fits
+	int best = INVALID_BLOCK;
+	for (size_t i = 0; i < m_blockCount; i++) {
+		const Block& b = m_blocks[i];
+		if (b.owned || b.region != want || b.stackBytes < stackBytes) continue;
+		if (best == INVALID_BLOCK || b.stackBytes < m_blocks[best].stackBytes) best = (int)i;
+	}
+	if (best != INVALID_BLOCK) {
+		m_blocks[best].owned = true;
+		m_reuses.fetch_add(1, std::memory_order_relaxed);
+		return best;
+	}
+
+	if (m_blockCount >= MAX_BLOCKS) return INVALID_BLOCK;
+
+	// The TCB must be internal even when the stack is not; check both fit
+	// before carving either so a failed request wastes nothing
+	size_t const tcbBytes = alignUp(sizeof(StaticTask_t));
+	size_t const stackAligned = alignUp(stackBytes);
+	Pool& stackPool = want == Region::PSRAM ? m_psram : m_internal;
+	size_t const internalNeed = tcbBytes + (want == Region::INTERNAL ? stackAligned : 0);
+	if (m_internal.used + internalNeed > m_internal.size) return INVALID_BLOCK;
+	if (want == Region::PSRAM && m_psram.used + stackAligned > m_psram.size) return INVALID_BLOCK;
+
+	Block& b = m_blocks[m_blockCount];
+	b.tcb = static_cast<StaticTask_t*>(m_internal.carve(tcbBytes));
+	b.stack = static_cast<StackType_t*>(stackPool.carve(stackAligned));
+	b.stackBytes = stackAligned;
+	b.region = want;
+	b.owned = true;
+	return (int)m_blockCount++;
+}
+
+void TaskArena::release(int block) {
+	if (block < 0 || (size_t)block >= MAX_BLOCKS) return;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_blocks[block].owned = false;
+}
+
+TaskHandle_t TaskArena::create(int block, TaskFunction_t entry, const char* name, uint32_t stackBytes, void* arg, UBaseType_t priority, BaseType_t coreId, uint32_t waitMs) {
+#if FLX_TASK_ARENA_SUPPORTED
+	Block& b = m_blocks[block];
+
+	// The previous task in this block may still be queued for cleanup
+	for (uint32_t waited = 0; b.live.load(std::memory_order_acquire); waited += portTICK_PERIOD_MS) {
+		if (waited >= waitMs) {
+			Log::warn(TAG, "%s: previous TCB not released after %lu ms", name, (unsigned long)waitMs);
+			return nullptr;
+		}
+		vTaskDelay(1);
+	}
+
+	b.armed.store(false, std::memory_order_relaxed);
+	b.live.store(true, std::memory_order_release);
+	TaskHandle_t const handle = xTaskCreateStaticPinnedToCore(entry, name, stackBytes, arg, priority, b.stack, b.tcb, coreId);
+	if (!handle) {
+		b.live.store(false, std::memory_order_release);
+		return nullptr;
+	}
+	m_creates.fetch_add(1, std::memory_order_relaxed);
+	return handle;
+#else
+	return nullptr;
+#endif
+}
+
+void TaskArena::arm(int block) {
+#if FLX_TASK_ARENA_SUPPORTED
+	Block& b = m_blocks[block];
+	vTaskSetThreadLocalStoragePointerAndDelCallback(nullptr, TLS_INDEX, &b, &TaskArena::onTcbDeleted);
+	b.armed.store(true, std::memory_order_release);
+#endif
+}
+
+void TaskArena::deleted(int block) {
+	// A task deleted before it ran arm() was never scheduled, so FreeRTOS
+	// released its TCB inside vTaskDelete() without a callback to tell us
+	Block& b = m_blocks[block];
+	if (!b.armed.load(std::memory_order_acquire)) b.live.store(false, std::memory_order_release);
+}
+
+void TaskArena::onTcbDeleted(int /*index*/, void* block) {
+	static_cast<Block*>(block)->live.store(false, std::memory_order_release);
+}
+
+TaskArena::Stats TaskArena::getStats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Stats stats {};
+	stats.internalSize = m_internal.size;
+	stats.internalUsed = m_internal.used;
+	stats.psramSize = m_psram.size;
+	stats.psramUsed = m_psram.used;
+	stats.blocks = m_blockCount;
+	for (size_t i = 0; i < m_blockCount; i++) {
+		if (m_blocks[i].owned) stats.owned++;
+	}
+	stats.creates = m_creates.load(std::memory_order_relaxed);
+	stats.reuses = m_reuses.load(std::memory_order_relaxed);
+	stats.fallbacks = m_fallbacks.load(std::memory_order_relaxed);
+	return stats;
+}
+
+} // namespace flx::kernel
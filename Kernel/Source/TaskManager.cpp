@@ -5,12 +5,16 @@
 #include "esp_task_wdt.h"
 #include "esp_timer.h"
 #include "freertos/idf_additions.h"
+#include "heap_memory_layout.h"
 #include "freertos/projdefs.h"
 #include "portmacro.h"
+#include "Config.hpp"
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <flx/core/Logger.hpp>
+#include <flx/kernel/StackProfiler.hpp>
+#include <flx/kernel/TaskArena.hpp>
 #include <flx/kernel/TaskManager.hpp>
 #include <string_view>
 
@@ -20,17 +24,46 @@ static constexpr std::string_view TM_TAG = "TaskManager";
 namespace flx::kernel {
 static uint64_t getMillis() { return esp_timer_get_time() / 1000; }
 
+// The profile's scheduling section may replace the stack size, priority and
+// core a task asks for
 Task::Task(const std::string& name, uint32_t stackSize, UBaseType_t priority, BaseType_t coreId)
-	: m_name(name), m_stackSize(stackSize), m_priority(priority),
-	  m_coreId(coreId) {
+	: m_name(name), m_stackSize(flx::config::taskStackSize(name, stackSize)), m_priority(flx::config::taskPriority(name, priority)),
+	  m_coreId(flx::config::taskCore(name, coreId)) {
 	TaskManager::getInstance().registerTask(this);
 }
 
 Task::~Task() {
 	stop();
+	if (m_arenaBlock != TaskArena::INVALID_BLOCK) TaskArena::getInstance().release(m_arenaBlock);
 	TaskManager::getInstance().unregisterTask(this);
 }
 
+TaskHandle_t Task::createStatic() {
+	auto& arena = TaskArena::getInstance();
+	if (!TaskArena::isSupported()) {
+		arena.noteFallback();
+		return nullptr;
+	}
+	if (m_arenaBlock == TaskArena::INVALID_BLOCK) {
+		auto const region = m_stackMemory == StackMemory::PSRAM ? TaskArena::Region::PSRAM : TaskArena::Region::INTERNAL;
+		m_arenaBlock = arena.acquire(region, m_stackSize);
+		if (m_arenaBlock == TaskArena::INVALID_BLOCK) {
+			Log::warn(TASK_TAG, "Task arena full, %s uses the heap", m_name.c_str());
+			arena.noteFallback();
+			return nullptr;
+		}
+	}
+
+	// Set before creation: the task may reach taskEntry before create() returns
+	m_runningStatic = true;
+	TaskHandle_t const handle = arena.create(m_arenaBlock, taskEntry, m_name.c_str(), m_stackSize, this, m_priority, m_coreId, TCB_RELEASE_WAIT_MS);
+	if (!handle) {
+		m_runningStatic = false;
+		arena.noteFallback();
+	}
+	return handle;
+}
+
 bool Task::start(void* data) {
 	TaskHandle_t expected = nullptr;
 	if (!m_handle.compare_exchange_strong(expected, (TaskHandle_t)1)) {
@@ -41,10 +74,13 @@ bool Task::start(void* data) {
 	m_stopRequested = false;
 	m_lastHeartbeat = getMillis();
 
-	TaskHandle_t handle = nullptr;
-	BaseType_t res = (m_coreId == tskNO_AFFINITY)
-		? xTaskCreate(taskEntry, m_name.c_str(), m_stackSize, this, m_priority, &handle)
-		: xTaskCreatePinnedToCore(taskEntry, m_name.c_str(), m_stackSize, this, m_priority, &handle, m_coreId);
+	TaskHandle_t handle = m_stackMemory != StackMemory::HEAP ? createStatic() : nullptr;
+	BaseType_t res = pdPASS;
+	if (!handle) {
+		res = (m_coreId == tskNO_AFFINITY)
+			? xTaskCreate(taskEntry, m_name.c_str(), m_stackSize, this, m_priority, &handle)
+			: xTaskCreatePinnedToCore(taskEntry, m_name.c_str(), m_stackSize, this, m_priority, &handle, m_coreId);
+	}
 
 	if (res != pdPASS) {
 		Log::error(TASK_TAG, "Failed to create task: %s", m_name.c_str());
@@ -56,6 +92,7 @@ bool Task::start(void* data) {
 	if (!m_handle.compare_exchange_strong(expected, handle)) {
 		// stop() was called during creation
 		vTaskDelete(handle);
+		if (m_runningStatic.exchange(false)) TaskArena::getInstance().deleted(m_arenaBlock);
 	} else {
 		Log::info(TASK_TAG, "Task started: %s", m_name.c_str());
 	}
@@ -67,7 +104,9 @@ void Task::stop() {
 	TaskHandle_t handle = m_handle.exchange(nullptr);
 	if (handle && handle != (TaskHandle_t)1) {
 		Log::info(TASK_TAG, "Task stopped: %s", m_name.c_str());
+		StackProfiler::getInstance().record(handle, m_name.c_str(), m_stackSize, uxTaskGetStackHighWaterMark(handle));
 		vTaskDelete(handle);
+		if (m_runningStatic.exchange(false)) TaskArena::getInstance().deleted(m_arenaBlock);
 	}
 }
 
@@ -80,7 +119,9 @@ void Task::join() const {
 void Task::taskEntry(void* param) {
 	Task* t = static_cast<Task*>(param);
 	if (t) {
+		if (t->m_runningStatic) TaskArena::getInstance().arm(t->m_arenaBlock);
 		t->run(t->m_data);
+		StackProfiler::getInstance().record(xTaskGetCurrentTaskHandle(), t->m_name.c_str(), t->m_stackSize, uxTaskGetStackHighWaterMark(nullptr));
 		TaskHandle_t handle = t->m_handle.exchange(nullptr);
 		if (handle) {
 			// If we got the handle, it means stop() wasn't called from another thread
@@ -115,6 +156,16 @@ Task* TaskManager::getTask(const std::string& name) {
 	return nullptr;
 }
 
+uint32_t TaskManager::getStackSizeOf(TaskHandle_t handle) {
+	if (!handle) return 0;
+	if (handle == m_watchdogTaskHandle) return m_watchdogStackSize;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto* t: m_tasks)
+		if (t->getHandle() == handle)
+			return t->getStackSize();
+	return 0;
+}
+
 void TaskManager::initWatchdog(uint32_t interval) {
 	m_checkIntervalMs = interval;
 
@@ -131,9 +182,10 @@ void TaskManager::initWatchdog(uint32_t interval) {
 	Log::info(TM_TAG, "Watchdog initialized with %d ms interval", (int)interval);
 
 	if (!m_watchdogTaskHandle) {
+		m_watchdogStackSize = flx::config::taskStackSize("tm_watchdog", WATCHDOG_STACK_SIZE);
 		BaseType_t const res = xTaskCreatePinnedToCore(
-			watchdogTaskEntry, "tm_watchdog", 3072, this, configMAX_PRIORITIES - 1,
-			&m_watchdogTaskHandle, 0
+			watchdogTaskEntry, "tm_watchdog", m_watchdogStackSize, this, flx::config::taskPriority("tm_watchdog", configMAX_PRIORITIES - 1),
+			&m_watchdogTaskHandle, flx::config::taskCore("tm_watchdog", 0)
 		);
 		if (res != pdPASS) {
 		}
@@ -145,7 +197,8 @@ void TaskManager::watchdogTaskEntry(void* p) {
 	esp_task_wdt_add(nullptr); // Add this task to TWDT
 	while (true) {
 		tm->checkTasks(getMillis());
-		if (!tm->checkHeapIntegrity()) {
+		if (!tm->checkHeapIntegrityStep()) {
+			Log::error(TM_TAG, "Heap corruption detected, restarting");
 			esp_restart();
 		}
 		esp_task_wdt_reset(); // Hardware kick
@@ -177,6 +230,141 @@ bool TaskManager::checkHeapIntegrity() {
 	return ok;
 }
 
+void TaskManager::buildHeapRegions() {
+	// Adjacent regions of the same type are registered as one heap
+	for (size_t i = 0; i < soc_memory_region_count; i++) {
+		const auto& region = soc_memory_regions[i];
+		if (!m_heapRegions.empty() && i > 0) {
+			auto& last = m_heapRegions.back();
+			if (!last.psram && soc_memory_regions[i - 1].type == region.type &&
+				last.start + (intptr_t)last.size == (intptr_t)region.start) {
+				last.size += region.size;
+				continue;
+			}
+		}
+		m_heapRegions.push_back({(intptr_t)region.start, region.size, 0, false, false, false});
+	}
+
+	// PSRAM is added at runtime, outside the region table; it is one heap
+	if (heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0) {
+		m_heapRegions.push_back({0, heap_caps_get_total_size(MALLOC_CAP_SPIRAM), 0, true, true, false});
+	}
+
+	m_passStartUs = esp_timer_get_time();
+	std::lock_guard<std::mutex> lock(m_heapStatsMutex);
+	m_heapStats.heaps = (uint32_t)m_heapRegions.size();
+}
+
+bool TaskManager::checkHeapRegion(HeapRegion& region) {
+	if (region.psram) {
+		return heap_caps_check_integrity(MALLOC_CAP_SPIRAM, true);
+	}
+
+	// The start or end of a region can be reserved (static data, ROM), so
+	// try a few addresses before deciding the region holds no heap
+	static constexpr int PROBES = 3;
+	while (true) {
+		intptr_t const offsets[PROBES] = {(intptr_t)region.size / 2, 0, (intptr_t)region.size - 4};
+		intptr_t const addr = region.start + offsets[region.probe];
+		if (heap_caps_check_integrity_addr(addr, region.verified)) {
+			region.verified = true;
+			return true;
+		}
+		if (region.verified) {
+			return false; // Known heap failed its check
+		}
+		if (++region.probe < PROBES) {
+			continue;
+		}
+		// "Not a heap" and "corrupt" look the same here; settle it once
+		region.disabled = true;
+		return heap_caps_check_integrity_all(true);
+	}
+}
+
+bool TaskManager::checkHeapIntegrityStep() {
+	if (m_heapRegions.empty()) {
+		buildHeapRegions();
+		if (m_heapRegions.empty()) {
+			return checkHeapIntegrity();
+		}
+	}
+
+	int64_t const tickStart = esp_timer_get_time();
+	int64_t const budget = m_heapCheckBudgetUs.load();
+	uint32_t worstHeapUs = 0;
+	size_t worstHeap = 0;
+	bool psramChecked = false;
+	bool passDone = false;
+	bool ok = true;
+
+	// At most one full pass per tick, and always at least one heap
+	for (size_t visited = 0; visited < m_heapRegions.size() && ok; visited++) {
+		size_t const index = m_heapCursor;
+		auto& region = m_heapRegions[index];
+		// Walking PSRAM takes milliseconds; it gets its own, longer interval
+		bool const psramDue = region.psram && esp_timer_get_time() >= m_psramDueUs;
+		if (!region.disabled && (!region.psram || psramDue)) {
+			int64_t const start = esp_timer_get_time();
+			ok = checkHeapRegion(region);
+			int64_t const end = esp_timer_get_time();
+			auto const us = (uint32_t)(end - start);
+			if (us > worstHeapUs) {
+				worstHeapUs = us;
+				worstHeap = index;
+			}
+			if (region.psram) {
+				m_psramDueUs = end + (int64_t)PSRAM_CHECK_INTERVAL_MS * 1000;
+				psramChecked = true;
+			}
+		}
+		m_heapCursor = (m_heapCursor + 1) % m_heapRegions.size();
+		if (m_heapCursor == 0) {
+			passDone = true;
+		}
+		if (esp_timer_get_time() - tickStart >= budget) {
+			break;
+		}
+	}
+
+	int64_t const now = esp_timer_get_time();
+	auto const tickUs = (uint32_t)(now - tickStart);
+	m_passTicks++;
+
+	std::lock_guard<std::mutex> lock(m_heapStatsMutex);
+	m_heapStats.lastTickUs = tickUs;
+	m_heapStats.worstTickUs = std::max(m_heapStats.worstTickUs, tickUs);
+	if (worstHeapUs > m_heapStats.worstHeapUs) {
+		m_heapStats.worstHeapUs = worstHeapUs;
+		m_heapStats.worstHeapIndex = (uint32_t)worstHeap;
+	}
+	if (psramChecked) {
+		m_heapStats.psramChecks++;
+	}
+	if (passDone) {
+		m_heapStats.passes++;
+		m_heapStats.ticksPerPass = m_passTicks;
+		m_heapStats.lastPassMs = (uint32_t)((now - m_passStartUs) / 1000);
+		m_passTicks = 0;
+		m_passStartUs = now;
+	}
+	return ok;
+}
+
+TaskManager::HeapCheckStats TaskManager::getHeapCheckStats() const {
+	std::lock_guard<std::mutex> lock(m_heapStatsMutex);
+	HeapCheckStats stats = m_heapStats;
+	stats.budgetUs = m_heapCheckBudgetUs.load();
+	return stats;
+}
+
+void TaskManager::resetHeapCheckStats() {
+	std::lock_guard<std::mutex> lock(m_heapStatsMutex);
+	uint32_t const heaps = m_heapStats.heaps;
+	m_heapStats = {};
+	m_heapStats.heaps = heaps;
+}
+
 void TaskManager::printTasks() {
 	std::lock_guard<std::mutex> lock(m_mutex);
 	for (auto* t: m_tasks) {
@@ -0,0 +1,407 @@
+#include "esp_timer.h"
+#include <algorithm>
+#include <bit>
+#include <flx/core/Logger.hpp>
+#include <flx/kernel/TimerWheel.hpp>
+#include <string_view>
+
+static constexpr std::string_view TAG = "TimerWheel";
+
+static constexpr int64_t TICK_US = flx::kernel::TimerWheel::TICK_MS * 1000;
+static constexpr uint32_t SLOT_BITS = 6; // log2(SLOTS)
+
+namespace flx::kernel {
+
+static_assert(TimerWheel::SLOTS == (1u << SLOT_BITS), "SLOT_BITS must match SLOTS");
+
+static TimerWheel::TimerId makeId(int32_t index, uint16_t generation) {
+	return ((uint32_t)generation << 16) | (uint32_t)(index + 1);
+}
+
+// ============================================================
+// Lifecycle
+// ============================================================
+
+TimerWheel& TimerWheel::getInstance() {
+	static TimerWheel instance;
+	return instance;
+}
+
+TimerWheel::TimerWheel() {
+	for (auto& level: m_slots) {
+		level.fill(NIL);
+	}
+	m_epochUs = esp_timer_get_time();
+
+	esp_timer_create_args_t const args = {
+		.callback = &TimerWheel::onExpiry,
+		.arg = this,
+		.dispatch_method = ESP_TIMER_TASK,
+		.name = "timer_wheel",
+		.skip_unhandled_events = false,
+	};
+	if (esp_timer_create(&args, &m_wakeTimer) != ESP_OK) {
+		Log::error(TAG, "Failed to create wake-up timer");
+		m_wakeTimer = nullptr;
+	}
+}
+
+TimerWheel::~TimerWheel() {
+	if (m_wakeTimer) {
+		esp_timer_stop(m_wakeTimer);
+		esp_timer_delete(m_wakeTimer);
+	}
+}
+
+// ============================================================
+// Public API
+// ============================================================
+
+TimerWheel::TimerId TimerWheel::create(const char* name, Callback callback, uint32_t slackMs) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	int32_t index;
+	if (!m_free.empty()) {
+		index = m_free.back();
+		m_free.pop_back();
+	} else {
+		if (m_nodes.size() >= 0xFFFF) {
+			Log::error(TAG, "Out of timer handles");
+			return INVALID_TIMER;
+		}
+		index = (int32_t)m_nodes.size();
+		m_nodes.emplace_back();
+	}
+
+	Node& node = m_nodes[index];
+	uint16_t const generation = node.generation;
+	node = Node {};
+	node.generation = generation;
+	node.callback = std::move(callback);
+	node.name = name ? name : "?";
+	node.slackMs = slackMs;
+	node.inUse = true;
+	return makeId(index, generation);
+}
+
+bool TimerWheel::startOnce(TimerId id, uint32_t delayMs) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return startLocked(id, delayMs, 0);
+}
+
+bool TimerWheel::startPeriodic(TimerId id, uint32_t periodMs) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return startLocked(id, periodMs, periodMs);
+}
+
+bool TimerWheel::stop(TimerId id) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Node* node = lookupLocked(id);
+	if (!node || !node->linked) return false;
+	unlinkLocked((int32_t)(id & 0xFFFF) - 1);
+	rearmLocked();
+	return true;
+}
+
+void TimerWheel::destroy(TimerId id) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Node* node = lookupLocked(id);
+	if (!node) return;
+	int32_t const index = (int32_t)(id & 0xFFFF) - 1;
+	if (node->linked) unlinkLocked(index);
+	node->callback = nullptr;
+	node->inUse = false;
+	// Zero is reserved so no live handle ever equals INVALID_TIMER
+	if (++node->generation == 0) node->generation = 1;
+	m_free.push_back(index);
+	rearmLocked();
+}
+
+bool TimerWheel::isActive(TimerId id) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const Node* node = lookupLocked(id);
+	return node && node->linked;
+}
+
+// ============================================================
+// Wheel
+// ============================================================
+
+TimerWheel::Node* TimerWheel::lookupLocked(TimerId id) {
+	return const_cast<Node*>(static_cast<const TimerWheel*>(this)->lookupLocked(id));
+}
+
+const TimerWheel::Node* TimerWheel::lookupLocked(TimerId id) const {
+	uint32_t const slot = id & 0xFFFF;
+	if (slot == 0 || slot > m_nodes.size()) return nullptr;
+	const Node& node = m_nodes[slot - 1];
+	if (!node.inUse || node.generation != (id >> 16)) return nullptr;
+	return &node;
+}
+
+uint64_t TimerWheel::nowTick() const {
+	return (uint64_t)((esp_timer_get_time() - m_epochUs) / TICK_US);
+}
+
+bool TimerWheel::startLocked(TimerId id, uint32_t delayMs, uint32_t periodMs) {
+	Node* node = lookupLocked(id);
+	if (!node) return false;
+	int32_t const index = (int32_t)(id & 0xFFFF) - 1;
+	if (node->linked) unlinkLocked(index);
+
+	// An empty wheel can jump to the present; nothing is left to expire
+	if (m_occupied == decltype(m_occupied) {}) m_currentTick = nowTick();
+
+	// Round the deadline up so the timer never fires early
+	int64_t const dueUs = esp_timer_get_time() - m_epochUs + (int64_t)delayMs * 1000;
+	node->expiry = std::max<uint64_t>((uint64_t)((dueUs + TICK_US - 1) / TICK_US), m_currentTick + 1);
+	node->periodMs = periodMs;
+	node->periodTicks = periodMs == 0 ? 0 : std::max<uint32_t>(1, (periodMs + TICK_MS - 1) / TICK_MS);
+
+	linkLocked(index);
+	rearmLocked();
+	return true;
+}
+
+void TimerWheel::linkLocked(int32_t index) {
+	Node& node = m_nodes[index];
+
+	// Lowest level whose 64-slot window (counted from the current tick)
+	// reaches the deadline; beyond the top level, park in its last slot
+	size_t level = 0;
+	uint64_t slotTick = node.expiry;
+	while (level < LEVELS) {
+		uint32_t const shift = level * SLOT_BITS;
+		if ((node.expiry >> shift) - (m_currentTick >> shift) < SLOTS) {
+			slotTick = node.expiry >> shift;
+			break;
+		}
+		level++;
+	}
+	if (level == LEVELS) {
+		level = LEVELS - 1;
+		slotTick = (m_currentTick >> (level * SLOT_BITS)) + SLOTS - 1;
+	}
+
+	uint8_t const slot = (uint8_t)(slotTick & (SLOTS - 1));
+	int32_t& head = m_slots[level][slot];
+	node.level = (uint8_t)level;
+	node.slot = slot;
+	node.prev = NIL;
+	node.next = head;
+	if (head != NIL) m_nodes[head].prev = index;
+	head = index;
+	node.linked = true;
+	m_occupied[level] |= (uint64_t)1 << slot;
+}
+
+void TimerWheel::unlinkLocked(int32_t index) {
+	Node& node = m_nodes[index];
+	if (node.prev != NIL) {
+		m_nodes[node.prev].next = node.next;
+	} else {
+		m_slots[node.level][node.slot] = node.next;
+		if (node.next == NIL) m_occupied[node.level] &= ~((uint64_t)1 << node.slot);
+	}
+	if (node.next != NIL) m_nodes[node.next].prev = node.prev;
+	node.prev = node.next = NIL;
+	node.linked = false;
+}
+
+/**
+ * Visit occupied slots of @p level in deadline order. Every slot holds
+ * deadlines 1..63 slot-widths ahead of the current tick; @p fn gets the slot
+ * index and the first tick it covers, and returns false to stop.
+ */
+template<typename Fn>
+static void forEachOccupied(uint64_t occupied, uint64_t currentTick, size_t level, Fn&& fn) {
+	uint32_t const shift = level * SLOT_BITS;
+	uint64_t const base = currentTick >> shift;
+	uint32_t const first = (uint32_t)((base + 1) & (TimerWheel::SLOTS - 1));
+	uint64_t pending = std::rotr(occupied, (int)first);
+	while (pending) {
+		uint32_t const bit = (uint32_t)std::countr_zero(pending);
+		pending &= pending - 1;
+		uint64_t const startTick = (base + 1 + bit) << shift;
+		if (!fn((first + bit) & (TimerWheel::SLOTS - 1), startTick)) return;
+	}
+}
+
+void TimerWheel::advanceLocked(uint64_t toTick, std::vector<int32_t>& expired) {
+	if (toTick <= m_currentTick) return;
+
+	// Pull every slot whose window has been reached, then re-place its
+	// timers against the new tick: due ones expire, the rest cascade down
+	std::vector<int32_t> moved;
+	for (size_t level = 0; level < LEVELS; level++) {
+		forEachOccupied(m_occupied[level], m_currentTick, level, [&](uint32_t slot, uint64_t startTick) {
+			if (startTick > toTick) return false;
+			for (int32_t index = m_slots[level][slot]; index != NIL; index = m_nodes[index].next) {
+				moved.push_back(index);
+				m_nodes[index].linked = false;
+			}
+			m_slots[level][slot] = NIL;
+			m_occupied[level] &= ~((uint64_t)1 << slot);
+			return true;
+		});
+	}
+
+	m_currentTick = toTick;
+	for (int32_t index: moved) {
+		Node& node = m_nodes[index];
+		node.prev = node.next = NIL;
+		if (node.expiry <= toTick) {
+			expired.push_back(index);
+		} else {
+			m_cascades++;
+			linkLocked(index);
+		}
+	}
+	std::sort(expired.begin(), expired.end(), [this](int32_t a, int32_t b) {
+		return m_nodes[a].expiry < m_nodes[b].expiry;
+	});
+}
+
+uint64_t TimerWheel::nextWakeTickLocked() const {
+	// Earliest (deadline + slack): waking then lets every timer due by that
+	// point fire together without any of them exceeding its slack
+	uint64_t wake = UINT64_MAX;
+	for (size_t level = 0; level < LEVELS; level++) {
+		forEachOccupied(m_occupied[level], m_currentTick, level, [&](uint32_t slot, uint64_t startTick) {
+			if (startTick >= wake) return false;
+			for (int32_t index = m_slots[level][slot]; index != NIL; index = m_nodes[index].next) {
+				const Node& node = m_nodes[index];
+				wake = std::min(wake, node.expiry + node.slackMs / TICK_MS);
+			}
+			return true;
+		});
+	}
+	return wake;
+}
+
+void TimerWheel::rearmLocked() {
+	if (!m_wakeTimer) return;
+	uint64_t const wake = nextWakeTickLocked();
+	if (wake == m_armedTick) return;
+
+	esp_timer_stop(m_wakeTimer);
+	m_armedTick = wake;
+	if (wake == UINT64_MAX) return;
+
+	int64_t const delayUs = m_epochUs + (int64_t)wake * TICK_US - esp_timer_get_time();
+	esp_timer_start_once(m_wakeTimer, (uint64_t)std::max<int64_t>(delayUs, 1));
+}
+
+// ============================================================
+// Expiry
+// ============================================================
+
+void TimerWheel::onExpiry(void* arg) {
+	static_cast<TimerWheel*>(arg)->process();
+}
+
+void TimerWheel::process() {
+	struct Due {
+		TimerId id;
+		Callback callback;
+	};
+	std::vector<Due> due;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_armedTick = UINT64_MAX;
+		m_wakeups++;
+
+		std::vector<int32_t> expired;
+		uint64_t const now = nowTick();
+		advanceLocked(now, expired);
+
+		int64_t const nowUs = esp_timer_get_time() - m_epochUs;
+		due.reserve(expired.size());
+		for (int32_t index: expired) {
+			Node& node = m_nodes[index];
+			uint32_t const lateUs = (uint32_t)std::max<int64_t>(0, nowUs - (int64_t)node.expiry * TICK_US);
+			node.fires++;
+			node.totalLateUs += lateUs;
+			node.maxLateUs = std::max(node.maxLateUs, lateUs);
+			due.push_back({makeId(index, node.generation), node.callback});
+
+			if (node.periodTicks > 0) {
+				// Keep the phase; periods that already passed are dropped
+				uint64_t const missed = (now - node.expiry) / node.periodTicks;
+				node.overruns += (uint32_t)missed;
+				node.expiry += (missed + 1) * node.periodTicks;
+				linkLocked(index);
+			}
+		}
+		m_fired += expired.size();
+		if (expired.size() > 1) m_coalesced += expired.size() - 1;
+
+		rearmLocked();
+	}
+
+	// Callbacks run unlocked so they can start, stop or destroy timers
+	for (auto& entry: due) {
+		int64_t const start = esp_timer_get_time();
+		if (entry.callback) entry.callback();
+		uint32_t const runUs = (uint32_t)(esp_timer_get_time() - start);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (Node* node = lookupLocked(entry.id)) node->maxRunUs = std::max(node->maxRunUs, runUs);
+	}
+}
+
+// ============================================================
+// Stats
+// ============================================================
+
+std::vector<TimerWheel::TimerStats> TimerWheel::getTimerStats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::vector<TimerStats> out;
+	for (auto& node: m_nodes) {
+		if (!node.inUse) continue;
+		out.push_back({
+			.name = node.name,
+			.periodMs = node.periodMs,
+			.slackMs = node.slackMs,
+			.active = node.linked,
+			.fires = node.fires,
+			.overruns = node.overruns,
+			.avgLateUs = node.fires ? (uint32_t)(node.totalLateUs / node.fires) : 0,
+			.maxLateUs = node.maxLateUs,
+			.maxRunUs = node.maxRunUs,
+		});
+	}
+	return out;
+}
+
+TimerWheel::Stats TimerWheel::getStats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Stats stats {};
+	for (auto& node: m_nodes) {
+		if (!node.inUse) continue;
+		stats.timers++;
+		if (node.linked) stats.active++;
+	}
+	stats.wakeups = m_wakeups;
+	stats.fired = m_fired;
+	stats.coalesced = m_coalesced;
+	stats.cascades = m_cascades;
+	return stats;
+}
+
+void TimerWheel::resetStats() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto& node: m_nodes) {
+		node.fires = 0;
+		node.overruns = 0;
+		node.totalLateUs = 0;
+		node.maxLateUs = 0;
+		node.maxRunUs = 0;
+	}
+	m_wakeups = 0;
+	m_fired = 0;
+	m_coalesced = 0;
+	m_cascades = 0;
+}
+
+} // namespace flx::kernel
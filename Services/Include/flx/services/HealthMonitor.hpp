@@ -0,0 +1,100 @@
+#pragma once
+
+#include "IService.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace flx::services {
+
+/**
+ * @brief Periodic health checks with latency budgets and restart backoff
+ *
+ * Services opt in through their manifest (healthIntervalMs, healthBudgetUs,
+ * autoRestart); other subsystems add a check with addCheck(). A TimerWheel
+ * tick hands at most one due check to the Executor, and only posts when the
+ * earliest check is due; first runs are spread across each interval, so
+ * checks never pile up in the same tick.
+ *
+ * Every run is timed against its budget. A service whose check fails, or
+ * that reports ServiceFailed, is restarted through
+ * ServiceRegistry::restartService() if it asked for autoRestart, waiting
+ * BACKOFF_BASE_MS, then twice as long after each failed attempt, up to
+ * BACKOFF_MAX_MS.
+ */
+class HealthMonitor {
+public:
+
+	static constexpr uint32_t TICK_MS = 200;
+	static constexpr uint32_t BACKOFF_BASE_MS = 5000;
+	static constexpr uint32_t BACKOFF_MAX_MS = 5 * 60 * 1000;
+
+	struct CheckStats {
+		std::string name; ///< Service id, or the name given to addCheck()
+		uint32_t intervalMs;
+		uint32_t budgetUs;
+		uint32_t runs;
+		uint32_t overBudget; ///< Runs that took longer than budgetUs
+		uint32_t lastUs;
+		uint32_t maxUs;
+		uint64_t totalUs;
+		uint32_t failures; ///< Failed checks and failed restarts
+		uint32_t consecutiveFailures;
+		uint32_t restarts; ///< Successful automatic restarts
+		int64_t nextDueUs; ///< esp_timer time; INT64_MAX while not scheduled
+		bool lastOk;
+		bool restartPending;
+	};
+
+	static HealthMonitor& getInstance();
+
+	/** Pick up every registered service that declares a check or autoRestart and start ticking */
+	void start();
+	void stop();
+
+	/**
+	 * Add a check that is not a service. @p check runs on an Executor worker
+	 * and returns false when unhealthy; failures are counted, never restarted.
+	 */
+	void addCheck(const std::string& name, uint32_t intervalMs, uint32_t budgetUs, std::function<bool()> check);
+
+	/** Make every check due now; they still run one per tick */
+	void checkNow();
+
+	std::vector<CheckStats> getStats() const;
+	void resetStats();
+
+private:
+
+	HealthMonitor() = default;
+
+	struct Entry {
+		CheckStats stats {};
+		std::shared_ptr<IService> service; // Service checks
+		std::function<bool()> check; // addCheck() checks
+		bool autoRestart = false;
+	};
+
+	/** Run the most overdue check, if any (Executor) */
+	void tick();
+	void scheduleFirstRunLocked(size_t index, int64_t now);
+	void scheduleRestartLocked(Entry& entry, int64_t now);
+	/** Publish the earliest nextDueUs for the wheel callback */
+	void updateNextDueLocked();
+	void onServiceFailed(std::string_view serviceId);
+	static int64_t backoffUs(uint32_t consecutiveFailures);
+
+	mutable std::mutex m_mutex;
+	std::vector<Entry> m_entries;
+	uint32_t m_timer = 0; // TimerWheel id, 0 while stopped
+	uint32_t m_failedSub = 0; // ServiceFailed subscription
+	std::atomic<int64_t> m_nextDueUs {INT64_MAX}; // Earliest nextDueUs of any entry
+	std::atomic<bool> m_busy {false}; // A tick is queued or running
+};
+
+} // namespace flx::services
@@ -3,7 +3,9 @@
 #include "ServiceManifest.hpp"
 #include "esp_system.h"
 #include "esp_timer.h"
+#include <atomic>
 #include <cstdint>
+#include <flx/core/Trace.hpp>
 #include <string>
 
 namespace flx::services {
@@ -63,10 +65,11 @@ public:
 	virtual void onGuiInit() {}
 
 	/**
-	 * Optional health check. Called periodically by the registry.
-	 * Override to report service health status.
+	 * Optional health check. Called every healthIntervalMs by the
+	 * HealthMonitor on an Executor worker, so keep it within healthBudgetUs.
+	 * @return false if unhealthy; with autoRestart the service is restarted.
 	 */
-	virtual void onHealthCheck() {}
+	virtual bool onHealthCheck() { return true; }
 
 	// ──────── State management (non-virtual) ────────
 
@@ -79,6 +82,8 @@ public:
 			return m_state == ServiceState::Started;
 		}
 		m_state = ServiceState::Starting;
+		// Manifests are static, so the name outlives the trace
+		FLX_TRACE_SCOPE(getManifest().serviceName.c_str());
 
 		// Measure boot timing and heap impact
 		uint32_t heapBefore = esp_get_free_heap_size();
@@ -138,7 +143,7 @@ public:
 
 protected:
 
-	ServiceState m_state = ServiceState::Stopped;
+	std::atomic<ServiceState> m_state {ServiceState::Stopped}; // Read from other tasks (lazy activation, diagnostics)
 	uint32_t m_startCount = 0;
 	int64_t m_lastStartTimeUs = 0; ///< Duration of last start() in microseconds
 	int32_t m_heapDeltaBytes = 0; ///< Heap change from last start (negative = consumed)
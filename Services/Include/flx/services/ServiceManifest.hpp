@@ -91,6 +91,30 @@ struct ServiceManifest {
 	/// If true, this service requires GUI mode (skipped in headless)
 	bool guiRequired = false;
 
+	/// If true, not started at boot but on first use: getService(),
+	/// retainService(), a subscription to one of its topics, or an app
+	/// listing it in requiredServices. Needs autoStart.
+	bool lazy = false;
+
+	/// Event names this service publishes; subscribing to one (directly or
+	/// through a wildcard such as "wifi.*") starts a lazy service
+	std::vector<std::string> topics {};
+
+	/// Stop a lazy service after this long unused (0 = keep it running).
+	/// Unused means unretained, no running dependents and no subscribers
+	/// to its topics.
+	uint32_t idleStopMs = 0;
+
+	/// Call onHealthCheck() this often while started (0 = never)
+	uint32_t healthIntervalMs = 0;
+
+	/// How long onHealthCheck() should take; slower runs are logged and counted
+	uint32_t healthBudgetUs = 2000;
+
+	/// Restart the service when onHealthCheck() fails or it is in Failed
+	/// state, backing off exponentially between attempts
+	bool autoRestart = false;
+
 	/// Capability flags this service provides
 	ServiceCapability capabilities = ServiceCapability::None;
 
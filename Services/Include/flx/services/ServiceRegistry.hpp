@@ -2,21 +2,43 @@
 
 #include "IService.hpp"
 #include "ServiceManifest.hpp"
+#include <atomic>
+#include <cstdint>
 #include <flx/core/Singleton.hpp>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace flx::services {
 
+/**
+ * @brief One service's start during startAll()
+ *
+ * Times are microseconds since startAll() began. gatedBy names the
+ * dependency that finished last, i.e. the one this service waited for.
+ */
+struct ServiceBootRecord {
+	std::string serviceId;
+	std::string gatedBy;
+	int64_t readyUs = 0; ///< Dependencies settled
+	int64_t startUs = 0;
+	int64_t endUs = 0;
+	int core = 0;
+	bool ok = false;
+};
+
 /**
  * @brief Central registry and lifecycle manager for all FlxOS services.
  *
  * Key features:
  * - Dependency resolution via topological sort (Kahn's algorithm)
  * - Priority-based ordering within dependency levels
+ * - Lazy services: started on first use, optionally stopped again when idle
+ * - Optional parallel boot (CONFIG_FLXOS_PARALLEL_SERVICE_START): services
+ *   whose dependencies have settled start concurrently on the Executor
  * - Health monitoring
  * - Hot reload (stop + re-start individual services)
  * - Safe mode trigger on required service failure
@@ -53,7 +75,9 @@ public:
 
 	/**
 	 * Start all registered services in dependency order.
-	 * Uses topological sort to resolve dependencies.
+	 * Uses topological sort to resolve dependencies. In parallel mode a
+	 * service starts as soon as every dependency has started, failed or
+	 * been skipped, lowest priority value first when workers are scarce.
 	 * @param guiMode If false, skip services with guiRequired=true
 	 * @return true if all required services started successfully
 	 */
@@ -88,10 +112,30 @@ public:
 	 */
 	bool restartService(const std::string& serviceId);
 
+	// ──────── Lazy activation ────────
+
+	/**
+	 * Keep a service running until the matching releaseService(), starting
+	 * it first if it is lazy and stopped.
+	 * @return true if the service is now in Started state (the reference is
+	 *         only taken then)
+	 */
+	bool retainService(const std::string& serviceId);
+	void releaseService(const std::string& serviceId);
+
+	/**
+	 * EventBus subscribe hook: start, on the Executor, every stopped lazy
+	 * service that publishes @p event (or a topic under a "prefix.*" pattern).
+	 */
+	void onTopicSubscribed(const std::string& event);
+
+	/** Stop lazy services that have been unused for their idleStopMs */
+	void stopIdleServices();
+
 	// ──────── Queries ────────
 
-	/** Get a service by ID */
-	std::shared_ptr<IService> getService(const std::string& serviceId) const;
+	/** Get a service by ID; a stopped lazy service is started first */
+	std::shared_ptr<IService> getService(const std::string& serviceId);
 
 	/** Get the state of a service */
 	ServiceState getServiceState(const std::string& serviceId) const;
@@ -102,17 +146,20 @@ public:
 	/** Get the resolved boot order (valid after startAll) */
 	const std::vector<std::string>& getBootOrder() const { return m_bootOrder; }
 
+	/** Per-service start times from the last startAll(), in start order */
+	const std::vector<ServiceBootRecord>& getBootTimeline() const { return m_bootTimeline; }
+
 	/** Get count of registered services */
 	size_t getServiceCount() const { return m_services.size(); }
 
 	/** Check if a required service failed (triggers safe mode) */
-	bool hasRequiredFailure() const { return m_requiredFailed; }
+	bool hasRequiredFailure() const { return m_requiredFailed.load(std::memory_order_acquire); }
 
 	// ──────── Diagnostics ────────
 
 	/**
-	 * Run health checks on all started services.
-	 * Logs state of each service.
+	 * Run health checks on all started services at once.
+	 * Logs the ones that fail. HealthMonitor runs them on a schedule.
 	 */
 	void performHealthCheck();
 
@@ -132,6 +179,37 @@ private:
 	 */
 	std::vector<std::string> topologicalSort() const;
 
+	/**
+	 * The boot order from the BootCache when the registered manifests
+	 * (ids, priorities, dependencies) match the cached signature, else
+	 * topologicalSort(), which is then cached.
+	 */
+	std::vector<std::string> resolveBootOrder() const;
+
+	struct BootCounts {
+		int started = 0;
+		int skipped = 0;
+		int failed = 0;
+	};
+
+	BootCounts startSerial(bool guiMode, int64_t bootStartUs);
+	BootCounts startParallel(bool guiMode, int64_t bootStartUs);
+
+	/** Whether startAll() leaves this service alone (logs why) */
+	bool skipAtBoot(const ServiceManifest& manifest, bool guiMode) const;
+
+	/** Start a lazy service (and its dependencies) if it is not running */
+	bool activate(const std::string& serviceId);
+
+	/** Note a use of a lazy service, for the idle timeout */
+	void touchLocked(const std::string& serviceId);
+
+	/** Start one service for startAll(), filling in @p record */
+	bool bootService(const std::shared_ptr<IService>& svc, int64_t bootStartUs, ServiceBootRecord& record);
+
+	/** Fill in gatedBy and log the chain of services that bounded boot time */
+	void resolveCriticalPath(int64_t totalUs);
+
 	/**
 	 * Find services that depend on the given service ID.
 	 */
@@ -147,7 +225,19 @@ private:
 	std::vector<std::shared_ptr<IService>> m_services;
 	std::unordered_map<std::string, std::shared_ptr<IService>> m_serviceMap;
 	std::vector<std::string> m_bootOrder;
-	bool m_requiredFailed = false;
+	std::vector<ServiceBootRecord> m_bootTimeline;
+	std::atomic<bool> m_requiredFailed {false}; // Set from boot workers in parallel mode
+
+	struct LazyUse {
+		uint32_t refs = 0;
+		int64_t lastUseUs = 0;
+	};
+	// Serialises lazy starts and idle stops; recursive because activation
+	// starts dependencies through startService()
+	std::recursive_mutex m_lazyMutex {};
+	std::unordered_map<std::string, LazyUse> m_lazyUse;
+	uint32_t m_idleTimer = 0; // TimerWheel id, 0 until a service asks for idle stops
+	bool m_guiMode = false;
 };
 
 } // namespace flx::services
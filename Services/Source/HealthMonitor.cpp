@@ -0,0 +1,273 @@
+#include "esp_timer.h"
+#include <algorithm>
+#include <cstdint>
+#include <flx/core/Logger.hpp>
+#include <flx/core/SystemEvents.hpp>
+#include <flx/kernel/Executor.hpp>
+#include <flx/kernel/TimerWheel.hpp>
+#include <flx/services/HealthMonitor.hpp>
+#include <flx/services/ServiceRegistry.hpp>
+
+static constexpr const char* TAG = "HealthMonitor";
+
+// Ticks wake the CPU only alongside other timers where they can
+static constexpr uint32_t TICK_SLACK_MS = 100;
+
+namespace flx::services {
+
+HealthMonitor& HealthMonitor::getInstance() {
+	static HealthMonitor instance;
+	return instance;
+}
+
+// ──────── Registration ────────
+
+void HealthMonitor::start() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_timer != flx::kernel::TimerWheel::INVALID_TIMER) return;
+
+	for (const auto& svc: ServiceRegistry::getInstance().getAllServices()) {
+		const auto& manifest = svc->getManifest();
+		if (manifest.healthIntervalMs == 0 && !manifest.autoRestart) continue;
+		bool const known = std::any_of(m_entries.begin(), m_entries.end(), [&](const Entry& e) { return e.service == svc; });
+		if (known) continue;
+
+		Entry entry;
+		entry.stats.name = manifest.serviceId;
+		entry.stats.intervalMs = manifest.healthIntervalMs;
+		entry.stats.budgetUs = manifest.healthBudgetUs;
+		entry.service = svc;
+		entry.autoRestart = manifest.autoRestart;
+		m_entries.push_back(std::move(entry));
+	}
+
+	int64_t const now = esp_timer_get_time();
+	for (size_t i = 0; i < m_entries.size(); i++) scheduleFirstRunLocked(i, now);
+	// Services that failed before we started watching (at boot, say)
+	for (auto& entry: m_entries) {
+		if (entry.autoRestart && entry.service->getState() == ServiceState::Failed) scheduleRestartLocked(entry, now);
+	}
+	updateNextDueLocked();
+
+	m_failedSub = flx::core::EventChannel<flx::core::ServiceFailed>::getInstance().subscribe([this](const flx::core::ServiceFailed& event) {
+		onServiceFailed(event.serviceId);
+	});
+
+	auto& wheel = flx::kernel::TimerWheel::getInstance();
+	m_timer = wheel.create("health", [this]() {
+		// The wheel's callback must not block; checks run on the Executor,
+		// which is only woken when one is due
+		if (esp_timer_get_time() < m_nextDueUs.load(std::memory_order_relaxed)) return;
+		if (m_busy.exchange(true)) return;
+		flx::kernel::Executor::getInstance().post([this]() {
+			tick();
+			m_busy.store(false);
+		});
+	}, TICK_SLACK_MS);
+	wheel.startPeriodic(m_timer, TICK_MS);
+	Log::info(TAG, "Watching %zu health checks", m_entries.size());
+}
+
+void HealthMonitor::stop() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_timer == flx::kernel::TimerWheel::INVALID_TIMER) return;
+	flx::kernel::TimerWheel::getInstance().destroy(m_timer);
+	m_timer = flx::kernel::TimerWheel::INVALID_TIMER;
+	flx::core::EventChannel<flx::core::ServiceFailed>::getInstance().unsubscribe(m_failedSub);
+}
+
+void HealthMonitor::addCheck(const std::string& name, uint32_t intervalMs, uint32_t budgetUs, std::function<bool()> check) {
+	if (intervalMs == 0 || !check) return;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Entry entry;
+	entry.stats.name = name;
+	entry.stats.intervalMs = intervalMs;
+	entry.stats.budgetUs = budgetUs;
+	entry.check = std::move(check);
+	m_entries.push_back(std::move(entry));
+	scheduleFirstRunLocked(m_entries.size() - 1, esp_timer_get_time());
+	updateNextDueLocked();
+}
+
+void HealthMonitor::scheduleFirstRunLocked(size_t index, int64_t now) {
+	auto& stats = m_entries[index].stats;
+	if (stats.intervalMs == 0) {
+		stats.nextDueUs = INT64_MAX; // Only watched for Failed state
+		return;
+	}
+	// Spread first runs over the interval so equal intervals do not line up
+	int64_t const intervalUs = static_cast<int64_t>(stats.intervalMs) * 1000;
+	stats.nextDueUs = now + intervalUs * static_cast<int64_t>(index + 1) / static_cast<int64_t>(m_entries.size() + 1);
+}
+
+void HealthMonitor::scheduleRestartLocked(Entry& entry, int64_t now) {
+	entry.stats.restartPending = true;
+	entry.stats.consecutiveFailures++;
+	entry.stats.nextDueUs = now + backoffUs(entry.stats.consecutiveFailures);
+}
+
+void HealthMonitor::updateNextDueLocked() {
+	int64_t next = INT64_MAX;
+	for (const auto& entry: m_entries) next = std::min(next, entry.stats.nextDueUs);
+	m_nextDueUs.store(next, std::memory_order_relaxed);
+}
+
+int64_t HealthMonitor::backoffUs(uint32_t consecutiveFailures) {
+	uint32_t const shift = std::min<uint32_t>(consecutiveFailures > 0 ? consecutiveFailures - 1 : 0, 16);
+	uint64_t const delayMs = std::min<uint64_t>(static_cast<uint64_t>(BACKOFF_BASE_MS) << shift, BACKOFF_MAX_MS);
+	return static_cast<int64_t>(delayMs) * 1000;
+}
+
+// ──────── Scheduling ────────
+
+void HealthMonitor::tick() {
+	int64_t const now = esp_timer_get_time();
+	size_t index = SIZE_MAX;
+	std::shared_ptr<IService> service;
+	std::function<bool()> check;
+	bool restart = false;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (size_t i = 0; i < m_entries.size(); i++) {
+			auto const due = m_entries[i].stats.nextDueUs;
+			if (due <= now && (index == SIZE_MAX || due < m_entries[index].stats.nextDueUs)) index = i;
+		}
+		if (index == SIZE_MAX) {
+			updateNextDueLocked();
+			return;
+		}
+
+		auto& entry = m_entries[index];
+		service = entry.service;
+		check = entry.check;
+		restart = entry.stats.restartPending;
+		entry.stats.nextDueUs = INT64_MAX; // Rescheduled when the run finishes
+		updateNextDueLocked();
+	}
+
+	if (restart) {
+		bool const ok = ServiceRegistry::getInstance().restartService(service->getServiceId());
+		uint32_t attempt;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto& stats = m_entries[index].stats;
+			int64_t const done = esp_timer_get_time();
+			if (ok) {
+				stats.restarts++;
+				stats.restartPending = false;
+				// With a check, the backoff only resets once the check passes again
+				if (!stats.intervalMs) stats.consecutiveFailures = 0;
+				stats.nextDueUs = stats.intervalMs ? done + static_cast<int64_t>(stats.intervalMs) * 1000 : INT64_MAX;
+			} else {
+				stats.failures++;
+				stats.consecutiveFailures++;
+				stats.nextDueUs = done + backoffUs(stats.consecutiveFailures);
+			}
+			attempt = stats.consecutiveFailures;
+			updateNextDueLocked();
+		}
+		if (ok) {
+			Log::info(TAG, "Restarted '%s'", service->getServiceId().c_str());
+		} else {
+			Log::warn(TAG, "Restart of '%s' failed, next attempt in %lld s", service->getServiceId().c_str(), (long long)(backoffUs(attempt) / 1000000));
+		}
+		return;
+	}
+
+	// Stopped on purpose, or a lazy service that went idle
+	bool const skip = service && !service->isRunning();
+
+	int64_t const start = esp_timer_get_time();
+	bool const ok = skip || (service ? service->onHealthCheck() : check());
+	int64_t const end = esp_timer_get_time();
+	uint32_t const us = static_cast<uint32_t>(end - start);
+
+	CheckStats stats;
+	bool slowest = false;
+	uint32_t failedBefore = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto& entry = m_entries[index];
+		int64_t const intervalUs = static_cast<int64_t>(entry.stats.intervalMs) * 1000;
+		entry.stats.nextDueUs = end + intervalUs;
+		if (!skip) {
+			entry.stats.runs++;
+			entry.stats.lastUs = us;
+			slowest = us > entry.stats.maxUs;
+			entry.stats.maxUs = std::max(entry.stats.maxUs, us);
+			entry.stats.totalUs += us;
+			if (us > entry.stats.budgetUs) entry.stats.overBudget++;
+			entry.stats.lastOk = ok;
+			failedBefore = entry.stats.consecutiveFailures;
+			if (ok) {
+				entry.stats.consecutiveFailures = 0;
+			} else {
+				entry.stats.failures++;
+				entry.stats.consecutiveFailures++;
+				if (entry.autoRestart) {
+					entry.stats.restartPending = true;
+					entry.stats.nextDueUs = end + backoffUs(entry.stats.consecutiveFailures);
+				}
+			}
+		}
+		stats = entry.stats;
+		updateNextDueLocked();
+	}
+
+	if (skip) return;
+	// Warn on the first overrun and on each new worst time, not on every run
+	if (us > stats.budgetUs && (stats.overBudget == 1 || slowest)) {
+		Log::warn(TAG, "Health check '%s' took %lu us (budget %lu us)", stats.name.c_str(), (unsigned long)us, (unsigned long)stats.budgetUs);
+	}
+	// Same for failures: the first, then 2, 4, 8... in a row, and the recovery
+	uint32_t const failed = stats.consecutiveFailures;
+	if (!ok && (failed & (failed - 1)) == 0) {
+		Log::warn(TAG, "Health check '%s' failed (%lu in a row)%s", stats.name.c_str(), (unsigned long)failed, stats.restartPending ? ", restart scheduled" : "");
+	}
+	if (ok && failedBefore > 0) {
+		Log::info(TAG, "Health check '%s' passed after %lu failures", stats.name.c_str(), (unsigned long)failedBefore);
+	}
+}
+
+void HealthMonitor::checkNow() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	int64_t const now = esp_timer_get_time();
+	for (auto& entry: m_entries) {
+		// INT64_MAX with an interval means the check is running right now
+		if (entry.stats.intervalMs && !entry.stats.restartPending && entry.stats.nextDueUs != INT64_MAX) entry.stats.nextDueUs = now;
+	}
+	updateNextDueLocked();
+}
+
+void HealthMonitor::onServiceFailed(std::string_view serviceId) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto& entry: m_entries) {
+		// A failed restart of our own is already pending and counted by tick()
+		if (!entry.autoRestart || entry.stats.restartPending || entry.stats.name != serviceId) continue;
+		// A service that failed by itself backs off like a failed check
+		scheduleRestartLocked(entry, esp_timer_get_time());
+		updateNextDueLocked();
+		return;
+	}
+}
+
+// ──────── Metrics ────────
+
+std::vector<HealthMonitor::CheckStats> HealthMonitor::getStats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::vector<CheckStats> result;
+	result.reserve(m_entries.size());
+	for (const auto& entry: m_entries) result.push_back(entry.stats);
+	return result;
+}
+
+void HealthMonitor::resetStats() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto& entry: m_entries) {
+		auto& stats = entry.stats;
+		stats.runs = stats.overBudget = stats.lastUs = stats.maxUs = stats.failures = stats.restarts = 0;
+		stats.totalUs = 0;
+	}
+}
+
+} // namespace flx::services
@@ -1,19 +1,34 @@
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
 #include <algorithm>
+#include <condition_variable>
+#include <flx/core/BootCache.hpp>
+#include <flx/core/BootTimeline.hpp>
+#include <flx/core/EventBus.hpp>
 #include <flx/core/Logger.hpp>
+#include <flx/core/SystemEvents.hpp>
+#include <flx/core/Trace.hpp>
+#include <flx/kernel/Executor.hpp>
+#include <flx/kernel/TimerWheel.hpp>
 #include <flx/services/ServiceRegistry.hpp>
+#include <mutex>
 #include <queue>
+#include <string_view>
 #include <unordered_set>
 
 static constexpr const char* TAG = "ServiceRegistry";
 
+static constexpr const char* BOOT_ORDER_CACHE_KEY = "services.order";
+
+// Idle lazy services are looked for this often; stops can run a sweep late
+static constexpr uint32_t IDLE_SWEEP_MS = 5000;
+static constexpr uint32_t IDLE_SWEEP_SLACK_MS = 2000;
+
 namespace flx::services {
 
-// Event names for service lifecycle
-namespace Events {
-static constexpr const char* SERVICE_STARTED = "service.started";
-static constexpr const char* SERVICE_STOPPED = "service.stopped";
-static constexpr const char* SERVICE_FAILED = "service.failed";
-} // namespace Events
+// Service lifecycle event names are shared with the typed channels in Core
+namespace Events = flx::core::Events;
 
 void ServiceRegistry::addService(std::shared_ptr<IService> service) {
 	if (!service) return;
@@ -23,6 +38,11 @@ void ServiceRegistry::addService(std::shared_ptr<IService> service) {
 		Log::warn(TAG, "Service '%s' already registered, ignoring", id.c_str());
 		return;
 	}
+	// Lifecycle events carry the id in a fixed-size typed payload
+	if (id.size() > flx::core::MAX_SERVICE_ID_LENGTH) {
+		Log::error(TAG, "Service id '%s' is longer than %zu chars, ignoring", id.c_str(), flx::core::MAX_SERVICE_ID_LENGTH);
+		return;
+	}
 
 	Log::info(TAG, "Registered service: %s (%s)", service->getManifest().serviceName.c_str(), id.c_str());
 
@@ -100,13 +120,63 @@ std::vector<std::string> ServiceRegistry::topologicalSort() const {
 	return result;
 }
 
+// ──────── Cached Boot Order ────────
+
+std::vector<std::string> ServiceRegistry::resolveBootOrder() const {
+	// FNV-1a over everything topologicalSort() reads
+	uint32_t hash = 2166136261u;
+	auto mix = [&hash](std::string_view text) {
+		for (char c: text) hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+		hash = (hash ^ 0xFFu) * 16777619u;
+	};
+	for (const auto& svc: m_services) {
+		const auto& manifest = svc->getManifest();
+		mix(manifest.serviceId);
+		mix(std::to_string(manifest.priority));
+		for (const auto& dep: manifest.dependencies) mix(dep);
+	}
+	char signature[9];
+	snprintf(signature, sizeof(signature), "%08lx", (unsigned long)hash);
+
+	// Cached as "<signature> id,id,..."
+	auto& cache = flx::core::BootCache::getInstance();
+	std::string cached;
+	if (cache.get(BOOT_ORDER_CACHE_KEY, cached) && cached.compare(0, 9, std::string(signature) + " ") == 0) {
+		std::vector<std::string> order;
+		std::unordered_set<std::string> seen;
+		size_t pos = 9;
+		while (pos <= cached.size()) {
+			size_t const comma = std::min(cached.find(',', pos), cached.size());
+			std::string id = cached.substr(pos, comma - pos);
+			if (!m_serviceMap.count(id) || !seen.insert(id).second) break;
+			order.push_back(std::move(id));
+			pos = comma + 1;
+		}
+		if (order.size() == m_services.size()) {
+			Log::info(TAG, "Boot order from cache (%s)", signature);
+			return order;
+		}
+	}
+
+	std::vector<std::string> order = topologicalSort();
+	if (order.size() == m_services.size()) {
+		std::string value = signature;
+		for (size_t i = 0; i < order.size(); i++) value += (i ? "," : " ") + order[i];
+		cache.put(BOOT_ORDER_CACHE_KEY, value);
+	}
+	return order;
+}
+
 // ──────── Lifecycle ────────
 
 bool ServiceRegistry::startAll(bool guiMode) {
+	FLX_TRACE_SCOPE("ServiceRegistry::startAll");
 	Log::info(TAG, "Starting all services (%zu registered, guiMode=%s)...", m_services.size(), guiMode ? "true" : "false");
 
-	m_bootOrder = topologicalSort();
-	m_requiredFailed = false;
+	m_bootOrder = resolveBootOrder();
+	m_bootTimeline.clear();
+	m_guiMode = guiMode;
+	m_requiredFailed.store(false, std::memory_order_release);
 
 	Log::info(TAG, "Boot order resolved:");
 	for (size_t i = 0; i < m_bootOrder.size(); i++) {
@@ -114,52 +184,246 @@ bool ServiceRegistry::startAll(bool guiMode) {
 		Log::info(TAG, "  [%zu] %s (priority=%d, required=%s, gui=%s)", i, m_bootOrder[i].c_str(), svc->getManifest().priority, svc->getManifest().required ? "yes" : "no", svc->getManifest().guiRequired ? "yes" : "no");
 	}
 
-	int started = 0;
-	int skipped = 0;
-	int failed = 0;
+	int64_t const bootStartUs = esp_timer_get_time();
+#if CONFIG_FLXOS_PARALLEL_SERVICE_START
+	BootCounts const counts = startParallel(guiMode, bootStartUs);
+#else
+	BootCounts const counts = startSerial(guiMode, bootStartUs);
+#endif
+	int64_t const totalUs = esp_timer_get_time() - bootStartUs;
+
+	Log::info(TAG, "Service startup complete: %d started, %d skipped, %d failed in %lld ms", counts.started, counts.skipped, counts.failed, (long long)(totalUs / 1000));
+	resolveCriticalPath(totalUs);
+
+	bool const idleStops = std::any_of(m_services.begin(), m_services.end(), [](const auto& svc) {
+		return svc->getManifest().lazy && svc->getManifest().idleStopMs > 0;
+	});
+	if (idleStops && m_idleTimer == flx::kernel::TimerWheel::INVALID_TIMER) {
+		// Stopping a service can block; the wheel's callback only hands the sweep off
+		auto& wheel = flx::kernel::TimerWheel::getInstance();
+		m_idleTimer = wheel.create("svc_idle", []() { flx::kernel::Executor::getInstance().post([]() { ServiceRegistry::getInstance().stopIdleServices(); }); }, IDLE_SWEEP_SLACK_MS);
+		wheel.startPeriodic(m_idleTimer, IDLE_SWEEP_MS);
+	}
+
+	return !hasRequiredFailure();
+}
+
+bool ServiceRegistry::skipAtBoot(const ServiceManifest& manifest, bool guiMode) const {
+	if (!manifest.autoStart) {
+		Log::info(TAG, "Skipping '%s' (autoStart=false)", manifest.serviceId.c_str());
+		return true;
+	}
+	if (manifest.guiRequired && !guiMode) {
+		Log::info(TAG, "Skipping '%s' (guiRequired, headless mode)", manifest.serviceId.c_str());
+		return true;
+	}
+	if (manifest.lazy) {
+		Log::info(TAG, "Deferring '%s' (lazy)", manifest.serviceId.c_str());
+		return true;
+	}
+	return false;
+}
+
+bool ServiceRegistry::bootService(const std::shared_ptr<IService>& svc, int64_t bootStartUs, ServiceBootRecord& record) {
+	const auto& manifest = svc->getManifest();
+
+	// A lazy dependency starts with its first eager dependent
+	for (const auto& dep: manifest.dependencies) {
+		auto it = m_serviceMap.find(dep);
+		if (it != m_serviceMap.end() && it->second->getManifest().lazy) activate(dep);
+	}
+
+	Log::info(TAG, "Starting service: %s...", manifest.serviceName.c_str());
+
+	record.serviceId = manifest.serviceId;
+	record.core = static_cast<int>(xPortGetCoreID());
+	record.startUs = esp_timer_get_time() - bootStartUs;
+	record.ok = svc->start();
+	record.endUs = esp_timer_get_time() - bootStartUs;
+	flx::core::BootTimeline::record(manifest.serviceId.c_str(), bootStartUs + record.startUs, bootStartUs + record.endUs);
+
+	if (record.ok) {
+		Log::info(TAG, "  ✓ %s started", manifest.serviceName.c_str());
+		publishServiceEvent(Events::SERVICE_STARTED, manifest.serviceId);
+		return true;
+	}
+
+	Log::error(TAG, "  ✗ %s FAILED to start", manifest.serviceName.c_str());
+	publishServiceEvent(Events::SERVICE_FAILED, manifest.serviceId);
+	if (manifest.required) {
+		Log::error(TAG, "CRITICAL: Required service '%s' failed — triggering safe mode", manifest.serviceId.c_str());
+		m_requiredFailed.store(true, std::memory_order_release);
+	}
+	return false;
+}
+
+ServiceRegistry::BootCounts ServiceRegistry::startSerial(bool guiMode, int64_t bootStartUs) {
+	BootCounts counts;
 
 	for (const auto& id: m_bootOrder) {
 		auto it = m_serviceMap.find(id);
 		if (it == m_serviceMap.end()) continue;
 
-		auto& svc = it->second;
-		const auto& manifest = svc->getManifest();
-
-		// Skip non-autostart services
-		if (!manifest.autoStart) {
-			Log::info(TAG, "Skipping '%s' (autoStart=false)", id.c_str());
-			skipped++;
+		if (skipAtBoot(it->second->getManifest(), guiMode)) {
+			counts.skipped++;
 			continue;
 		}
 
-		// Skip GUI-required services if not in GUI mode
-		if (manifest.guiRequired && !guiMode) {
-			Log::info(TAG, "Skipping '%s' (guiRequired, headless mode)", id.c_str());
-			skipped++;
-			continue;
+		ServiceBootRecord record;
+		record.readyUs = esp_timer_get_time() - bootStartUs;
+		if (bootService(it->second, bootStartUs, record)) {
+			counts.started++;
+		} else {
+			counts.failed++;
 		}
+		m_bootTimeline.push_back(std::move(record));
+	}
 
-		Log::info(TAG, "Starting service: %s...", manifest.serviceName.c_str());
+	return counts;
+}
 
-		if (svc->start()) {
-			Log::info(TAG, "  ✓ %s started", manifest.serviceName.c_str());
-			publishServiceEvent(Events::SERVICE_STARTED, id);
-			started++;
-		} else {
-			Log::error(TAG, "  ✗ %s FAILED to start", manifest.serviceName.c_str());
-			publishServiceEvent(Events::SERVICE_FAILED, id);
-			failed++;
+ServiceRegistry::BootCounts ServiceRegistry::startParallel(bool guiMode, int64_t bootStartUs) {
+	// Same dependency semantics as the serial loop: a dependency that failed
+	// or was skipped still releases its dependents
+	struct Node {
+		std::shared_ptr<IService> service;
+		std::vector<size_t> dependents;
+		size_t pending = 0;
+	};
 
-			if (manifest.required) {
-				Log::error(TAG, "CRITICAL: Required service '%s' failed — triggering safe mode", id.c_str());
-				m_requiredFailed = true;
+	size_t const count = m_bootOrder.size();
+	std::unordered_map<std::string, size_t> index;
+	for (size_t i = 0; i < count; i++) index[m_bootOrder[i]] = i;
+
+	std::vector<Node> nodes(count);
+	for (size_t i = 0; i < count; i++) {
+		nodes[i].service = m_serviceMap.at(m_bootOrder[i]);
+		for (const auto& dep: nodes[i].service->getManifest().dependencies) {
+			auto it = index.find(dep);
+			if (it == index.end()) continue;
+			nodes[it->second].dependents.push_back(i);
+			nodes[i].pending++;
+		}
+	}
+
+	// Lowest priority value first, then boot order, among services that are ready
+	struct Ready {
+		int priority;
+		size_t node;
+		bool operator>(const Ready& o) const { return priority != o.priority ? priority > o.priority : node > o.node; }
+	};
+	std::priority_queue<Ready, std::vector<Ready>, std::greater<Ready>> ready;
+
+	std::vector<ServiceBootRecord> records(count);
+	std::vector<bool> attempted(count, false);
+	BootCounts counts;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	size_t settled = 0;
+	size_t inFlight = 0;
+
+	// Caller holds mutex
+	auto settle = [&](size_t node) {
+		settled++;
+		int64_t const now = esp_timer_get_time() - bootStartUs;
+		for (size_t dependent: nodes[node].dependents) {
+			if (--nodes[dependent].pending == 0) {
+				records[dependent].readyUs = now;
+				ready.push({nodes[dependent].service->getManifest().priority, dependent});
 			}
 		}
+	};
+
+	for (size_t i = 0; i < count; i++) {
+		if (nodes[i].pending == 0) ready.push({nodes[i].service->getManifest().priority, i});
 	}
 
-	Log::info(TAG, "Service startup complete: %d started, %d skipped, %d failed", started, skipped, failed);
+	// Keep no more in flight than there are workers, so priority still decides
+	// who goes next instead of the executor's queue order
+	auto& executor = flx::kernel::Executor::getInstance();
+	std::unique_lock<std::mutex> lock(mutex);
+	while (settled < count) {
+		std::vector<size_t> launch;
+		while (!ready.empty() && inFlight < flx::kernel::Executor::MAX_WORKERS) {
+			size_t const node = ready.top().node;
+			ready.pop();
+			if (skipAtBoot(nodes[node].service->getManifest(), guiMode)) {
+				counts.skipped++;
+				settle(node);
+				continue;
+			}
+			attempted[node] = true;
+			inFlight++;
+			launch.push_back(node);
+		}
+
+		if (launch.empty()) {
+			cv.wait(lock);
+			continue;
+		}
+
+		// Unlocked: before Executor::start() a posted job runs inline on this task
+		lock.unlock();
+		for (size_t node: launch) {
+			executor.post([&, node]() {
+				bool const ok = bootService(nodes[node].service, bootStartUs, records[node]);
+				std::lock_guard<std::mutex> done(mutex);
+				if (ok) {
+					counts.started++;
+				} else {
+					counts.failed++;
+				}
+				inFlight--;
+				settle(node);
+				cv.notify_one();
+			});
+		}
+		lock.lock();
+	}
+	lock.unlock();
+
+	for (size_t i = 0; i < count; i++) {
+		if (attempted[i]) m_bootTimeline.push_back(std::move(records[i]));
+	}
+	std::sort(m_bootTimeline.begin(), m_bootTimeline.end(), [](const ServiceBootRecord& a, const ServiceBootRecord& b) {
+		return a.startUs < b.startUs;
+	});
+
+	return counts;
+}
+
+void ServiceRegistry::resolveCriticalPath(int64_t totalUs) {
+	if (m_bootTimeline.empty()) return;
 
-	return !m_requiredFailed;
+	std::unordered_map<std::string, size_t> byId;
+	for (size_t i = 0; i < m_bootTimeline.size(); i++) byId[m_bootTimeline[i].serviceId] = i;
+
+	// A service's gate is whichever of its started dependencies finished last
+	std::vector<int> gate(m_bootTimeline.size(), -1);
+	for (size_t i = 0; i < m_bootTimeline.size(); i++) {
+		auto& record = m_bootTimeline[i];
+		for (const auto& dep: m_serviceMap.at(record.serviceId)->getManifest().dependencies) {
+			auto it = byId.find(dep);
+			if (it == byId.end()) continue;
+			if (gate[i] < 0 || m_bootTimeline[it->second].endUs > m_bootTimeline[gate[i]].endUs) gate[i] = static_cast<int>(it->second);
+		}
+		if (gate[i] >= 0) record.gatedBy = m_bootTimeline[gate[i]].serviceId;
+	}
+
+	// Walk back from the service that finished last
+	size_t last = 0;
+	for (size_t i = 1; i < m_bootTimeline.size(); i++) {
+		if (m_bootTimeline[i].endUs > m_bootTimeline[last].endUs) last = i;
+	}
+	std::vector<size_t> path;
+	for (int i = static_cast<int>(last); i >= 0; i = gate[i]) path.push_back(static_cast<size_t>(i));
+
+	Log::info(TAG, "Critical path (%lld of %lld ms):", (long long)(m_bootTimeline[last].endUs / 1000), (long long)(totalUs / 1000));
+	for (auto it = path.rbegin(); it != path.rend(); ++it) {
+		const auto& record = m_bootTimeline[*it];
+		Log::info(TAG, "  %-28s ready %5lld  start %5lld  end %5lld ms (core %d)", record.serviceId.c_str(), (long long)(record.readyUs / 1000), (long long)(record.startUs / 1000), (long long)(record.endUs / 1000), record.core);
+	}
 }
 
 void ServiceRegistry::initGuiServices() {
@@ -216,6 +480,11 @@ bool ServiceRegistry::startService(const std::string& serviceId) {
 	}
 
 	if (svc->start()) {
+		if (svc->getManifest().lazy) {
+			// A start from the CLI or a restart is a use, or the next idle sweep stops it again
+			std::lock_guard<std::recursive_mutex> lock(m_lazyMutex);
+			touchLocked(serviceId);
+		}
 		publishServiceEvent(Events::SERVICE_STARTED, serviceId);
 		return true;
 	}
@@ -247,11 +516,104 @@ bool ServiceRegistry::restartService(const std::string& serviceId) {
 	return startService(serviceId);
 }
 
+// ──────── Lazy Activation ────────
+
+bool ServiceRegistry::activate(const std::string& serviceId) {
+	auto it = m_serviceMap.find(serviceId);
+	if (it == m_serviceMap.end()) return false;
+
+	std::lock_guard<std::recursive_mutex> lock(m_lazyMutex);
+	touchLocked(serviceId);
+	if (it->second->isRunning()) return true;
+
+	// Eager services that are down failed or were stopped on purpose
+	const auto& manifest = it->second->getManifest();
+	if (!manifest.lazy || !manifest.autoStart || (manifest.guiRequired && !m_guiMode)) return false;
+
+	Log::info(TAG, "Starting lazy service: %s", manifest.serviceName.c_str());
+	return startService(serviceId);
+}
+
+void ServiceRegistry::touchLocked(const std::string& serviceId) {
+	m_lazyUse[serviceId].lastUseUs = esp_timer_get_time();
+}
+
+bool ServiceRegistry::retainService(const std::string& serviceId) {
+	std::lock_guard<std::recursive_mutex> lock(m_lazyMutex);
+	if (!activate(serviceId)) return false;
+	m_lazyUse[serviceId].refs++;
+	return true;
+}
+
+void ServiceRegistry::releaseService(const std::string& serviceId) {
+	std::lock_guard<std::recursive_mutex> lock(m_lazyMutex);
+	auto it = m_lazyUse.find(serviceId);
+	if (it == m_lazyUse.end() || it->second.refs == 0) return;
+	it->second.refs--;
+	it->second.lastUseUs = esp_timer_get_time();
+}
+
+void ServiceRegistry::onTopicSubscribed(const std::string& event) {
+	// "wifi.*" covers every topic under "wifi."
+	bool const wildcard = event.size() >= 2 && event.compare(event.size() - 2, 2, ".*") == 0;
+	std::string_view const prefix = wildcard ? std::string_view(event).substr(0, event.size() - 1) : std::string_view {};
+
+	for (const auto& svc: m_services) {
+		const auto& manifest = svc->getManifest();
+		if (!manifest.lazy || svc->isRunning()) continue;
+
+		bool const publishes = std::any_of(manifest.topics.begin(), manifest.topics.end(), [&](const std::string& topic) {
+			return wildcard ? topic.starts_with(prefix) : topic == event;
+		});
+		if (!publishes) continue;
+
+		// Subscribers are often on the GUI task; do not start services there
+		flx::kernel::Executor::getInstance().post([id = manifest.serviceId]() {
+			ServiceRegistry::getInstance().activate(id);
+		});
+	}
+}
+
+void ServiceRegistry::stopIdleServices() {
+	std::lock_guard<std::recursive_mutex> lock(m_lazyMutex);
+	int64_t const now = esp_timer_get_time();
+	auto& bus = flx::core::EventBus::getInstance();
+
+	for (const auto& svc: m_services) {
+		const auto& manifest = svc->getManifest();
+		if (!manifest.lazy || manifest.idleStopMs == 0 || !svc->isRunning()) continue;
+
+		auto found = m_lazyUse.find(manifest.serviceId);
+		if (found == m_lazyUse.end()) {
+			// Running without a recorded use; start the idle clock now
+			touchLocked(manifest.serviceId);
+			continue;
+		}
+		const LazyUse& use = found->second;
+		if (use.refs > 0 || now - use.lastUseUs < static_cast<int64_t>(manifest.idleStopMs) * 1000) continue;
+
+		auto dependents = findDependents(manifest.serviceId);
+		bool const needed = std::any_of(dependents.begin(), dependents.end(), [this](const std::string& id) {
+			return m_serviceMap.at(id)->isRunning();
+		});
+		bool const listened = std::any_of(manifest.topics.begin(), manifest.topics.end(), [&bus](const std::string& topic) {
+			return bus.hasSubscribers(bus.registerTopic(topic));
+		});
+		if (needed || listened) continue;
+
+		Log::info(TAG, "Stopping idle service: %s (unused for %lld ms)", manifest.serviceName.c_str(), (long long)((now - use.lastUseUs) / 1000));
+		svc->stop();
+		publishServiceEvent(Events::SERVICE_STOPPED, manifest.serviceId);
+	}
+}
+
 // ──────── Queries ────────
 
-std::shared_ptr<IService> ServiceRegistry::getService(const std::string& serviceId) const {
+std::shared_ptr<IService> ServiceRegistry::getService(const std::string& serviceId) {
 	auto it = m_serviceMap.find(serviceId);
-	return (it != m_serviceMap.end()) ? it->second : nullptr;
+	if (it == m_serviceMap.end()) return nullptr;
+	if (it->second->getManifest().lazy) activate(serviceId);
+	return it->second;
 }
 
 ServiceState ServiceRegistry::getServiceState(const std::string& serviceId) const {
@@ -274,8 +636,8 @@ std::vector<std::string> ServiceRegistry::findDependents(const std::string& serv
 
 void ServiceRegistry::performHealthCheck() {
 	for (auto& svc: m_services) {
-		if (svc->isRunning()) {
-			svc->onHealthCheck();
+		if (svc->isRunning() && !svc->onHealthCheck()) {
+			Log::warn(TAG, "Health check failed: %s", svc->getServiceId().c_str());
 		}
 	}
 }
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace flx::system::diagnostics {
+
+/**
+ * @brief Result of a single on-device microbenchmark case
+ */
+struct BenchResult {
+	const char* name; ///< Case name (e.g. "legacy publish(string)")
+	uint32_t iterations; ///< Number of timed operations
+	int64_t totalUs; ///< Wall time for all iterations in microseconds
+	int32_t heapDeltaBytes; ///< Free-heap change across the case (negative = retained)
+
+	/// Average cost of one operation in nanoseconds
+	uint32_t nsPerOp() const {
+		return iterations ? static_cast<uint32_t>((totalUs * 1000) / iterations) : 0;
+	}
+};
+
+/**
+ * @brief Compare EventBus dispatch against the previous linear-scan implementation.
+ *
+ * Both buses are loaded with the same topic mix (one subscriber per topic plus
+ * a wildcard listener) and publish to a single hot topic.
+ */
+std::vector<BenchResult> runEventBusBenchmark(uint32_t iterations);
+
+/**
+ * @brief Compare a Bundle-based publish against a typed EventChannel publish,
+ * with and without a subscribeAll listener forcing the Bundle bridge.
+ */
+std::vector<BenchResult> runEventChannelBenchmark(uint32_t iterations);
+
+/**
+ * @brief Compare Bundle put/get/copy/iterate and retained heap against the
+ * previous unordered_map-based implementation, using a 3-key intent-like payload.
+ * Also times binary encode/decode and zero-copy BundleView lookups of that payload.
+ */
+std::vector<BenchResult> runBundleBenchmark(uint32_t iterations);
+
+/**
+ * @brief Compare the caller-side cost of a synchronous Log::info() against a
+ * deferred capture into the LogBuffer ring and a call rejected by the runtime
+ * level table. The benchmark tag is silenced so no case pays for UART output.
+ */
+std::vector<BenchResult> runLogBenchmark(uint32_t iterations);
+
+/**
+ * @brief Heap state around a task restart storm
+ */
+struct RestartStormResult {
+	const char* mode; ///< How the task's TCB and stack were allocated
+	uint32_t restarts;
+	int64_t totalUs;
+	size_t largestBefore; ///< Largest free internal block before the storm
+	size_t largestAfter;
+	size_t freeBefore; ///< Free internal heap before the storm
+	size_t freeAfter;
+};
+
+/**
+ * @brief Restart one task @p restarts times, the way RestartPolicy::RESTART_TASK
+ * does, once with heap allocation and once from the TaskArena. A small
+ * long-lived allocation is made between restarts to stand in for the rest of
+ * the system, so heap allocation leaves holes the next stack cannot reuse.
+ */
+std::vector<RestartStormResult> runTaskRestartStorm(uint32_t restarts);
+
+} // namespace flx::system::diagnostics
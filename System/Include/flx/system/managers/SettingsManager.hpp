@@ -2,15 +2,15 @@
 
 #include <flx/core/Observable.hpp>
 #include <flx/core/Singleton.hpp>
+#include <flx/kernel/TimerWheel.hpp>
 #include <flx/services/IService.hpp>
 #include <flx/services/ServiceManifest.hpp>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
-#include "esp_timer.h"
-
 namespace flx::system {
 
 class SettingsManager : public flx::Singleton<SettingsManager>, public flx::services::IService {
@@ -36,6 +36,9 @@ public:
 
 private:
 
+	static constexpr uint32_t SAVE_DELAY_MS = 2000; // Debounce after the last change
+	static constexpr uint32_t SAVE_SLACK_MS = 500;
+
 	SettingsManager() = default;
 	~SettingsManager() = default;
 
@@ -45,10 +48,13 @@ private:
 		void* observable;
 	};
 
+	// Services register settings from their own onStart(), which may run
+	// concurrently at boot; the save timer reads the same state
+	std::mutex m_mutex {};
 	std::map<std::string, Setting> m_registeredSettings {};
 	void* m_json_cache = nullptr; // cJSON*
 
-	esp_timer_handle_t m_save_timer = nullptr;
+	flx::kernel::TimerWheel::TimerId m_save_timer = flx::kernel::TimerWheel::INVALID_TIMER;
 };
 
 } // namespace flx::system
@@ -5,6 +5,7 @@
 #include "freertos/task.h"
 #include <cstdint>
 #include <ctime>
+#include <flx/core/Observable.hpp>
 #include <flx/core/Singleton.hpp>
 #include <flx/services/IService.hpp>
 #include <flx/services/ServiceManifest.hpp>
@@ -27,7 +28,8 @@ public:
 	void syncTime();
 	static void setTimeZone(const char* tz);
 
-	bool isSynced() const { return m_is_synced; }
+	bool isSynced() const { return m_synced.get(); }
+	flx::Observable<bool>& getSyncedObservable() { return m_synced; }
 	bool waitForSync(uint32_t timeout_ms = 10000);
 
 	void updateSyncStatus(bool synced);
@@ -37,7 +39,7 @@ private:
 	TimeManager() = default;
 	~TimeManager() = default;
 
-	bool m_is_synced = false;
+	flx::Observable<bool> m_synced {false};
 
 	void setCompileTime();
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <flx/services/IService.hpp>
 #include <flx/services/ServiceManifest.hpp>
 
@@ -15,11 +16,13 @@ public:
 
 	bool onStart() override;
 	void onStop() override;
-	void onHealthCheck() override;
+	bool onHealthCheck() override;
 
 private:
 
 	HalInitService() = default;
+
+	size_t m_reportedErrorDevices = 0; // Only touched by onHealthCheck() (HealthMonitor)
 };
 
 } // namespace flx::system::services
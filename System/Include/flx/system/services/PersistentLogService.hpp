@@ -0,0 +1,130 @@
+#pragma once
+
+#include "esp_log.h"
+#include <cstddef>
+#include <cstdint>
+#include <flx/services/IService.hpp>
+#include <flx/services/ServiceManifest.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace flx::services {
+
+/**
+ * @brief Keeps flx::Log output across reboots in rotating files under /data/logs
+ *
+ * Lines are copied (colour codes stripped) into a RAM staging ring —
+ * PSRAM when present — by a sink on the Log output path. A low-priority
+ * writer task moves the ring to flash one 4 KB flash sector at a time, so
+ * logging tasks never wait on FAT and wear levelling sees whole-sector
+ * writes. Partial sectors are written only after an idle period, on
+ * `logs flush`, and from the esp_restart() shutdown hook.
+ *
+ * The newest lines are also mirrored into a small no-init RAM block that
+ * survives a panic or watchdog reset; it is written to the log on the next
+ * boot.
+ *
+ * Files: log.0 is current; on reaching MAX_FILE_SIZE it rotates to log.1 and
+ * so on, and the oldest of MAX_FILES is deleted.
+ */
+class PersistentLogService : public IService {
+public:
+
+	static constexpr const char* LOG_DIR = "/data/logs";
+	static constexpr size_t SECTOR_SIZE = 4096; ///< Flash erase sector; the unit of a normal flush
+	static constexpr size_t MAX_FILE_SIZE = 64 * 1024;
+	static constexpr int MAX_FILES = 4; ///< Total cap: MAX_FILES * MAX_FILE_SIZE
+	static constexpr uint32_t IDLE_FLUSH_MS = 60 * 1000; ///< Write a partial sector after this long
+
+	struct Stats {
+		size_t capacity; ///< Staging ring size in bytes
+		size_t buffered; ///< Bytes waiting for the writer
+		bool psram;
+		uint32_t bytesAccepted;
+		uint32_t bytesDropped; ///< Lines discarded because the ring was full
+		uint32_t bytesWritten;
+		uint32_t sectorWrites; ///< Full-sector flushes
+		uint32_t partialWrites; ///< Idle, explicit or shutdown flushes
+		uint32_t rotations;
+		uint32_t writeErrors;
+		uint32_t recoveredBytes; ///< Crash tail recovered at boot
+	};
+
+	static PersistentLogService& getInstance();
+
+	// ──── IService manifest ────
+	static const ServiceManifest serviceManifest;
+	const ServiceManifest& getManifest() const override { return serviceManifest; }
+
+	// ──── IService lifecycle ────
+	bool onStart() override;
+	void onStop() override;
+	bool onHealthCheck() override;
+
+	// ──── Log access ────
+
+	/** Write everything buffered now. Blocks the caller on FAT. */
+	bool flush();
+
+	/** Print the last @p lines lines (files and RAM) to stdout */
+	void tail(size_t lines);
+
+	/**
+	 * Concatenate all log files, oldest first, plus buffered lines.
+	 * @param path Destination file, or empty for stdout
+	 */
+	bool exportTo(const std::string& path);
+
+	/** Delete all log files and drop buffered lines */
+	void clear();
+
+	Stats getStats() const;
+
+	/** Path of rotation slot @p index (0 = current) */
+	static std::string filePath(int index);
+
+private:
+
+	class WriterTask;
+
+	PersistentLogService() = default;
+	~PersistentLogService() = default;
+	PersistentLogService(const PersistentLogService&) = delete;
+	PersistentLogService& operator=(const PersistentLogService&) = delete;
+
+	static void sink(esp_log_level_t level, const char* line);
+	void append(const char* line);
+	void appendRaw(const char* data, size_t len);
+
+	/** Write up to @p maxBytes from the ring; only commits what reached flash */
+	bool writeChunk(size_t maxBytes);
+	bool rotateIfNeeded(size_t incoming);
+	void recoverCrashTail();
+	void writerLoop(WriterTask& task);
+	std::string bufferedText() const;
+
+	uint8_t* m_ring = nullptr;
+	size_t m_capacity = 0;
+	size_t m_head = 0; // Next write offset
+	size_t m_size = 0; // Bytes buffered
+	bool m_psram = false;
+	mutable std::mutex m_bufMutex; // Held only for memcpy; never across FAT calls
+	std::mutex m_fileMutex; // Serialises writers (task, CLI, shutdown hook)
+
+	std::unique_ptr<WriterTask> m_writer;
+	int64_t m_lastWriteUs = 0;
+	bool m_shutdownHooked = false;
+
+	// Guarded by m_bufMutex
+	uint32_t m_bytesAccepted = 0;
+	uint32_t m_bytesDropped = 0;
+	uint32_t m_bytesWritten = 0;
+	uint32_t m_sectorWrites = 0;
+	uint32_t m_partialWrites = 0;
+	uint32_t m_rotations = 0;
+	uint32_t m_writeErrors = 0;
+	uint32_t m_recoveredBytes = 0;
+};
+
+} // namespace flx::services
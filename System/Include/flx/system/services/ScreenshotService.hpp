@@ -1,7 +1,10 @@
 #pragma once
 
 #include "lvgl.h"
+#include <atomic>
 #include <flx/core/Singleton.hpp>
+#include <flx/kernel/Coroutine.hpp>
+#include <flx/kernel/Executor.hpp>
 #include <flx/services/IService.hpp>
 #include <flx/services/ServiceManifest.hpp>
 #include <functional>
@@ -13,7 +16,8 @@ namespace flx::services {
  * @brief Service for capturing screenshots as PNG files.
  *
  * Uses LVGL snapshot API with RGB888 color format and lodepng for PNG encoding.
- * Can be called programmatically from any app or tool.
+ * Can be called programmatically from any app or tool. Only the snapshot
+ * holds GuiLock; PNG encoding runs on the kernel Executor.
  */
 class ScreenshotService : public IService, public flx::Singleton<ScreenshotService> {
 	friend class flx::Singleton<ScreenshotService>;
@@ -32,10 +36,12 @@ public:
 
 	/**
 	 * Capture the active screen and save as PNG.
+	 * The snapshot is taken synchronously; encoding and saving finish on the
+	 * Executor. Do not get() the result while holding GuiLock.
 	 * @param savePath  Full VFS path including filename (e.g. "/data/screenshots/scr_001.png")
-	 * @return true if capture and save succeeded
+	 * @return Future that becomes true if capture and save succeeded
 	 */
-	bool capture(const std::string& savePath);
+	flx::kernel::Future<bool> capture(const std::string& savePath);
 
 	/**
 	 * Generate a timestamped filename in the given directory.
@@ -77,11 +83,11 @@ private:
 	ScreenshotService();
 	~ScreenshotService();
 
-	lv_timer_t* m_timer {nullptr};
-	int m_countdownRemaining {0};
-	std::string m_storagePath;
-	CaptureCallback m_onComplete {nullptr};
-	void onTimerTick();
+	std::atomic<uint32_t> m_generation {0}; // Bumped by cancelCapture() to end a countdown
+
+	/** Overlay countdown on the coroutine runtime, then the capture on the Executor */
+	flx::kernel::co::Task<void> countdown(uint32_t generation, int seconds, std::string storagePath, CaptureCallback onComplete);
+	void captureAndNotify(const std::string& path, CaptureCallback onComplete);
 };
 
 } // namespace flx::services
@@ -3,6 +3,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include <cstdint>
+#include <flx/kernel/ResourceMonitorTask.hpp>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -75,6 +76,7 @@ struct TaskInfo {
 	int coreID {};
 	uint32_t runtime {}; // Runtime counter
 	float cpuUsagePercent {};
+	float cpuPeakPercent {}; // Highest sample in the monitor's history window
 };
 
 class SystemInfoService {
@@ -113,6 +115,12 @@ public:
 	 */
 	std::vector<TaskInfo> getTaskList(size_t maxTasks = 0);
 
+	/**
+	 * Get recent per-task CPU, stack and heap samples from ResourceMonitorTask
+	 * @param maxSamples Most recent samples to return, oldest first (0 for all)
+	 */
+	std::vector<flx::kernel::ResourceMonitorTask::Sample> getTaskHistory(size_t maxSamples = 0);
+
 	/**
 	 * Format bytes to human-readable string (B, KB, MB)
 	 */
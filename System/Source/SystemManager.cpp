@@ -6,10 +6,17 @@
 #include "sdkconfig.h"
 #include "wear_levelling.h"
 #include <flx/connectivity/ConnectivityManager.hpp>
+#include <flx/core/BootCache.hpp>
+#include <flx/core/BootTimeline.hpp>
 #include <flx/core/EventBus.hpp>
 #include <flx/core/Logger.hpp>
+#include <flx/core/SystemEvents.hpp>
+#include <flx/kernel/EventDispatcherTask.hpp>
+#include <flx/kernel/Executor.hpp>
+#include <flx/kernel/LogDrainTask.hpp>
 #include <flx/kernel/ResourceMonitorTask.hpp>
 #include <flx/kernel/TaskManager.hpp>
+#include <flx/services/HealthMonitor.hpp>
 #include <flx/services/ServiceRegistry.hpp>
 #include <flx/system/SystemManager.hpp>
 #include <flx/system/managers/DisplayManager.hpp>
@@ -22,6 +29,7 @@
 #endif
 #include <flx/system/services/DeviceProfileService.hpp>
 #include <flx/system/services/HalInitService.hpp>
+#include <flx/system/services/PersistentLogService.hpp>
 #if !CONFIG_FLXOS_HEADLESS_MODE
 #include <flx/system/managers/NotificationManager.hpp>
 #include <flx/system/services/ScreenshotService.hpp>
@@ -45,6 +53,7 @@ extern "C" esp_err_t flx_profile_hwd_init(void);
 namespace flx::system {
 
 esp_err_t SystemManager::initHardware() {
+	flx::core::BootPhase phase("initHardware");
 	Log::info(TAG, "Starting hardware initialization...");
 	esp_err_t err = nvs_flash_init();
 	if (err == ESP_ERR_NVS_NO_FREE_PAGES ||
@@ -63,10 +72,14 @@ esp_err_t SystemManager::initHardware() {
 		m_isSafeMode = true;
 	} else {
 		Log::info(TAG, "System storage mounted successfully");
+		flx::core::BootCache::getInstance().load(flx::config::profile.id);
 	}
 
 	flx::kernel::TaskManager::getInstance().initWatchdog();
 	flx::kernel::ResourceMonitorTask::getInstance().start();
+	flx::kernel::EventDispatcherTask::getInstance().start();
+	flx::kernel::LogDrainTask::getInstance().start();
+	flx::kernel::Executor::getInstance().start();
 
 	return ESP_OK;
 }
@@ -80,9 +93,23 @@ void SystemManager::registerServices() {
 
 	// Decoupled event publishing
 	registry.setEventCallback([](const char* event, const std::string& serviceId) {
-		flx::core::Bundle data;
-		data.putString("serviceId", serviceId);
-		flx::core::EventBus::getInstance().publish(event, data);
+		std::string_view const name = event;
+		if (name == flx::core::Events::SERVICE_STARTED) {
+			flx::core::publishServiceEvent<flx::core::ServiceStarted>(serviceId);
+		} else if (name == flx::core::Events::SERVICE_STOPPED) {
+			flx::core::publishServiceEvent<flx::core::ServiceStopped>(serviceId);
+		} else if (name == flx::core::Events::SERVICE_FAILED) {
+			flx::core::publishServiceEvent<flx::core::ServiceFailed>(serviceId);
+		} else {
+			flx::core::Bundle data;
+			data.putString("serviceId", serviceId);
+			flx::core::EventBus::getInstance().publish(event, data);
+		}
+	});
+
+	// Lazy services start when something subscribes to the topics they publish
+	flx::core::EventBus::getInstance().setSubscribeHook([](const std::string& event) {
+		flx::services::ServiceRegistry::getInstance().onTopicSubscribed(event);
 	});
 
 	// Core managers (as shared_ptr wrapping the singletons — prevent deletion)
@@ -96,6 +123,7 @@ void SystemManager::registerServices() {
 	registry.addService(std::shared_ptr<flx::services::IService>(&PowerManager::getInstance(), noDelete));
 	registry.addService(std::shared_ptr<flx::services::IService>(&TimeManager::getInstance(), noDelete));
 	registry.addService(std::shared_ptr<flx::services::IService>(&flx::services::DeviceProfileService::getInstance(), noDelete));
+	registry.addService(std::shared_ptr<flx::services::IService>(&flx::services::PersistentLogService::getInstance(), noDelete));
 
 #if FLXOS_SD_CARD_ENABLED
 	registry.addService(std::shared_ptr<flx::services::IService>(&flx::services::SdCardService::getInstance(), noDelete));
@@ -108,6 +136,7 @@ void SystemManager::registerServices() {
 }
 
 esp_err_t SystemManager::initServices() {
+	flx::core::BootPhase phase("initServices");
 	Log::info(TAG, "Registering services with ServiceRegistry...");
 	registerServices();
 
@@ -126,11 +155,16 @@ esp_err_t SystemManager::initServices() {
 	}
 
 	registry.dumpServiceStates();
+	if (!m_isSafeMode) flx::core::BootCache::getInstance().save();
+	flx::services::HealthMonitor::getInstance().start();
 	Log::info(TAG, "Services initialized via ServiceRegistry");
 	return ESP_OK;
 }
 
 void SystemManager::mount_storage_helper(const char* p, const char* l, wl_handle_t* h, bool f) {
+	char phaseName[flx::core::BootTimeline::NAME_LEN];
+	snprintf(phaseName, sizeof(phaseName), "mount %s", p);
+	flx::core::BootPhase phase(phaseName);
 	Log::info(TAG, "Mounting %s...", p);
 	esp_vfs_fat_mount_config_t const cfg = {
 		.format_if_mount_failed = f,
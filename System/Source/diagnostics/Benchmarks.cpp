@@ -0,0 +1,452 @@
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <flx/core/BundleCodec.hpp>
+#include <flx/core/EventBus.hpp>
+#include <flx/core/EventChannel.hpp>
+#include <flx/core/LogBuffer.hpp>
+#include <flx/core/LogLevels.hpp>
+#include <flx/core/Logger.hpp>
+#include <flx/kernel/TaskManager.hpp>
+#include <flx/system/diagnostics/Benchmarks.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flx::system::diagnostics {
+
+namespace {
+
+constexpr int BENCH_TOPIC_COUNT = 32;
+
+/**
+ * Times @p iterations calls of @p op and records the heap delta.
+ */
+template<typename Op>
+BenchResult measure(const char* name, uint32_t iterations, Op&& op) {
+	uint32_t heapBefore = esp_get_free_heap_size();
+	int64_t t0 = esp_timer_get_time();
+	for (uint32_t i = 0; i < iterations; i++) {
+		op(i);
+	}
+	int64_t elapsed = esp_timer_get_time() - t0;
+	int32_t heapDelta = static_cast<int32_t>(esp_get_free_heap_size()) - static_cast<int32_t>(heapBefore);
+	return {name, iterations, elapsed, heapDelta};
+}
+
+/**
+ * Faithful copy of the pre-interning EventBus dispatch path:
+ * linear scan with string compare and a callback vector copy per publish.
+ */
+class LegacyEventBus {
+public:
+
+	using Callback = flx::core::EventBus::Callback;
+
+	void subscribe(const std::string& event, Callback callback) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_subscriptions.push_back({event, std::move(callback)});
+	}
+
+	void publish(const std::string& event, const flx::core::Bundle& data) {
+		std::vector<Callback> toNotify;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (const auto& sub: m_subscriptions) {
+				if (sub.event.empty() || sub.event == event) {
+					toNotify.push_back(sub.callback);
+				}
+			}
+		}
+		for (const auto& cb: toNotify) {
+			if (cb) cb(event, data);
+		}
+	}
+
+private:
+
+	struct Subscription {
+		std::string event;
+		Callback callback;
+	};
+
+	std::vector<Subscription> m_subscriptions;
+	std::mutex m_mutex;
+};
+
+std::string benchTopicName(int index) {
+	char buf[40];
+	std::snprintf(buf, sizeof(buf), "bench.eventbus.topic%02d", index);
+	return buf;
+}
+
+/// Payload shaped like the app lifecycle events
+struct BenchChannelEvent {
+	static constexpr const char* TOPIC = "bench.channel";
+	char appId[64];
+
+	void toBundle(flx::core::Bundle& out) const { out.putString("appId", appId); }
+};
+
+/**
+ * Copy of the previous Bundle layout: node-based map whose Value always
+ * carries a string, a vector and a unique_ptr next to the scalar union.
+ */
+class LegacyBundle {
+public:
+
+	LegacyBundle() = default;
+	LegacyBundle(const LegacyBundle& other) : m_entries(other.m_entries) {}
+
+	void putInt32(const std::string& key, int32_t value) {
+		Value v;
+		v.type = 1;
+		v.valueInt32 = value;
+		m_entries[key] = std::move(v);
+	}
+
+	void putString(const std::string& key, const std::string& value) {
+		Value v;
+		v.type = 4;
+		v.valueString = value;
+		m_entries[key] = std::move(v);
+	}
+
+	int32_t getInt32(const std::string& key) const {
+		auto it = m_entries.find(key);
+		return it != m_entries.end() ? it->second.valueInt32 : 0;
+	}
+
+	std::string getString(const std::string& key) const {
+		auto it = m_entries.find(key);
+		return it != m_entries.end() ? it->second.valueString : "";
+	}
+
+	std::vector<std::string> keys() const {
+		std::vector<std::string> result;
+		result.reserve(m_entries.size());
+		for (const auto& [key, _]: m_entries) {
+			result.push_back(key);
+		}
+		return result;
+	}
+
+private:
+
+	struct Value {
+		uint8_t type = 0;
+		union {
+			bool valueBool;
+			int32_t valueInt32;
+			int64_t valueInt64;
+			float valueFloat;
+		};
+		std::string valueString;
+		std::vector<uint8_t> valueBlob;
+		std::unique_ptr<LegacyBundle> valueBundle;
+
+		Value() : valueInt64(0) {}
+		Value(const Value& other)
+			: type(other.type), valueInt64(other.valueInt64), valueString(other.valueString), valueBlob(other.valueBlob),
+			  valueBundle(other.valueBundle ? std::make_unique<LegacyBundle>(*other.valueBundle) : nullptr) {}
+		Value& operator=(const Value& other) {
+			type = other.type;
+			valueInt64 = other.valueInt64;
+			valueString = other.valueString;
+			valueBlob = other.valueBlob;
+			valueBundle = other.valueBundle ? std::make_unique<LegacyBundle>(*other.valueBundle) : nullptr;
+			return *this;
+		}
+		Value(Value&&) = default;
+		Value& operator=(Value&&) = default;
+	};
+
+	std::unordered_map<std::string, Value> m_entries;
+};
+
+/// Intent-shaped payload: action, a target and a request code
+template<typename B>
+void fillIntentPayload(B& bundle) {
+	bundle.putString("action", "view");
+	bundle.putString("path", "/data/a.png");
+	bundle.putInt32("requestCode", 7);
+}
+
+/**
+ * Heap retained by @p count live bundles of the intent-shaped payload.
+ */
+template<typename B>
+BenchResult measureRetained(const char* name, uint32_t count) {
+	std::vector<B> live;
+	live.reserve(count);
+	uint32_t heapBefore = esp_get_free_heap_size();
+	int64_t t0 = esp_timer_get_time();
+	for (uint32_t i = 0; i < count; i++) {
+		fillIntentPayload(live.emplace_back());
+	}
+	int64_t elapsed = esp_timer_get_time() - t0;
+	int32_t heapDelta = static_cast<int32_t>(esp_get_free_heap_size()) - static_cast<int32_t>(heapBefore);
+	return {name, count, elapsed, heapDelta};
+}
+
+template<typename B>
+void runBundleCases(std::vector<BenchResult>& results, const char* const names[5], uint32_t iterations) {
+	volatile uint32_t sink = 0;
+
+	results.push_back(measure(names[0], iterations, [&](uint32_t) {
+		B bundle;
+		fillIntentPayload(bundle);
+	}));
+
+	B source;
+	fillIntentPayload(source);
+	const std::string actionKey = "action";
+	const std::string codeKey = "requestCode";
+	results.push_back(measure(names[1], iterations, [&](uint32_t) {
+		sink = sink + static_cast<uint32_t>(source.getInt32(codeKey)) + static_cast<uint32_t>(source.getString(actionKey).size());
+	}));
+
+	results.push_back(measure(names[2], iterations, [&](uint32_t) {
+		B copy(source);
+		sink = sink + static_cast<uint32_t>(copy.getInt32(codeKey));
+	}));
+
+	results.push_back(measure(names[3], iterations, [&](uint32_t) {
+		for (const auto& key: source.keys()) {
+			sink = sink + static_cast<uint32_t>(key.size());
+		}
+	}));
+
+	results.push_back(measureRetained<B>(names[4], 64));
+}
+
+} // namespace
+
+std::vector<BenchResult> runEventBusBenchmark(uint32_t iterations) {
+	std::vector<BenchResult> results;
+	std::atomic<uint32_t> delivered {0};
+	auto counter = [&delivered](const std::string&, const flx::core::Bundle&) { delivered.fetch_add(1, std::memory_order_relaxed); };
+
+	const std::string hotTopic = benchTopicName(BENCH_TOPIC_COUNT / 2);
+	const flx::core::Bundle payload;
+
+	// Legacy: one subscriber per topic plus a wildcard ("" = all events)
+	{
+		LegacyEventBus legacy;
+		for (int i = 0; i < BENCH_TOPIC_COUNT; i++) {
+			legacy.subscribe(benchTopicName(i), counter);
+		}
+		legacy.subscribe("", counter);
+		results.push_back(measure("legacy publish(string)", iterations, [&](uint32_t) { legacy.publish(hotTopic, payload); }));
+	}
+
+	// Topic-indexed: same topology, subscriptions removed afterwards
+	auto& bus = flx::core::EventBus::getInstance();
+	std::vector<flx::core::EventBus::SubscriptionId> ids;
+	for (int i = 0; i < BENCH_TOPIC_COUNT; i++) {
+		ids.push_back(bus.subscribe(benchTopicName(i), counter));
+	}
+	ids.push_back(bus.subscribe("bench.eventbus.*", counter));
+
+	results.push_back(measure("indexed publish(string)", iterations, [&](uint32_t) { bus.publish(hotTopic, payload); }));
+
+	const auto topicId = bus.registerTopic(hotTopic);
+	results.push_back(measure("indexed publish(TopicId)", iterations, [&](uint32_t) { bus.publish(topicId, payload); }));
+
+	const auto idleTopic = bus.registerTopic("bench.idle");
+	results.push_back(measure("indexed publish(no subscribers)", iterations, [&](uint32_t) { bus.publish(idleTopic, payload); }));
+
+	for (auto id: ids) {
+		bus.unsubscribe(id);
+	}
+
+	return results;
+}
+
+std::vector<BenchResult> runEventChannelBenchmark(uint32_t iterations) {
+	std::vector<BenchResult> results;
+	std::atomic<uint32_t> delivered {0};
+	const char* appId = "com.flxos.bench";
+
+	auto& bus = flx::core::EventBus::getInstance();
+	auto& channel = flx::core::EventChannel<BenchChannelEvent>::getInstance();
+
+	// Legacy shape: build a Bundle per publish, deliver through the bus
+	auto busSub = bus.subscribe("bench.bundle", [&delivered](const std::string&, const flx::core::Bundle& data) {
+		if (data.hasString("appId")) delivered.fetch_add(1, std::memory_order_relaxed);
+	});
+	const auto bundleTopic = bus.registerTopic("bench.bundle");
+	results.push_back(measure("bundle publish", iterations, [&](uint32_t) {
+		flx::core::Bundle data;
+		data.putString("appId", appId);
+		bus.publish(bundleTopic, data);
+	}));
+	bus.unsubscribe(busSub);
+
+	// Typed channel with a typed subscriber
+	auto chanSub = channel.subscribe([&delivered](const BenchChannelEvent& e) {
+		if (e.appId[0]) delivered.fetch_add(1, std::memory_order_relaxed);
+	});
+
+	// A subscribeAll listener forces the lazy Bundle bridge on every publish
+	auto allSub = bus.subscribeAll([](const std::string&, const flx::core::Bundle&) {});
+	results.push_back(measure("channel publish (subscribeAll bridge)", iterations, [&](uint32_t) {
+		BenchChannelEvent event {};
+		flx::core::copyEventString(event.appId, appId);
+		channel.publish(event);
+	}));
+	bus.unsubscribe(allSub);
+
+	// No Bundle listeners left: the bridge never builds a Bundle
+	results.push_back(measure("channel publish (typed only)", iterations, [&](uint32_t) {
+		BenchChannelEvent event {};
+		flx::core::copyEventString(event.appId, appId);
+		channel.publish(event);
+	}));
+	channel.unsubscribe(chanSub);
+
+	return results;
+}
+
+std::vector<BenchResult> runBundleBenchmark(uint32_t iterations) {
+	static constexpr const char* LEGACY_NAMES[5] = {"legacy put x3", "legacy get x2", "legacy copy", "legacy iterate", "legacy retain (64 live)"};
+	static constexpr const char* COMPACT_NAMES[5] = {"compact put x3", "compact get x2", "compact copy", "compact iterate", "compact retain (64 live)"};
+
+	std::vector<BenchResult> results;
+	runBundleCases<LegacyBundle>(results, LEGACY_NAMES, iterations);
+	runBundleCases<flx::core::Bundle>(results, COMPACT_NAMES, iterations);
+
+	// Binary encoding of the same payload
+	flx::core::Bundle source;
+	fillIntentPayload(source);
+	const auto encoded = flx::core::encodeBundle(source);
+	volatile uint32_t sink = 0;
+
+	results.push_back(measure("binary encode", iterations, [&](uint32_t) {
+		sink = sink + static_cast<uint32_t>(flx::core::encodeBundle(source).size());
+	}));
+	results.push_back(measure("binary decode", iterations, [&](uint32_t) {
+		flx::core::Bundle decoded;
+		flx::core::decodeBundle(encoded.data(), encoded.size(), decoded);
+		sink = sink + static_cast<uint32_t>(decoded.size());
+	}));
+	results.push_back(measure("binary view get x2", iterations, [&](uint32_t) {
+		auto view = flx::core::BundleView::parse(encoded.data(), encoded.size());
+		sink = sink + static_cast<uint32_t>(view.getInt32("requestCode")) + static_cast<uint32_t>(view.getString("action").size());
+	}));
+	return results;
+}
+
+std::vector<BenchResult> runLogBenchmark(uint32_t iterations) {
+	static constexpr const char* BENCH_TAG = "bench_log";
+	using flx::core::LogBuffer;
+
+	// Drained records are filtered by esp_log_write, so nothing reaches the UART
+	esp_log_level_set(BENCH_TAG, ESP_LOG_NONE);
+	const bool wasDeferred = LogBuffer::isDeferred();
+	std::vector<BenchResult> results;
+
+	LogBuffer::setDeferred(false);
+	results.push_back(measure("sync Log::info (format)", iterations, [&](uint32_t i) {
+		Log::info(BENCH_TAG, "value %lu name %s", (unsigned long)i, "wifi");
+	}));
+
+	LogBuffer::setDeferred(true);
+	if (LogBuffer::isDeferred()) {
+		// Time captures in bursts that fit the ring and drain between them, so
+		// the figure is the push cost rather than the drop path
+		static constexpr uint32_t BURST = LogBuffer::RING_CAPACITY / 2;
+		uint32_t heapBefore = esp_get_free_heap_size();
+		int64_t elapsed = 0;
+		for (uint32_t done = 0; done < iterations;) {
+			LogBuffer::drain(LogBuffer::RING_CAPACITY * LogBuffer::MAX_CORES);
+			uint32_t burst = std::min(BURST, iterations - done);
+			int64_t t0 = esp_timer_get_time();
+			for (uint32_t i = 0; i < burst; i++) {
+				Log::info(BENCH_TAG, "value %lu name %s", (unsigned long)(done + i), "wifi");
+			}
+			elapsed += esp_timer_get_time() - t0;
+			done += burst;
+		}
+		int32_t heapDelta = static_cast<int32_t>(esp_get_free_heap_size()) - static_cast<int32_t>(heapBefore);
+		results.push_back({"deferred Log::info (capture)", iterations, elapsed, heapDelta});
+		LogBuffer::drain(LogBuffer::RING_CAPACITY * LogBuffer::MAX_CORES);
+	}
+
+	LogBuffer::setDeferred(wasDeferred);
+
+	// Rejected by the runtime level table before capture or formatting
+	flx::LogLevels::set(BENCH_TAG, ESP_LOG_NONE);
+	results.push_back(measure("filtered Log::info (level table)", iterations, [&](uint32_t i) {
+		Log::info(BENCH_TAG, "value %lu name %s", (unsigned long)i, "wifi");
+	}));
+	flx::LogLevels::set(BENCH_TAG, flx::LogLevels::getDefault());
+	return results;
+}
+
+namespace {
+
+constexpr uint32_t STORM_STACK_SIZE = 2048;
+constexpr size_t STORM_BYSTANDER_BYTES = 64;
+constexpr uint32_t STORM_HEAP_CAPS = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+
+class StormTask : public flx::kernel::Task {
+public:
+
+	explicit StormTask(StackMemory memory) : Task("bench_storm", STORM_STACK_SIZE, 1) {
+		setStackMemory(memory);
+	}
+
+protected:
+
+	void run(void* /*data*/) override {
+		while (!shouldStop()) {
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		}
+	}
+};
+
+RestartStormResult runStormCase(const char* mode, flx::kernel::Task::StackMemory memory, uint32_t restarts) {
+	std::vector<void*> bystanders;
+	bystanders.reserve(restarts);
+	auto task = std::make_unique<StormTask>(memory);
+	task->start();
+	vTaskDelay(1);
+
+	RestartStormResult result {mode, restarts, 0, heap_caps_get_largest_free_block(STORM_HEAP_CAPS), 0, heap_caps_get_free_size(STORM_HEAP_CAPS), 0};
+	int64_t t0 = esp_timer_get_time();
+	for (uint32_t i = 0; i < restarts; i++) {
+		task->stop();
+		bystanders.push_back(heap_caps_malloc(STORM_BYSTANDER_BYTES, STORM_HEAP_CAPS));
+		task->start();
+		vTaskDelay(1); // Let it reach its wait, as a real task would
+	}
+	result.totalUs = esp_timer_get_time() - t0;
+	result.largestAfter = heap_caps_get_largest_free_block(STORM_HEAP_CAPS);
+	result.freeAfter = heap_caps_get_free_size(STORM_HEAP_CAPS);
+
+	task.reset();
+	for (void* p: bystanders) {
+		heap_caps_free(p);
+	}
+	return result;
+}
+
+} // namespace
+
+std::vector<RestartStormResult> runTaskRestartStorm(uint32_t restarts) {
+	using StackMemory = flx::kernel::Task::StackMemory;
+	std::vector<RestartStormResult> results;
+	results.push_back(runStormCase("heap (xTaskCreate)", StackMemory::HEAP, restarts));
+	results.push_back(runStormCase("arena (xTaskCreateStatic)", StackMemory::INTERNAL, restarts));
+	return results;
+}
+
+} // namespace flx::system::diagnostics
@@ -1,10 +1,11 @@
 #include "cJSON.h"
-#include "esp_timer.h"
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <mutex>
 #include <flx/core/Logger.hpp>
 #include <flx/core/Observable.hpp>
+#include <flx/kernel/TimerWheel.hpp>
 #include <flx/system/managers/SettingsManager.hpp>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -30,16 +31,8 @@ const flx::services::ServiceManifest SettingsManager::serviceManifest = {
 bool SettingsManager::onStart() {
 	if (isRunning()) return true;
 
-	esp_timer_create_args_t const timer_args = {
-		.callback = [](void* /*arg*/) {
-			SettingsManager::getInstance().saveSettings();
-		},
-		.arg = nullptr,
-		.dispatch_method = ESP_TIMER_TASK,
-		.name = "settings_save",
-		.skip_unhandled_events = true,
-	};
-	esp_timer_create(&timer_args, &m_save_timer);
+	// A late save costs nothing, so let it share a wake-up with other timers
+	m_save_timer = flx::kernel::TimerWheel::getInstance().create("settings_save", []() { SettingsManager::getInstance().saveSettings(); }, SAVE_SLACK_MS);
 
 	loadSettings();
 	Log::info(TAG, "Settings service started");
@@ -48,12 +41,14 @@ bool SettingsManager::onStart() {
 
 void SettingsManager::onStop() {
 	// Save any pending settings before stopping
-	if (m_save_timer) {
-		esp_timer_stop(m_save_timer);
+	if (m_save_timer != flx::kernel::TimerWheel::INVALID_TIMER) {
+		auto& wheel = flx::kernel::TimerWheel::getInstance();
+		wheel.stop(m_save_timer);
 		saveSettings();
-		esp_timer_delete(m_save_timer);
-		m_save_timer = nullptr;
+		wheel.destroy(m_save_timer);
+		m_save_timer = flx::kernel::TimerWheel::INVALID_TIMER;
 	}
+	std::lock_guard<std::mutex> lock(m_mutex);
 	if (m_json_cache) {
 		cJSON_Delete((cJSON*)m_json_cache);
 		m_json_cache = nullptr;
@@ -62,43 +57,52 @@ void SettingsManager::onStop() {
 }
 
 void SettingsManager::registerSetting(const std::string& key, flx::Observable<int32_t>& observable) {
-	m_registeredSettings[key] = {Setting::Type::INT, &observable};
+	bool cached = false;
+	int32_t value = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_registeredSettings[key] = {Setting::Type::INT, &observable};
+		cJSON* item = m_json_cache ? cJSON_GetObjectItem((cJSON*)m_json_cache, key.c_str()) : nullptr;
+		if (item && cJSON_IsNumber(item)) {
+			cached = true;
+			value = item->valueint;
+		}
+	}
 
 	// Subscribe to changes to trigger save
 	observable.subscribe([this](const int32_t&) {
 		this->triggerSave();
 	});
 
-	// If we have cached JSON, apply the value now
-	if (m_json_cache) {
-		cJSON* item = cJSON_GetObjectItem((cJSON*)m_json_cache, key.c_str());
-		if (item && cJSON_IsNumber(item)) {
-			observable.set(item->valueint);
-		}
-	}
+	// If we have cached JSON, apply the value now (unlocked: observers run inline)
+	if (cached) observable.set(value);
 }
 
 void SettingsManager::registerSetting(const std::string& key, flx::StringObservable& observable) {
-	m_registeredSettings[key] = {Setting::Type::STRING, &observable};
+	bool cached = false;
+	std::string value;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_registeredSettings[key] = {Setting::Type::STRING, &observable};
+		cJSON* item = m_json_cache ? cJSON_GetObjectItem((cJSON*)m_json_cache, key.c_str()) : nullptr;
+		if (item && cJSON_IsString(item)) {
+			cached = true;
+			value = item->valuestring;
+		}
+	}
 
 	// Subscribe to changes to trigger save
 	observable.subscribe([this](const std::string&) {
 		this->triggerSave();
 	});
 
-	// If we have cached JSON, apply the value now
-	if (m_json_cache) {
-		cJSON* item = cJSON_GetObjectItem((cJSON*)m_json_cache, key.c_str());
-		if (item && cJSON_IsString(item)) {
-			observable.set(item->valuestring);
-		}
-	}
+	// If we have cached JSON, apply the value now (unlocked: observers run inline)
+	if (cached) observable.set(value.c_str());
 }
 
 void SettingsManager::triggerSave() {
-	if (m_save_timer) {
-		esp_timer_stop(m_save_timer);
-		esp_timer_start_once(m_save_timer, 2000000); // 2 seconds
+	if (m_save_timer != flx::kernel::TimerWheel::INVALID_TIMER) {
+		flx::kernel::TimerWheel::getInstance().startOnce(m_save_timer, SAVE_DELAY_MS);
 	}
 }
 
@@ -118,8 +122,10 @@ void SettingsManager::loadSettings() {
 		if (buf) {
 			if (fread(buf, 1, len, f) == (size_t)len) {
 				buf[len] = 0;
+				cJSON* parsed = cJSON_Parse(buf);
+				std::lock_guard<std::mutex> lock(m_mutex);
 				if (m_json_cache) cJSON_Delete((cJSON*)m_json_cache);
-				m_json_cache = cJSON_Parse(buf);
+				m_json_cache = parsed;
 			}
 			free(buf);
 		}
@@ -129,6 +135,7 @@ void SettingsManager::loadSettings() {
 }
 
 void SettingsManager::saveSettings() {
+	std::lock_guard<std::mutex> lock(m_mutex);
 	cJSON* json = cJSON_CreateObject();
 
 	for (auto const& [key, setting]: m_registeredSettings) {
@@ -1,10 +1,13 @@
 #include "esp_sntp.h"
 #include "freertos/idf_additions.h"
 #include "freertos/projdefs.h"
+#include "freertos/semphr.h"
 #include <cstdint>
 #include <flx/core/Logger.hpp>
 #include <flx/system/managers/TimeManager.hpp>
+#include <memory>
 #include <string_view>
+#include <type_traits>
 
 static constexpr std::string_view TAG = "TimeManager";
 
@@ -54,7 +57,7 @@ bool TimeManager::onStart() {
 
 void TimeManager::onStop() {
 	esp_sntp_stop();
-	m_is_synced = false;
+	m_synced.set(false);
 	Log::info(TAG, "Time service stopped");
 }
 
@@ -64,7 +67,7 @@ void TimeManager::syncTime() {
 	}
 
 	if (esp_sntp_get_sync_status() == SNTP_SYNC_STATUS_COMPLETED) {
-		m_is_synced = true;
+		updateSyncStatus(true);
 	}
 }
 
@@ -72,27 +75,31 @@ bool TimeManager::waitForSync(uint32_t timeout_ms) {
 	if (!isRunning()) {
 		start();
 	}
+	if (esp_sntp_get_sync_status() == SNTP_SYNC_STATUS_COMPLETED) {
+		updateSyncStatus(true);
+	}
 
-	uint32_t waited = 0;
-	const uint32_t INTERVAL = 100;
+	// Shared with the observer, which may still be dispatching after unsubscribe()
+	std::shared_ptr<std::remove_pointer_t<SemaphoreHandle_t>> done(xSemaphoreCreateBinary(), vSemaphoreDelete);
+	if (!done) return isSynced();
 
-	while (!m_is_synced && waited < timeout_ms) {
-		if (esp_sntp_get_sync_status() == SNTP_SYNC_STATUS_COMPLETED) {
-			m_is_synced = true;
-			break;
-		}
-		vTaskDelay(pdMS_TO_TICKS(INTERVAL));
-		waited += INTERVAL;
+	// Subscribe before checking, so a sync in between still wakes us
+	size_t const id = m_synced.subscribe([done](const bool& synced) {
+		if (synced) xSemaphoreGive(done.get());
+	});
+	if (!isSynced()) {
+		xSemaphoreTake(done.get(), pdMS_TO_TICKS(timeout_ms));
 	}
+	m_synced.unsubscribe(id);
 
-	return m_is_synced;
+	return isSynced();
 }
 
 void TimeManager::updateSyncStatus(bool synced) {
-	if (synced != m_is_synced) {
+	if (synced != m_synced.get()) {
 		Log::info(TAG, "Time sync status changed: %s", synced ? "SYNCED" : "NOT SYNCED");
 	}
-	m_is_synced = synced;
+	m_synced.set(synced);
 }
 
 void TimeManager::setTimeZone(const char* tz) {
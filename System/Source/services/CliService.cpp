@@ -1,8 +1,23 @@
+#include <flx/core/BootCache.hpp>
+#include <flx/core/BootTimeline.hpp>
 #include <flx/core/EventBus.hpp>
+#include <flx/core/LogBuffer.hpp>
+#include <flx/core/LockProfiler.hpp>
+#include <flx/core/LogLevels.hpp>
 #include <flx/core/Logger.hpp>
+#include <flx/core/Observable.hpp>
+#include <flx/core/Trace.hpp>
 #include <flx/hal/DeviceRegistry.hpp>
+#include <flx/kernel/ResourceMonitorTask.hpp>
+#include <flx/kernel/StackProfiler.hpp>
+#include <flx/kernel/TaskArena.hpp>
+#include <flx/kernel/TaskManager.hpp>
+#include <flx/kernel/TimerWheel.hpp>
+#include <flx/services/HealthMonitor.hpp>
 #include <flx/hal/i2c/II2cBus.hpp>
+#include <flx/system/diagnostics/Benchmarks.hpp>
 #include <flx/system/services/CliService.hpp>
+#include <flx/system/services/PersistentLogService.hpp>
 #include <flx/system/services/SystemInfoService.hpp>
 
 #include "esp_console.h"
@@ -12,6 +27,7 @@
 #include "freertos/idf_additions.h"
 #include "freertos/projdefs.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -145,18 +161,70 @@ static int cmdUptime(int /*argc*/, char** /*argv*/) {
 }
 
 // Command: tasks - List FreeRTOS tasks
-static int cmdTasks(int /*argc*/, char** /*argv*/) {
+static void printTaskHistory(size_t count) {
+	auto history = flx::services::SystemInfoService::getInstance().getTaskHistory(count);
+	auto& monitor = flx::kernel::ResourceMonitorTask::getInstance();
+	if (history.empty()) {
+		printf("No samples yet.\n");
+		return;
+	}
+
+	printf("\n=== Task History (%zu of %zu samples, every %lu ms) ===\n", history.size(), monitor.getHistoryDepth(), (unsigned long)monitor.getSamplePeriod());
+	printf("%-10s %-10s %-10s %s\n", "Time (s)", "Heap", "Largest", "Busiest tasks (CPU %)");
+	printf("----------------------------------------------------------------\n");
+	for (auto& sample: history) {
+		std::sort(sample.tasks.begin(), sample.tasks.end(), [](const auto& a, const auto& b) {
+			return a.cpuPercent > b.cpuPercent;
+		});
+		printf("%-10.3f %-10lu %-10lu", (double)sample.timestampUs / 1e6, (unsigned long)sample.freeHeap, (unsigned long)sample.largestFreeBlock);
+		size_t shown = 0;
+		for (const auto& task: sample.tasks) {
+			if (shown == 3 || task.cpuPercent < 0.1F) break;
+			printf(" %s %.1f", task.name, task.cpuPercent);
+			shown++;
+		}
+		printf("\n");
+	}
+	printf("================================================================\n\n");
+}
+
+static void printTaskArena() {
+	auto stats = flx::kernel::TaskArena::getInstance().getStats();
+	printf("Task arena: internal %u/%u B, PSRAM %u/%u B, %lu blocks (%lu held)\n", (unsigned)stats.internalUsed, (unsigned)stats.internalSize, (unsigned)stats.psramUsed, (unsigned)stats.psramSize, (unsigned long)stats.blocks, (unsigned long)stats.owned);
+	printf("            %lu static creates, %lu block reuses, %lu heap fallbacks\n", (unsigned long)stats.creates, (unsigned long)stats.reuses, (unsigned long)stats.fallbacks);
+}
+
+static int cmdTasks(int argc, char** argv) {
+	if (argc > 1) {
+		if (strcmp(argv[1], "history") == 0) {
+			printTaskHistory(argc > 2 ? (size_t)strtoul(argv[2], nullptr, 10) : 20);
+			return 0;
+		}
+		if (strcmp(argv[1], "arena") == 0) {
+			printTaskArena();
+			return 0;
+		}
+		if (strcmp(argv[1], "rate") == 0 && argc > 2) {
+			auto& monitor = flx::kernel::ResourceMonitorTask::getInstance();
+			monitor.setSamplePeriod((uint32_t)strtoul(argv[2], nullptr, 10));
+			printf("Sampling every %lu ms (%zu samples kept).\n", (unsigned long)monitor.getSamplePeriod(), monitor.getHistoryDepth());
+			return 0;
+		}
+		printf("Usage: tasks [history [n]|rate <ms>|arena]\n");
+		return 1;
+	}
+
 	auto& sys_info = flx::services::SystemInfoService::getInstance();
 	auto task_list = sys_info.getTaskList();
 
 	printf("\n=== Task List (%zu tasks) ===\n", task_list.size());
-	printf("%-20s %-8s %-12s %-6s %-6s %-6s\n", "Name", "State", "Stack (B)", "Pri", "Core", "CPU %");
-	printf("----------------------------------------------------------------\n");
+	printf("%-20s %-8s %-12s %-6s %-6s %-6s %-6s\n", "Name", "State", "Stack (B)", "Pri", "Core", "CPU %", "Peak %");
+	printf("-----------------------------------------------------------------------\n");
 
 	for (const auto& task: task_list) {
-		printf("%-20s %-8s %-12lu %-6d %-6d %-6.1f\n", task.name.c_str(), task.state.c_str(), (unsigned long)task.stackHighWaterMark, task.currentPriority, task.coreID, task.cpuUsagePercent);
+		printf("%-20s %-8s %-12lu %-6d %-6d %-6.1f %-6.1f\n", task.name.c_str(), task.state.c_str(), (unsigned long)task.stackHighWaterMark, task.currentPriority, task.coreID, task.cpuUsagePercent, task.cpuPeakPercent);
 	}
-	printf("================================================================\n\n");
+	printf("=======================================================================\n\n");
 	return 0;
 }
 
@@ -568,11 +636,29 @@ static int cmdTime(int argc, char** argv) {
 	return 0;
 }
 
-// Command: loglevel - Set ESP log level
+// Command: loglevel - Set runtime log levels (flx::Log table and ESP-IDF)
+static const char* logLevelName(esp_log_level_t level) {
+	static constexpr const char* NAMES[] = {"none", "error", "warn", "info", "debug", "verbose"};
+	return static_cast<size_t>(level) < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[level] : "?";
+}
+
 static int cmdLogLevel(int argc, char** argv) {
+	if (argc == 1) {
+		flx::LogLevels::Override overrides[flx::LogLevels::MAX_OVERRIDES];
+		size_t count = flx::LogLevels::list(overrides, flx::LogLevels::MAX_OVERRIDES);
+		printf("\n=== Log Levels ===\n");
+		printf("Default (*): %s\n", logLevelName(flx::LogLevels::getDefault()));
+		printf("Compiled floor (System): %s\n", logLevelName(static_cast<esp_log_level_t>(Log::MIN_LEVEL)));
+		for (size_t i = 0; i < count; i++) {
+			printf("  %-24s %s\n", overrides[i].tag, logLevelName(overrides[i].level));
+		}
+		printf("==================\n\n");
+		return 0;
+	}
 	if (argc < 3) {
 		printf("Usage: loglevel <tag> <level> (none, error, warn, info, debug, verbose)\n");
 		printf("       loglevel * <level> (for all tags)\n");
+		printf("       loglevel (list current levels)\n");
 		return 1;
 	}
 
@@ -596,6 +682,12 @@ static int cmdLogLevel(int argc, char** argv) {
 		return 1;
 	}
 
+	// flx::Log filters before formatting; esp_log_write filters ESP-IDF's own logs
+	if (strcmp(tag, "*") == 0) {
+		flx::LogLevels::setDefault(level);
+	} else if (!flx::LogLevels::set(tag, level)) {
+		printf("Warning: '%s' not added to the flx::Log table (tag too long or table full)\n", tag);
+	}
 	esp_log_level_set(tag, level);
 	printf("Log level for '%s' set to %s\n", tag, level_str);
 	return 0;
@@ -687,6 +779,594 @@ static int cmdHal(int argc, char** argv) {
 	return 0;
 }
 
+// Command: events - EventBus statistics
+static int cmdEvents(int argc, char** argv) {
+	auto& bus = flx::core::EventBus::getInstance();
+
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		bus.resetAsyncStats();
+		printf("EventBus async counters reset.\n");
+		return 0;
+	}
+
+	static constexpr const char* PRIORITY_NAMES[flx::core::EventBus::PRIORITY_COUNT] = {"Low", "Normal", "High"};
+	auto stats = bus.getAsyncStats();
+
+	printf("\n=== EventBus ===\n");
+	printf("Topics:        %zu\n", bus.getTopicCount());
+	printf("Subscriptions: %zu\n", bus.getSubscriptionCount());
+	printf("\nAsync queue (depth %zu per priority):\n", flx::core::EventBus::ASYNC_QUEUE_DEPTH);
+	printf("%-8s %-10s %-10s\n", "Prio", "Enqueued", "Overflow");
+	printf("------------------------------\n");
+	for (size_t p = flx::core::EventBus::PRIORITY_COUNT; p-- > 0;) {
+		printf("%-8s %-10lu %-10lu\n", PRIORITY_NAMES[p], (unsigned long)stats.enqueued[p], (unsigned long)stats.overflow[p]);
+	}
+	printf("\nDelivered:  %lu\n", (unsigned long)stats.delivered);
+	printf("Coalesced:  %lu\n", (unsigned long)stats.coalesced);
+	printf("Pending:    %lu\n", (unsigned long)stats.pending);
+	printf("High water: %lu\n", (unsigned long)stats.highWater);
+	printf("================\n\n");
+	return 0;
+}
+
+// Command: observers - Observable batching / LVGL bridge coalescing counters
+static int cmdObservers(int /*argc*/, char** /*argv*/) {
+	printf("\n=== Observables ===\n");
+	printf("Batch commits:            %lu\n", (unsigned long)flx::ObservableStats::batchCommits.load());
+	printf("Batch collapsed notifies: %lu\n", (unsigned long)flx::ObservableStats::batchCollapsed.load());
+	printf("LVGL updates applied:     %lu\n", (unsigned long)flx::ObservableStats::bridgeApplied.load());
+	printf("LVGL updates collapsed:   %lu\n", (unsigned long)flx::ObservableStats::bridgeCollapsed.load());
+	printf("===================\n\n");
+	return 0;
+}
+
+// Command: logbuf - Deferred logging ring statistics
+static int cmdLogBuf(int argc, char** argv) {
+	using flx::core::LogBuffer;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "off") == 0) {
+			bool enable = strcmp(argv[1], "on") == 0;
+			if (!enable) LogBuffer::drain(SIZE_MAX);
+			LogBuffer::setDeferred(enable);
+			printf("Deferred logging %s.\n", LogBuffer::isDeferred() ? "enabled" : "disabled");
+			return 0;
+		}
+		if (strcmp(argv[1], "reset") == 0) {
+			LogBuffer::resetStats();
+			printf("Log buffer counters reset.\n");
+			return 0;
+		}
+		printf("Usage: logbuf [on|off|reset]\n");
+		return 1;
+	}
+
+	auto stats = LogBuffer::getStats();
+	printf("\n=== Log Buffer ===\n");
+	printf("Mode:       %s\n", LogBuffer::isDeferred() ? "deferred" : "synchronous");
+	printf("Ring size:  %zu records x %zu bytes per core\n", LogBuffer::RING_CAPACITY, sizeof(LogBuffer::Record));
+	printf("%-6s %-10s %-10s\n", "Core", "Captured", "Dropped");
+	printf("------------------------------\n");
+	for (size_t core = 0; core < LogBuffer::MAX_CORES; core++) {
+		printf("%-6zu %-10lu %-10lu\n", core, (unsigned long)stats.captured[core], (unsigned long)stats.dropped[core]);
+	}
+	printf("\nDrained:    %lu\n", (unsigned long)stats.drained);
+	printf("Pending:    %zu\n", LogBuffer::pending());
+	printf("High water: %lu\n", (unsigned long)stats.highWater);
+	printf("Truncated:  %lu\n", (unsigned long)stats.truncated);
+	printf("Sync fallback: %lu\n", (unsigned long)stats.fallback);
+	printf("==================\n\n");
+	return 0;
+}
+
+// Command: logs - Persistent log files under /data/logs
+static int cmdLogs(int argc, char** argv) {
+	auto& store = flx::services::PersistentLogService::getInstance();
+	const char* sub = argc > 1 ? argv[1] : "stats";
+
+	if (strcmp(sub, "tail") == 0) {
+		size_t lines = argc > 2 ? strtoul(argv[2], nullptr, 10) : 20;
+		store.tail(lines > 0 ? lines : 20);
+		return 0;
+	}
+	if (strcmp(sub, "export") == 0) {
+		std::string path = argc > 2 ? argv[2] : "";
+		if (!store.exportTo(path)) {
+			printf("Export failed: %s\n", path.c_str());
+			return 1;
+		}
+		if (!path.empty()) printf("Logs exported to %s\n", path.c_str());
+		return 0;
+	}
+	if (strcmp(sub, "flush") == 0) {
+		bool ok = store.flush();
+		printf("Flush %s.\n", ok ? "complete" : "failed");
+		return ok ? 0 : 1;
+	}
+	if (strcmp(sub, "clear") == 0) {
+		store.clear();
+		printf("Log files removed.\n");
+		return 0;
+	}
+	if (strcmp(sub, "stats") != 0) {
+		printf("Usage: logs [tail [n]|export [path]|flush|clear|stats]\n");
+		return 1;
+	}
+
+	auto stats = store.getStats();
+	printf("\n=== Persistent Log ===\n");
+	printf("Directory:      %s (%d x %zu KB)\n", flx::services::PersistentLogService::LOG_DIR, flx::services::PersistentLogService::MAX_FILES, flx::services::PersistentLogService::MAX_FILE_SIZE / 1024);
+	printf("Buffer:         %zu / %zu bytes (%s)\n", stats.buffered, stats.capacity, stats.psram ? "PSRAM" : "internal");
+	printf("Accepted:       %lu bytes\n", (unsigned long)stats.bytesAccepted);
+	printf("Dropped:        %lu bytes\n", (unsigned long)stats.bytesDropped);
+	printf("Written:        %lu bytes\n", (unsigned long)stats.bytesWritten);
+	printf("Sector writes:  %lu\n", (unsigned long)stats.sectorWrites);
+	printf("Partial writes: %lu\n", (unsigned long)stats.partialWrites);
+	printf("Rotations:      %lu\n", (unsigned long)stats.rotations);
+	printf("Write errors:   %lu\n", (unsigned long)stats.writeErrors);
+	printf("Crash tail:     %lu bytes recovered\n", (unsigned long)stats.recoveredBytes);
+	printf("======================\n\n");
+	return 0;
+}
+
+// Command: heapcheck - Heap integrity checks run from the watchdog
+static int cmdHeapCheck(int argc, char** argv) {
+	auto& tm = flx::kernel::TaskManager::getInstance();
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "budget") == 0 && argc > 2) {
+			tm.setHeapCheckBudget((uint32_t)strtoul(argv[2], nullptr, 10));
+			printf("Heap check budget set to %lu us per tick.\n", (unsigned long)tm.getHeapCheckBudget());
+			return 0;
+		}
+		if (strcmp(argv[1], "reset") == 0) {
+			tm.resetHeapCheckStats();
+			printf("Heap check counters reset.\n");
+			return 0;
+		}
+		if (strcmp(argv[1], "full") == 0) {
+			int64_t const start = esp_timer_get_time();
+			bool const ok = flx::kernel::TaskManager::checkHeapIntegrity();
+			printf("Full heap check: %s in %lld us\n", ok ? "OK" : "CORRUPT", (long long)(esp_timer_get_time() - start));
+			return ok ? 0 : 1;
+		}
+		printf("Usage: heapcheck [budget <us>|reset|full]\n");
+		return 1;
+	}
+
+	auto stats = tm.getHeapCheckStats();
+	printf("\n=== Heap Integrity Check ===\n");
+	printf("Budget:         %lu us per tick\n", (unsigned long)stats.budgetUs);
+	printf("Heaps:          %lu\n", (unsigned long)stats.heaps);
+	printf("Passes:         %lu\n", (unsigned long)stats.passes);
+	printf("PSRAM checks:   %lu (every %lu s)\n", (unsigned long)stats.psramChecks, (unsigned long)(flx::kernel::TaskManager::PSRAM_CHECK_INTERVAL_MS / 1000));
+	printf("Ticks per pass: %lu (%lu ms)\n", (unsigned long)stats.ticksPerPass, (unsigned long)stats.lastPassMs);
+	printf("Last pause:     %lu us\n", (unsigned long)stats.lastTickUs);
+	printf("Worst pause:    %lu us\n", (unsigned long)stats.worstTickUs);
+	printf("Worst heap:     %lu us (heap %lu)\n", (unsigned long)stats.worstHeapUs, (unsigned long)stats.worstHeapIndex);
+	printf("============================\n\n");
+	return 0;
+}
+
+// Command: timers - Shared timer wheel and per-timer statistics
+static int cmdTimers(int argc, char** argv) {
+	auto& wheel = flx::kernel::TimerWheel::getInstance();
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") == 0) {
+			wheel.resetStats();
+			printf("Timer counters reset.\n");
+			return 0;
+		}
+		printf("Usage: timers [reset]\n");
+		return 1;
+	}
+
+	auto stats = wheel.getStats();
+	printf("\n=== Timer Wheel ===\n");
+	printf("Timers:     %lu (%lu active)\n", (unsigned long)stats.timers, (unsigned long)stats.active);
+	printf("Wake-ups:   %lu\n", (unsigned long)stats.wakeups);
+	printf("Fired:      %lu (%lu coalesced)\n", (unsigned long)stats.fired, (unsigned long)stats.coalesced);
+	printf("Cascades:   %lu\n", (unsigned long)stats.cascades);
+	printf("\n%-16s %-8s %-8s %-6s %-8s %-6s %-10s %-10s %-10s\n", "Name", "Period", "Slack", "State", "Fires", "Skip", "AvgLate", "MaxLate", "MaxRun");
+	printf("------------------------------------------------------------------------------------------\n");
+	for (const auto& t: wheel.getTimerStats()) {
+		printf("%-16.16s %-8lu %-8lu %-6s %-8lu %-6lu %-10lu %-10lu %-10lu\n", t.name, (unsigned long)t.periodMs, (unsigned long)t.slackMs, t.active ? "run" : "idle", (unsigned long)t.fires, (unsigned long)t.overruns, (unsigned long)t.avgLateUs, (unsigned long)t.maxLateUs, (unsigned long)t.maxRunUs);
+	}
+	printf("(period/slack in ms, late/run in us)\n");
+	printf("==========================================================================================\n\n");
+	return 0;
+}
+
+// Command: stacks - Worst-case stack usage and suggested sizes
+static void printStacksJson(const std::vector<flx::kernel::StackProfiler::Report>& report) {
+	auto& profiler = flx::kernel::StackProfiler::getInstance();
+	printf("{\"marginPercent\":%lu,\"soakSeconds\":%lu,\"tasks\":[", (unsigned long)profiler.getMarginPercent(), (unsigned long)((esp_timer_get_time() - profiler.getSinceUs()) / 1000000));
+	for (size_t i = 0; i < report.size(); i++) {
+		const auto& r = report[i];
+		printf("%s\n{\"name\":\"%s\",\"stackSize\":%lu,\"minFree\":%lu,\"maxUsed\":%lu,\"recommended\":%lu,\"samples\":%lu,\"instances\":%lu,\"alive\":%s}", i ? "," : "", r.entry.name, (unsigned long)r.entry.stackSize, (unsigned long)r.entry.minFree, (unsigned long)r.entry.maxUsed, (unsigned long)r.recommended, (unsigned long)r.entry.samples, (unsigned long)r.entry.instances, r.entry.alive ? "true" : "false");
+	}
+	printf("\n]}\n");
+}
+
+static void printStacksYaml(const std::vector<flx::kernel::StackProfiler::Report>& report) {
+	printf("# Measured over %lu s with a %lu%% margin. Only FlxOS tasks read these;\n", (unsigned long)((esp_timer_get_time() - flx::kernel::StackProfiler::getInstance().getSinceUs()) / 1000000), (unsigned long)flx::kernel::StackProfiler::getInstance().getMarginPercent());
+	printf("# IDF tasks (main, ipc, wifi, ...) are sized through sdkconfig.\n");
+	printf("scheduling:\n  tasks:\n");
+	for (const auto& r: report) {
+		if (r.recommended == 0) continue;
+		printf("    %s:\n      stack: %lu\n", r.entry.name, (unsigned long)r.recommended);
+	}
+}
+
+static int cmdStacks(int argc, char** argv) {
+	auto& profiler = flx::kernel::StackProfiler::getInstance();
+
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		profiler.reset();
+		printf("Stack profile cleared; high-water marks are per task lifetime, so running tasks keep their worst case.\n");
+		return 0;
+	}
+	if (argc > 2 && strcmp(argv[1], "margin") == 0) {
+		profiler.setMarginPercent((uint32_t)strtoul(argv[2], nullptr, 10));
+		printf("Safety margin: %lu%%\n", (unsigned long)profiler.getMarginPercent());
+		return 0;
+	}
+
+	auto report = profiler.getReport();
+	std::sort(report.begin(), report.end(), [](const auto& a, const auto& b) { return a.entry.stackSize > b.entry.stackSize; });
+
+	if (argc > 1 && strcmp(argv[1], "json") == 0) {
+		printStacksJson(report);
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "yaml") == 0) {
+		printStacksYaml(report);
+		return 0;
+	}
+	if (argc > 1) {
+		printf("Usage: stacks [json|yaml|reset|margin <pct>]\n");
+		return 1;
+	}
+
+	int64_t saved = 0;
+	printf("\n=== Stack Profile (%lu s, margin %lu%%) ===\n", (unsigned long)((esp_timer_get_time() - profiler.getSinceUs()) / 1000000), (unsigned long)profiler.getMarginPercent());
+	printf("%-16s %-8s %-8s %-8s %-6s %-8s %-8s %-8s\n", "Task", "Size", "MinFree", "Used", "Used%", "Suggest", "Delta", "Samples");
+	printf("------------------------------------------------------------------------------\n");
+	for (const auto& r: report) {
+		const auto& e = r.entry;
+		if (e.stackSize == 0) {
+			printf("%-16.16s %-8s %-8lu %-8s %-6s %-8s %-8s %-8lu%s\n", e.name, "?", (unsigned long)e.minFree, "-", "-", "-", "-", (unsigned long)e.samples, e.alive ? "" : " (gone)");
+			continue;
+		}
+		long const delta = (long)r.recommended - (long)e.stackSize;
+		saved -= delta;
+		printf("%-16.16s %-8lu %-8lu %-8lu %-6lu %-8lu %-+8ld %-8lu%s\n", e.name, (unsigned long)e.stackSize, (unsigned long)e.minFree, (unsigned long)e.maxUsed, (unsigned long)(e.maxUsed * 100 / e.stackSize), (unsigned long)r.recommended, delta, (unsigned long)e.samples, e.alive ? "" : " (gone)");
+	}
+	printf("Suggested sizes would %s %ld bytes; paste 'stacks yaml' into the profile to apply them.\n", saved >= 0 ? "free" : "need", (long)(saved >= 0 ? saved : -saved));
+	printf("==============================================================================\n\n");
+	return 0;
+}
+
+// Command: trace - Span tracing with Chrome trace JSON export
+static int cmdTrace(int argc, char** argv) {
+	using flx::core::Trace;
+	const char* sub = argc > 1 ? argv[1] : "stats";
+
+	if (strcmp(sub, "start") == 0) {
+		bool const ring = argc > 2 && strcmp(argv[2], "ring") == 0;
+		if (!Trace::start(ring ? Trace::Mode::RING : Trace::Mode::ONESHOT)) {
+			printf("Trace buffers could not be allocated.\n");
+			return 1;
+		}
+		printf("Tracing started (%s, %u events per core).\n", ring ? "ring" : "one-shot", (unsigned)Trace::RING_CAPACITY);
+		return 0;
+	}
+	if (strcmp(sub, "stop") == 0) {
+		Trace::stop();
+		printf("Tracing stopped; 'trace dump' still has the events.\n");
+		return 0;
+	}
+	if (strcmp(sub, "dump") == 0) {
+		if (argc < 3) {
+			Trace::writeChromeJson(stdout);
+			fflush(stdout);
+			return 0;
+		}
+		std::string path = resolvePath(CliService::getInstance().getCurrentDirectory(), argv[2]);
+		FILE* out = fopen(path.c_str(), "w");
+		if (!out) {
+			printf("Failed to open file: %s\n", path.c_str());
+			return 1;
+		}
+		size_t const written = Trace::writeChromeJson(out);
+		fclose(out);
+		printf("%u events written to %s (open in ui.perfetto.dev)\n", (unsigned)written, path.c_str());
+		return 0;
+	}
+	if (strcmp(sub, "stats") != 0) {
+		printf("Usage: trace [start [ring]|stop|dump [path]|stats]\n");
+		return 1;
+	}
+
+	auto stats = Trace::getStats();
+	printf("\n=== Trace ===\n");
+	printf("State:      %s (%s)\n", stats.enabled ? "recording" : "stopped", stats.mode == Trace::Mode::RING ? "ring" : "one-shot");
+	if (stats.startUs) printf("Started:    %lu ms after boot\n", (unsigned long)(stats.startUs / 1000));
+	for (size_t core = 0; core < std::min<size_t>(portNUM_PROCESSORS, Trace::MAX_CORES); core++) {
+		printf("Core %u:     %lu recorded, %lu dropped (capacity %u)\n", (unsigned)core, (unsigned long)stats.recorded[core], (unsigned long)stats.dropped[core], (unsigned)Trace::RING_CAPACITY);
+	}
+	printf("=============\n\n");
+	return 0;
+}
+
+// Command: locks - Wait/hold profile of the shared mutexes
+static void printLockSite(const flx::core::LockProfiler::Site& s) {
+	char where[48];
+	if (s.site.file) {
+		const char* base = strrchr(s.site.file, '/');
+		snprintf(where, sizeof(where), "%s:%lu", base ? base + 1 : s.site.file, (unsigned long)s.site.line);
+	} else {
+		snprintf(where, sizeof(where), "%p", s.site.pc);
+	}
+	printf("  %-32.32s %-16.16s %-8lu %-10lu %-10lu %-10lu\n", where, s.task, (unsigned long)s.count, (unsigned long)(s.count ? s.totalHoldUs / s.count : 0), (unsigned long)s.maxHoldUs, (unsigned long)(s.count ? s.totalWaitUs / s.count : 0));
+}
+
+static void printLockHistogram(const char* title, const uint32_t* buckets) {
+	using flx::core::LockProfiler;
+	uint32_t peak = 0;
+	for (size_t i = 0; i < LockProfiler::HISTOGRAM_BUCKETS; i++) peak = std::max(peak, buckets[i]);
+	printf("  %s:\n", title);
+	if (peak == 0) {
+		printf("    (none)\n");
+		return;
+	}
+	for (size_t i = 0; i < LockProfiler::HISTOGRAM_BUCKETS; i++) {
+		if (buckets[i] == 0) continue;
+		char bar[33];
+		size_t const len = std::max<size_t>(1, (size_t)buckets[i] * (sizeof(bar) - 1) / peak);
+		memset(bar, '#', len);
+		bar[len] = '\0';
+		printf("    >= %-8lu us %-8lu %s\n", (unsigned long)LockProfiler::bucketFloorUs(i), (unsigned long)buckets[i], bar);
+	}
+}
+
+static int cmdLocks(int argc, char** argv) {
+	using flx::core::LockProfiler;
+	const char* sub = argc > 1 ? argv[1] : "";
+
+	if (strcmp(sub, "on") == 0 || strcmp(sub, "off") == 0) {
+		LockProfiler::setEnabled(strcmp(sub, "on") == 0);
+		printf("Lock profiling %s.\n", LockProfiler::isEnabled() ? "enabled" : "disabled");
+		return 0;
+	}
+	if (strcmp(sub, "reset") == 0) {
+		LockProfiler::reset();
+		printf("Lock statistics cleared.\n");
+		return 0;
+	}
+
+	auto reports = LockProfiler::getReport();
+	if (*sub) {
+		for (const auto& r: reports) {
+			if (strcmp(r.name, sub) != 0) continue;
+			printf("\n=== Lock: %s ===\n", r.name);
+			printLockHistogram("Wait", r.waitHistogram);
+			printLockHistogram("Hold", r.holdHistogram);
+			printf("  %-32s %-16s %-8s %-10s %-10s %-10s\n", "Holder site", "Last task", "Count", "AvgHold", "MaxHold", "AvgWait");
+			for (const auto& s: r.sites) printLockSite(s);
+			if (r.otherSites) printf("  (%lu acquisitions from untracked sites)\n", (unsigned long)r.otherSites);
+			printf("(times in us; addresses resolve with addr2line against the firmware ELF)\n\n");
+			return 0;
+		}
+		printf("Usage: locks [on|off|reset|<name>]\n");
+		return 1;
+	}
+
+	printf("\n=== Lock Profile (%s) ===\n", LockProfiler::isEnabled() ? "recording" : "off; 'locks on' to record");
+	printf("%-16s %-8s %-6s %-9s %-9s %-9s %-9s\n", "Lock", "Acq", "Cont%", "AvgWait", "MaxWait", "AvgHold", "MaxHold");
+	printf("--------------------------------------------------------------------\n");
+	for (const auto& r: reports) {
+		unsigned long const n = r.acquisitions;
+		printf("%-16.16s %-8lu %-6lu %-9lu %-9lu %-9lu %-9lu\n", r.name, n, n ? (unsigned long)r.contended * 100 / n : 0UL, n ? (unsigned long)(r.totalWaitUs / n) : 0UL, (unsigned long)r.maxWaitUs, n ? (unsigned long)(r.totalHoldUs / n) : 0UL, (unsigned long)r.maxHoldUs);
+	}
+	printf("(times in us; 'locks <name>' for histograms and holders)\n");
+	printf("====================================================================\n\n");
+	return 0;
+}
+
+// Command: boottime - This boot's phases against the previous boot
+static const flx::core::BootTimeline::Phase* findBootPhase(const flx::core::BootTimeline::Timeline& timeline, const char* name) {
+	for (const auto& phase: timeline.phases) {
+		if (strcmp(phase.name, name) == 0) return &phase;
+	}
+	return nullptr;
+}
+
+// Both a 20 ms and a 10% increase, so jitter on short phases is not flagged
+static bool isBootRegression(uint32_t previousUs, uint32_t currentUs) {
+	if (currentUs <= previousUs) return false;
+	uint32_t const delta = currentUs - previousUs;
+	return delta > 20000 && delta * 10 > previousUs;
+}
+
+static int cmdBootTime(int argc, char** argv) {
+	using flx::core::BootTimeline;
+	const char* sub = argc > 1 ? argv[1] : "";
+
+	BootTimeline::Timeline current;
+	if (strcmp(sub, "raw") == 0) {
+		BootTimeline::write(stdout, BootTimeline::current());
+		return 0;
+	}
+	if (strcmp(sub, "saved") == 0) {
+		if (!BootTimeline::load(BootTimeline::PATH, current)) {
+			printf("No saved timeline at %s\n", BootTimeline::PATH);
+			return 1;
+		}
+	} else if (*sub) {
+		printf("Usage: boottime [saved|raw]\n");
+		return 1;
+	} else {
+		current = BootTimeline::current();
+	}
+
+	// Once this boot is saved, PATH holds it and the previous one has moved aside
+	const char* previousPath = (*sub || BootTimeline::isFrozen()) ? BootTimeline::PREVIOUS_PATH : BootTimeline::PATH;
+	BootTimeline::Timeline previous;
+	bool const hasPrevious = BootTimeline::load(previousPath, previous);
+
+	printf("\n=== Boot Timeline (%s) ===\n", current.build.c_str());
+	printf("%-32s %-9s %-9s %-9s %-9s %s\n", "Phase", "Start", "Duration", "End", "PrevEnd", "");
+	printf("----------------------------------------------------------------------------------\n");
+	int regressions = 0;
+	for (const auto& phase: current.phases) {
+		uint32_t const duration = phase.endUs - phase.startUs;
+		const BootTimeline::Phase* prev = hasPrevious ? findBootPhase(previous, phase.name) : nullptr;
+		// Duration only: one slow phase moves the end of every later phase
+		bool const slower = prev && isBootRegression(prev->endUs - prev->startUs, duration);
+		if (slower) regressions++;
+		char prevEnd[12] = "-";
+		if (prev) snprintf(prevEnd, sizeof(prevEnd), "%lu", (unsigned long)(prev->endUs / 1000));
+		printf("%-32.32s %-9lu %-9lu %-9lu %-9s %s\n", phase.name, (unsigned long)(phase.startUs / 1000), (unsigned long)(duration / 1000), (unsigned long)(phase.endUs / 1000), prevEnd, slower ? "SLOWER" : "");
+	}
+	printf("(times in ms since power-on; reset reason %d)\n", current.resetReason);
+	if (hasPrevious) {
+		uint32_t currentEnd = 0, previousEnd = 0;
+		for (const auto& phase: current.phases) currentEnd = std::max(currentEnd, phase.endUs);
+		for (const auto& phase: previous.phases) previousEnd = std::max(previousEnd, phase.endUs);
+		printf("Previous boot: %s%s, %d phase(s) slower\n", previous.build.c_str(), previous.build == current.build ? " (same build)" : "", regressions);
+		printf("Boot end: %lu ms, previous %lu ms%s\n", (unsigned long)(currentEnd / 1000), (unsigned long)(previousEnd / 1000), isBootRegression(previousEnd, currentEnd) ? " SLOWER" : "");
+	} else {
+		printf("No previous boot to compare against\n");
+	}
+	printf("==================================================================================\n\n");
+	return 0;
+}
+
+// Command: bootcache - Cached discovery results
+static int cmdBootCache(int argc, char** argv) {
+	auto& cache = flx::core::BootCache::getInstance();
+	const char* sub = argc > 1 ? argv[1] : "";
+
+	if (strcmp(sub, "clear") == 0) {
+		cache.clear();
+		printf("Boot cache cleared; the next boot probes everything.\n");
+		return 0;
+	}
+	if (strcmp(sub, "save") == 0) {
+		return cache.save() ? 0 : 1;
+	}
+	if (*sub) {
+		printf("Usage: bootcache [clear|save]\n");
+		return 1;
+	}
+
+	auto stats = cache.getStats();
+	printf("\n=== Boot Cache (%s) ===\n", stats.warm ? "warm" : "cold");
+	printf("Key: %s\n", stats.key.empty() ? "(not loaded)" : stats.key.c_str());
+	printf("Hits: %lu  Misses: %lu  Updates: %lu\n", (unsigned long)stats.hits, (unsigned long)stats.misses, (unsigned long)stats.updates);
+	printf("------------------------------------------------------------\n");
+	for (const auto& [key, value]: cache.getEntries()) {
+		printf("%-20s %s\n", key.c_str(), value.c_str());
+	}
+	printf("============================================================\n\n");
+	return 0;
+}
+
+// Command: health - Scheduled health checks
+static int cmdHealth(int argc, char** argv) {
+	auto& monitor = flx::services::HealthMonitor::getInstance();
+	const char* sub = argc > 1 ? argv[1] : "";
+
+	if (strcmp(sub, "now") == 0) {
+		monitor.checkNow();
+		printf("All checks due; they run one per %lu ms tick.\n", (unsigned long)flx::services::HealthMonitor::TICK_MS);
+		return 0;
+	}
+	if (strcmp(sub, "reset") == 0) {
+		monitor.resetStats();
+		printf("Health statistics cleared.\n");
+		return 0;
+	}
+	if (*sub) {
+		printf("Usage: health [now|reset]\n");
+		return 1;
+	}
+
+	int64_t const now = esp_timer_get_time();
+	printf("\n=== Health Checks ===\n");
+	printf("%-26s %-8s %-6s %-7s %-7s %-7s %-7s %-5s %-6s %-8s %s\n", "Check", "Every", "Runs", "Last", "Max", "Budget", "Over", "Fail", "Rstrt", "Next", "State");
+	printf("------------------------------------------------------------------------------------------------------\n");
+	for (const auto& s: monitor.getStats()) {
+		char next[12] = "-";
+		if (s.nextDueUs != INT64_MAX) snprintf(next, sizeof(next), "%llds", (long long)(std::max<int64_t>(s.nextDueUs - now, 0) / 1000000));
+		const char* state = s.restartPending ? "RESTART" : (s.runs == 0 ? "-" : (s.lastOk ? "ok" : "FAIL"));
+		printf("%-26.26s %-8lu %-6lu %-7lu %-7lu %-7lu %-7lu %-5lu %-6lu %-8s %s\n", s.name.c_str(), (unsigned long)(s.intervalMs / 1000), (unsigned long)s.runs, (unsigned long)s.lastUs, (unsigned long)s.maxUs, (unsigned long)s.budgetUs, (unsigned long)s.overBudget, (unsigned long)s.failures, (unsigned long)s.restarts, next, state);
+	}
+	printf("(intervals in s, times in us; restarts back off from %lu s to %lu s)\n", (unsigned long)(flx::services::HealthMonitor::BACKOFF_BASE_MS / 1000), (unsigned long)(flx::services::HealthMonitor::BACKOFF_MAX_MS / 1000));
+	printf("======================================================================================================\n\n");
+	return 0;
+}
+
+// Command: bench - On-device microbenchmarks
+static void printBenchResults(const char* title, const std::vector<flx::system::diagnostics::BenchResult>& results, bool showSpeedup = true) {
+	printf("\n=== Benchmark: %s ===\n", title);
+	printf("%-36s %-10s %-10s %-10s\n", "Case", "Iters", "ns/op", "Heap (B)");
+	printf("----------------------------------------------------------------------\n");
+	for (const auto& r: results) {
+		printf("%-36s %-10lu %-10lu %-10ld\n", r.name, (unsigned long)r.iterations, (unsigned long)r.nsPerOp(), (long)r.heapDeltaBytes);
+	}
+	if (showSpeedup && results.size() >= 2 && results.back().nsPerOp() > 0) {
+		printf("Speedup (first vs last): %.1fx\n", (double)results.front().nsPerOp() / (double)results.back().nsPerOp());
+	}
+	printf("======================================================================\n\n");
+}
+
+static void printRestartStorm(const std::vector<flx::system::diagnostics::RestartStormResult>& results) {
+	printf("\n=== Benchmark: Task restart storm ===\n");
+	printf("%-28s %-9s %-10s %-14s %-14s %-10s\n", "Mode", "Restarts", "us/restart", "Largest before", "Largest after", "Free delta");
+	printf("------------------------------------------------------------------------------------\n");
+	for (const auto& r: results) {
+		printf("%-28s %-9lu %-10lu %-14u %-14u %-10ld\n", r.mode, (unsigned long)r.restarts, (unsigned long)(r.restarts ? r.totalUs / r.restarts : 0), (unsigned)r.largestBefore, (unsigned)r.largestAfter, (long)r.freeAfter - (long)r.freeBefore);
+	}
+	printTaskArena();
+	printf("====================================================================================\n\n");
+}
+
+static int cmdBench(int argc, char** argv) {
+	if (argc < 2) {
+		printf("Usage: bench <suite> [iterations]\n");
+		printf("Suites:\n");
+		printf("  eventbus   EventBus dispatch (legacy linear scan vs topic index)\n");
+		printf("  channel    Bundle publish vs typed EventChannel publish\n");
+		printf("  bundle     Bundle put/get/copy/iterate/heap (legacy vs compact), binary codec\n");
+		printf("  log        Log::info caller cost (synchronous vs deferred capture)\n");
+		printf("  restart    Largest free block across a task restart storm (heap vs arena)\n");
+		return 1;
+	}
+
+	std::string suite = argv[1];
+	uint32_t iterations = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 10) : 10000;
+	if (iterations == 0) iterations = 1;
+
+	if (suite == "eventbus") {
+		printBenchResults("EventBus publish", flx::system::diagnostics::runEventBusBenchmark(iterations));
+	} else if (suite == "channel") {
+		printBenchResults("EventChannel publish", flx::system::diagnostics::runEventChannelBenchmark(iterations));
+	} else if (suite == "bundle") {
+		printBenchResults("Bundle", flx::system::diagnostics::runBundleBenchmark(iterations), false);
+	} else if (suite == "log") {
+		printBenchResults("Logger", flx::system::diagnostics::runLogBenchmark(iterations));
+	} else if (suite == "restart") {
+		printRestartStorm(flx::system::diagnostics::runTaskRestartStorm(argc > 2 ? iterations : 200));
+	} else {
+		printf("Unknown benchmark suite: %s\n", suite.c_str());
+		return 1;
+	}
+	return 0;
+}
+
 #define REGISTER_CLI_CMD(name, help_text, handler)       \
 	{                                                    \
 		const esp_console_cmd_t cmd = {                  \
@@ -708,7 +1388,7 @@ void CliService::registerCommands() {
 	REGISTER_CLI_CMD("reboot", "Restart the system", &cmdReboot);
 
 	// Phase 1: New System Info Commands
-	REGISTER_CLI_CMD("tasks", "List FreeRTOS tasks and stats", &cmdTasks);
+	REGISTER_CLI_CMD("tasks", "List FreeRTOS tasks and stats (history [n], rate <ms>, arena)", &cmdTasks);
 	REGISTER_CLI_CMD("storage", "Display partition/storage usage", &cmdStorage);
 	REGISTER_CLI_CMD("psram", "Display PSRAM statistics", &cmdPsram);
 	REGISTER_CLI_CMD("version", "Show FlxOS software versions", &cmdVersion);
@@ -731,14 +1411,27 @@ void CliService::registerCommands() {
 	REGISTER_CLI_CMD("brightness", "Set display brightness (0-100)", &cmdBrightness);
 	REGISTER_CLI_CMD("display_test", "Test low-level display driver (color_hex or off)", &cmdDisplayTest);
 	REGISTER_CLI_CMD("time", "Show system time", &cmdTime);
-	REGISTER_CLI_CMD("loglevel", "Set log level for tags", &cmdLogLevel);
+	REGISTER_CLI_CMD("loglevel", "Show or set log levels for tags", &cmdLogLevel);
 	REGISTER_CLI_CMD("clear", "Clear terminal screen", &cmdClear);
 	REGISTER_CLI_CMD("echo", "Echo text to stdout", &cmdEcho);
 	REGISTER_CLI_CMD("free", "Show memory stats", &cmdHeap); // Alias
 	REGISTER_CLI_CMD("top", "Show task list", &cmdTasks); // Alias
 	REGISTER_CLI_CMD("hal", "HAL diagnostics (devices, health, i2c scan)", &cmdHal);
-
-	Log::info(TAG, "Registered CLI commands: sysinfo, heap, uptime, reboot, tasks, storage, psram, version, chip, wifi, hotspot, ls, cd, pwd, mkdir, rm, cat, df, brightness, time, loglevel, clear, echo, free, top");
+	REGISTER_CLI_CMD("bench", "Run on-device microbenchmarks (eventbus, channel, bundle, log, restart)", &cmdBench);
+	REGISTER_CLI_CMD("events", "EventBus statistics and async queue counters (reset)", &cmdEvents);
+	REGISTER_CLI_CMD("observers", "Observable batching and LVGL bridge coalescing counters", &cmdObservers);
+	REGISTER_CLI_CMD("logbuf", "Deferred logging ring counters (on, off, reset)", &cmdLogBuf);
+	REGISTER_CLI_CMD("logs", "Persistent logs (tail [n], export [path], flush, clear, stats)", &cmdLogs);
+	REGISTER_CLI_CMD("heapcheck", "Heap integrity checks from the watchdog (budget <us>, reset, full)", &cmdHeapCheck);
+	REGISTER_CLI_CMD("timers", "Timer wheel wake-ups and per-timer statistics (reset)", &cmdTimers);
+	REGISTER_CLI_CMD("stacks", "Worst-case stack use and suggested sizes (json, yaml, reset, margin <pct>)", &cmdStacks);
+	REGISTER_CLI_CMD("trace", "Span tracing; dump writes Chrome trace JSON for Perfetto (start [ring], stop, dump [path], stats)", &cmdTrace);
+	REGISTER_CLI_CMD("locks", "Mutex wait/hold histograms and top holders (on, off, reset, <name>)", &cmdLocks);
+	REGISTER_CLI_CMD("boottime", "Boot phase timeline vs the previous boot (saved, raw)", &cmdBootTime);
+	REGISTER_CLI_CMD("bootcache", "Cached boot order and probe results (clear, save)", &cmdBootCache);
+	REGISTER_CLI_CMD("health", "Health check timings, failures and restarts (now, reset)", &cmdHealth);
+
+	Log::info(TAG, "Registered CLI commands: sysinfo, heap, uptime, reboot, tasks, storage, psram, version, chip, wifi, hotspot, ls, cd, pwd, mkdir, rm, cat, df, brightness, time, loglevel, clear, echo, free, top, hal, bench, events, observers, logbuf, logs, heapcheck, timers, stacks, trace, locks, boottime, bootcache, health");
 }
 
 bool CliService::onStart() {
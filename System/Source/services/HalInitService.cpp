@@ -18,6 +18,7 @@ const flx::services::ServiceManifest HalInitService::serviceManifest = {
 	.required = true,
 	.autoStart = true,
 	.guiRequired = false,
+	.healthIntervalMs = 30000,
 };
 
 HalInitService& HalInitService::getInstance() {
@@ -68,16 +69,23 @@ void HalInitService::onStop() {
 	flx::Log::info(TAG, "Stopping hardware services (no-op)");
 }
 
-void HalInitService::onHealthCheck() {
+bool HalInitService::onHealthCheck() {
 	auto& registry = flx::hal::DeviceRegistry::getInstance();
 	auto report = registry.getHealthReport();
 
-	if (report.errorDevices > 0) {
-		flx::Log::warn(TAG, "Health check found %zu devices in error state.", report.errorDevices);
-		for (const auto& dev: report.unhealthyDevices) {
-			flx::Log::warn(TAG, "Device ID %lu is unhealthy", dev.first);
+	// Log changes only; a device stuck in error would otherwise log every interval
+	if (report.errorDevices != m_reportedErrorDevices) {
+		if (report.errorDevices > 0) {
+			flx::Log::warn(TAG, "Health check found %zu devices in error state.", report.errorDevices);
+			for (const auto& dev: report.unhealthyDevices) {
+				flx::Log::warn(TAG, "Device ID %lu is unhealthy", dev.first);
+			}
+		} else {
+			flx::Log::info(TAG, "All devices healthy again.");
 		}
+		m_reportedErrorDevices = report.errorDevices;
 	}
+	return report.errorDevices == 0;
 }
 
 } // namespace flx::system::services
@@ -0,0 +1,496 @@
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <flx/core/LogBuffer.hpp>
+#include <flx/core/Logger.hpp>
+#include <flx/kernel/Task.hpp>
+#include <flx/system/services/PersistentLogService.hpp>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace flx::services {
+
+static constexpr std::string_view TAG = "PersistentLog";
+
+static constexpr size_t RING_SIZE_PSRAM = 32 * 1024;
+static constexpr size_t RING_SIZE_INTERNAL = 8 * 1024;
+
+// ============================================================
+// Crash tail (survives panic / watchdog resets)
+// ============================================================
+
+static constexpr uint32_t CRASH_TAIL_MAGIC = 0x464C4F47; // "FLOG"
+static constexpr size_t CRASH_TAIL_SIZE = 2048;
+
+struct CrashTail {
+	uint32_t magic;
+	uint32_t head;
+	uint32_t size;
+	char data[CRASH_TAIL_SIZE];
+};
+
+static __NOINIT_ATTR CrashTail s_crashTail;
+
+static void crashTailReset() {
+	s_crashTail.head = 0;
+	s_crashTail.size = 0;
+	s_crashTail.magic = CRASH_TAIL_MAGIC;
+}
+
+static void crashTailAppend(char c) {
+	s_crashTail.data[s_crashTail.head] = c;
+	s_crashTail.head = (s_crashTail.head + 1) % CRASH_TAIL_SIZE;
+	if (s_crashTail.size < CRASH_TAIL_SIZE) s_crashTail.size++;
+}
+
+// ============================================================
+// Writer task
+// ============================================================
+
+class PersistentLogService::WriterTask : public flx::kernel::Task {
+public:
+
+	WriterTask() : Task("log_writer", 4096, 1, tskNO_AFFINITY) {}
+
+protected:
+
+	void run(void* /*data*/) override { PersistentLogService::getInstance().writerLoop(*this); }
+};
+
+// ============================================================
+// Service lifecycle
+// ============================================================
+
+const ServiceManifest PersistentLogService::serviceManifest = {
+	.serviceId = "com.flxos.logstore",
+	.serviceName = "Persistent Log",
+	.version = "1.0.0",
+	.dependencies = {},
+	.priority = 5,
+	.required = false,
+	.autoStart = true,
+	.guiRequired = false,
+	.healthIntervalMs = 10000,
+	.healthBudgetUs = 100,
+	.autoRestart = true,
+	.capabilities = ServiceCapability::Storage,
+	.description = "Batched, rotating log files under /data/logs",
+};
+
+PersistentLogService& PersistentLogService::getInstance() {
+	static PersistentLogService instance;
+	return instance;
+}
+
+bool PersistentLogService::onStart() {
+	if (mkdir(LOG_DIR, 0775) != 0 && errno != EEXIST) {
+		Log::warn(TAG, "Cannot create %s (errno %d)", LOG_DIR, errno);
+		return false;
+	}
+
+	if (!m_ring) {
+		if (heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0) {
+			m_ring = static_cast<uint8_t*>(heap_caps_malloc(RING_SIZE_PSRAM, MALLOC_CAP_SPIRAM));
+			m_capacity = RING_SIZE_PSRAM;
+			m_psram = m_ring != nullptr;
+		}
+		if (!m_ring) {
+			m_ring = static_cast<uint8_t*>(heap_caps_malloc(RING_SIZE_INTERNAL, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+			m_capacity = RING_SIZE_INTERNAL;
+		}
+		if (!m_ring) {
+			m_capacity = 0;
+			Log::error(TAG, "Failed to allocate log staging buffer");
+			return false;
+		}
+	}
+
+	recoverCrashTail();
+	m_lastWriteUs = esp_timer_get_time();
+
+	char banner[96];
+	int len = std::snprintf(banner, sizeof(banner), "---- boot (reset reason %d) ----\n", static_cast<int>(esp_reset_reason()));
+	if (len > 0) {
+		std::lock_guard<std::mutex> lock(m_bufMutex);
+		appendRaw(banner, std::min(static_cast<size_t>(len), sizeof(banner) - 1));
+	}
+
+	if (!m_writer) m_writer = std::make_unique<WriterTask>();
+	m_writer->start();
+
+	flx::LogWriter::setLineSink(&PersistentLogService::sink);
+	// Once per boot; restarts must not stack duplicate handlers
+	if (!m_shutdownHooked) {
+		// Handlers run in reverse order of registration, so log_drain's drain would run after this flush
+		esp_err_t const err = esp_register_shutdown_handler([]() {
+			flx::core::LogBuffer::drain(SIZE_MAX);
+			PersistentLogService::getInstance().flush();
+		});
+		if (err == ESP_OK) {
+			m_shutdownHooked = true;
+		} else {
+			Log::warn(TAG, "Failed to register shutdown flush: %s", esp_err_to_name(err));
+		}
+	}
+
+	Log::info(TAG, "Logging to %s (%zu KB %s buffer)", LOG_DIR, m_capacity / 1024, m_psram ? "PSRAM" : "internal");
+	return true;
+}
+
+void PersistentLogService::onStop() {
+	flx::LogWriter::setLineSink(nullptr);
+	if (m_writer && m_writer->isRunning()) {
+		m_writer->requestStop();
+		if (TaskHandle_t handle = m_writer->getHandle()) xTaskNotifyGive(handle);
+		m_writer->join();
+	}
+	flush();
+	Log::info(TAG, "Persistent logging stopped");
+}
+
+bool PersistentLogService::onHealthCheck() {
+	// Lines pile up in the ring and are dropped once the writer is gone
+	return m_writer && m_writer->isRunning();
+}
+
+// ============================================================
+// Capture (runs on the logging task)
+// ============================================================
+
+void PersistentLogService::sink(esp_log_level_t /*level*/, const char* line) {
+	getInstance().append(line);
+}
+
+void PersistentLogService::append(const char* line) {
+	// Strip ANSI colour sequences ("\033[...m") while measuring
+	size_t len = 0;
+	for (const char* p = line; *p; ++p) {
+		if (*p == '\033') {
+			while (*p && *p != 'm') ++p;
+			if (!*p) break;
+			continue;
+		}
+		len++;
+	}
+
+	bool wake = false;
+	{
+		std::lock_guard<std::mutex> lock(m_bufMutex);
+		if (!m_ring) return;
+		if (len > m_capacity - m_size) {
+			m_bytesDropped += static_cast<uint32_t>(len);
+			return;
+		}
+		size_t before = m_size;
+		for (const char* p = line; *p; ++p) {
+			if (*p == '\033') {
+				while (*p && *p != 'm') ++p;
+				if (!*p) break;
+				continue;
+			}
+			m_ring[m_head] = static_cast<uint8_t>(*p);
+			m_head = (m_head + 1) % m_capacity;
+			crashTailAppend(*p);
+		}
+		m_size += len;
+		m_bytesAccepted += static_cast<uint32_t>(len);
+		wake = before < SECTOR_SIZE && m_size >= SECTOR_SIZE;
+	}
+
+	// Only the sector-full edge wakes the writer; the idle flush is timer driven
+	if (wake && m_writer) {
+		if (TaskHandle_t handle = m_writer->getHandle()) xTaskNotifyGive(handle);
+	}
+}
+
+void PersistentLogService::appendRaw(const char* data, size_t len) {
+	// Caller holds m_bufMutex
+	len = std::min(len, m_capacity - m_size);
+	for (size_t i = 0; i < len; i++) {
+		m_ring[m_head] = static_cast<uint8_t>(data[i]);
+		m_head = (m_head + 1) % m_capacity;
+	}
+	m_size += len;
+	m_bytesAccepted += static_cast<uint32_t>(len);
+}
+
+void PersistentLogService::recoverCrashTail() {
+	esp_reset_reason_t reason = esp_reset_reason();
+	bool crashed = reason == ESP_RST_PANIC || reason == ESP_RST_INT_WDT || reason == ESP_RST_TASK_WDT || reason == ESP_RST_WDT;
+	bool valid = s_crashTail.magic == CRASH_TAIL_MAGIC && s_crashTail.size <= CRASH_TAIL_SIZE && s_crashTail.head < CRASH_TAIL_SIZE;
+
+	std::lock_guard<std::mutex> lock(m_bufMutex);
+	if (crashed && valid && s_crashTail.size > 0) {
+		static constexpr char HEADER[] = "---- last lines before reset ----\n";
+		appendRaw(HEADER, sizeof(HEADER) - 1);
+		size_t start = (s_crashTail.head + CRASH_TAIL_SIZE - s_crashTail.size) % CRASH_TAIL_SIZE;
+		size_t first = std::min<size_t>(s_crashTail.size, CRASH_TAIL_SIZE - start);
+		appendRaw(s_crashTail.data + start, first);
+		appendRaw(s_crashTail.data, s_crashTail.size - first);
+		m_recoveredBytes = s_crashTail.size;
+	}
+	crashTailReset();
+}
+
+// ============================================================
+// Flash writes (writer task, CLI, shutdown hook)
+// ============================================================
+
+std::string PersistentLogService::filePath(int index) {
+	return std::string(LOG_DIR) + "/log." + std::to_string(index);
+}
+
+bool PersistentLogService::rotateIfNeeded(size_t incoming) {
+	struct stat st {};
+	std::string current = filePath(0);
+	if (stat(current.c_str(), &st) != 0 || static_cast<size_t>(st.st_size) + incoming <= MAX_FILE_SIZE) {
+		return true;
+	}
+
+	unlink(filePath(MAX_FILES - 1).c_str());
+	for (int i = MAX_FILES - 2; i >= 0; i--) {
+		std::string from = filePath(i);
+		if (stat(from.c_str(), &st) == 0 && rename(from.c_str(), filePath(i + 1).c_str()) != 0) {
+			return false;
+		}
+	}
+	std::lock_guard<std::mutex> lock(m_bufMutex);
+	m_rotations++;
+	return true;
+}
+
+bool PersistentLogService::writeChunk(size_t maxBytes) {
+	std::lock_guard<std::mutex> fileLock(m_fileMutex);
+
+	// Snapshot the readable span; producers only write past it, so it stays
+	// stable until commit
+	size_t tail, count;
+	{
+		std::lock_guard<std::mutex> lock(m_bufMutex);
+		if (!m_ring || m_size == 0) return true;
+		count = std::min(m_size, maxBytes);
+		tail = (m_head + m_capacity - m_size) % m_capacity;
+	}
+
+	// Counters are read by getStats() under m_bufMutex
+	auto const fail = [this]() {
+		std::lock_guard<std::mutex> lock(m_bufMutex);
+		m_writeErrors++;
+		return false;
+	};
+
+	if (!rotateIfNeeded(count)) return fail();
+
+	int fd = open(filePath(0).c_str(), O_WRONLY | O_CREAT | O_APPEND, 0664);
+	if (fd < 0) return fail();
+
+	size_t first = std::min(count, m_capacity - tail);
+	bool ok = write(fd, m_ring + tail, first) == static_cast<ssize_t>(first);
+	if (ok && count > first) {
+		ok = write(fd, m_ring, count - first) == static_cast<ssize_t>(count - first);
+	}
+	ok = ok && fsync(fd) == 0;
+	close(fd);
+
+	if (!ok) return fail();
+
+	{
+		std::lock_guard<std::mutex> lock(m_bufMutex);
+		m_size -= count;
+		// Everything buffered is on flash: the crash tail has nothing left to save
+		if (m_size == 0) crashTailReset();
+		m_bytesWritten += static_cast<uint32_t>(count);
+		if (count == SECTOR_SIZE) {
+			m_sectorWrites++;
+		} else {
+			m_partialWrites++;
+		}
+	}
+	m_lastWriteUs = esp_timer_get_time();
+	return true;
+}
+
+bool PersistentLogService::flush() {
+	while (true) {
+		size_t buffered;
+		{
+			std::lock_guard<std::mutex> lock(m_bufMutex);
+			buffered = m_size;
+		}
+		if (buffered == 0) return true;
+		if (!writeChunk(SECTOR_SIZE)) return false;
+	}
+}
+
+void PersistentLogService::writerLoop(WriterTask& task) {
+	while (!task.shouldStop()) {
+		task.heartbeat();
+		ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+
+		size_t buffered;
+		{
+			std::lock_guard<std::mutex> lock(m_bufMutex);
+			buffered = m_size;
+		}
+
+		// Whole sectors as soon as they fill
+		while (buffered >= SECTOR_SIZE && !task.shouldStop()) {
+			if (!writeChunk(SECTOR_SIZE)) break;
+			task.heartbeat();
+			std::lock_guard<std::mutex> lock(m_bufMutex);
+			buffered = m_size;
+		}
+
+		// A partial sector only once logging has been quiet for a while
+		if (buffered > 0 && esp_timer_get_time() - m_lastWriteUs >= static_cast<int64_t>(IDLE_FLUSH_MS) * 1000) {
+			writeChunk(buffered);
+		}
+	}
+}
+
+// ============================================================
+// Reading
+// ============================================================
+
+std::string PersistentLogService::bufferedText() const {
+	std::lock_guard<std::mutex> lock(m_bufMutex);
+	std::string out;
+	if (!m_ring || m_size == 0) return out;
+	out.reserve(m_size);
+	size_t tail = (m_head + m_capacity - m_size) % m_capacity;
+	size_t first = std::min(m_size, m_capacity - tail);
+	out.append(reinterpret_cast<const char*>(m_ring + tail), first);
+	out.append(reinterpret_cast<const char*>(m_ring), m_size - first);
+	return out;
+}
+
+/**
+ * Return the last @p lines lines of @p path by scanning backwards.
+ */
+static std::string readTailLines(const std::string& path, size_t lines) {
+	FILE* f = fopen(path.c_str(), "rb");
+	if (!f) return {};
+	fseek(f, 0, SEEK_END);
+	long end = ftell(f);
+	long pos = end;
+	size_t newlines = 0;
+	char block[256];
+
+	// Find the start of the requested window
+	while (pos > 0 && newlines <= lines) {
+		long chunk = std::min<long>(pos, sizeof(block));
+		pos -= chunk;
+		fseek(f, pos, SEEK_SET);
+		size_t n = fread(block, 1, static_cast<size_t>(chunk), f);
+		for (size_t i = n; i-- > 0;) {
+			// The file's own trailing newline does not start a line
+			if (block[i] == '\n' && pos + static_cast<long>(i) != end - 1 && ++newlines > lines) {
+				pos += static_cast<long>(i) + 1;
+				break;
+			}
+		}
+	}
+
+	std::string out;
+	out.resize(static_cast<size_t>(end - pos));
+	fseek(f, pos, SEEK_SET);
+	out.resize(fread(out.data(), 1, out.size(), f));
+	fclose(f);
+	return out;
+}
+
+static size_t countLines(const std::string& text) {
+	return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+void PersistentLogService::tail(size_t lines) {
+	// Reads never force a flush, so tailing does not cost flash writes
+	std::string pending = bufferedText();
+	size_t pendingLines = countLines(pending);
+
+	if (pendingLines < lines) {
+		std::lock_guard<std::mutex> fileLock(m_fileMutex);
+		std::string fromFile = readTailLines(filePath(0), lines - pendingLines);
+		fwrite(fromFile.data(), 1, fromFile.size(), stdout);
+	} else {
+		// Skip the older buffered lines
+		size_t skip = pendingLines - lines;
+		size_t offset = 0;
+		while (skip > 0 && offset < pending.size()) {
+			offset = pending.find('\n', offset) + 1;
+			skip--;
+		}
+		pending.erase(0, offset);
+	}
+	fwrite(pending.data(), 1, pending.size(), stdout);
+	fflush(stdout);
+}
+
+bool PersistentLogService::exportTo(const std::string& path) {
+	FILE* out = path.empty() ? stdout : fopen(path.c_str(), "wb");
+	if (!out) return false;
+
+	{
+		std::lock_guard<std::mutex> fileLock(m_fileMutex);
+		char block[512];
+		for (int i = MAX_FILES - 1; i >= 0; i--) {
+			FILE* in = fopen(filePath(i).c_str(), "rb");
+			if (!in) continue;
+			size_t n;
+			while ((n = fread(block, 1, sizeof(block), in)) > 0) {
+				fwrite(block, 1, n, out);
+			}
+			fclose(in);
+		}
+	}
+
+	std::string pending = bufferedText();
+	fwrite(pending.data(), 1, pending.size(), out);
+
+	if (out == stdout) {
+		fflush(stdout);
+		return true;
+	}
+	bool ok = fflush(out) == 0 && fsync(fileno(out)) == 0;
+	fclose(out);
+	return ok;
+}
+
+void PersistentLogService::clear() {
+	std::lock_guard<std::mutex> fileLock(m_fileMutex);
+	for (int i = 0; i < MAX_FILES; i++) {
+		unlink(filePath(i).c_str());
+	}
+	std::lock_guard<std::mutex> lock(m_bufMutex);
+	m_size = 0;
+	crashTailReset();
+}
+
+PersistentLogService::Stats PersistentLogService::getStats() const {
+	std::lock_guard<std::mutex> lock(m_bufMutex);
+	return {
+		.capacity = m_capacity,
+		.buffered = m_size,
+		.psram = m_psram,
+		.bytesAccepted = m_bytesAccepted,
+		.bytesDropped = m_bytesDropped,
+		.bytesWritten = m_bytesWritten,
+		.sectorWrites = m_sectorWrites,
+		.partialWrites = m_partialWrites,
+		.rotations = m_rotations,
+		.writeErrors = m_writeErrors,
+		.recoveredBytes = m_recoveredBytes,
+	};
+}
+
+} // namespace flx::services
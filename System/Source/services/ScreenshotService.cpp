@@ -13,11 +13,12 @@
 // Forward-declare only the C functions we need — including lodepng.h directly
 // causes C++ overload conflicts when compiled in a C++ translation unit.
 extern "C" {
-unsigned lodepng_encode24_file(const char* filename, const unsigned char* image, unsigned w, unsigned h);
+unsigned lodepng_encode24(unsigned char** out, size_t* outsize, const unsigned char* image, unsigned w, unsigned h);
 const char* lodepng_error_text(unsigned code);
 }
 #include "lvgl.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
@@ -28,6 +29,28 @@ static constexpr std::string_view TAG = "ScreenshotService";
 
 namespace flx::services {
 
+// Overlay topics are resolved once; countdown ticks then publish without a name lookup
+static flx::core::EventBus::TopicId overlayShowTopic() {
+	static const auto topic = flx::core::EventBus::getInstance().registerTopic("ui.overlay.show");
+	return topic;
+}
+
+static flx::core::EventBus::TopicId overlayClearTopic() {
+	static const auto topic = flx::core::EventBus::getInstance().registerTopic("ui.overlay.clear");
+	return topic;
+}
+
+/**
+ * Clear the overlay for countdown @p generation. Shows are queued async and
+ * clears are synchronous, so the StatusBar drops any show of this generation
+ * or older that is delivered after the clear.
+ */
+static void clearOverlay(uint32_t generation) {
+	flx::core::Bundle data;
+	data.putInt64("generation", generation);
+	flx::core::EventBus::getInstance().publish(overlayClearTopic(), data);
+}
+
 const ServiceManifest ScreenshotService::serviceManifest = {
 	.serviceId = "com.flxos.screenshot",
 	.serviceName = "Screenshot Service",
@@ -51,7 +74,7 @@ void ScreenshotService::onStop() {
 	Log::info(TAG, "Screenshot service stopped");
 }
 
-bool ScreenshotService::capture(const std::string& savePath) {
+flx::kernel::Future<bool> ScreenshotService::capture(const std::string& savePath) {
 	flx::core::GuiLock::lock();
 
 	lv_obj_t* screen = lv_screen_active();
@@ -62,7 +85,7 @@ bool ScreenshotService::capture(const std::string& savePath) {
 	if (!snap || !snap->data) {
 		Log::error(TAG, "lv_snapshot_take(RGB888) failed");
 		flx::core::GuiLock::unlock();
-		return false;
+		return flx::kernel::makeReadyFuture(false);
 	}
 
 	// LVGL RGB888 stores as B-G-R per pixel, lodepng needs R-G-B
@@ -75,7 +98,7 @@ bool ScreenshotService::capture(const std::string& savePath) {
 		Log::error(TAG, "Failed to allocate RGB buffer (%u bytes)", (unsigned)rgbSize);
 		lv_draw_buf_destroy(snap);
 		flx::core::GuiLock::unlock();
-		return false;
+		return flx::kernel::makeReadyFuture(false);
 	}
 
 	// Copy with BGR→RGB swap, handling stride
@@ -90,34 +113,67 @@ bool ScreenshotService::capture(const std::string& savePath) {
 	}
 
 	lv_draw_buf_destroy(snap);
+	flx::core::GuiLock::unlock();
 
-	// Save as PNG via lodepng
-	// Note: Hold GuiLock during file write to prevent SPI contention with display
-	unsigned error = lodepng_encode24_file(savePath.c_str(), rgbBuf, width, height);
-	free(rgbBuf);
+	// Encoding takes seconds at full resolution; keep it off the render loop
+	return flx::kernel::Executor::getInstance().submit([savePath, rgbBuf, width, height]() {
+		unsigned char* png = nullptr;
+		size_t pngSize = 0;
+		unsigned error = lodepng_encode24(&png, &pngSize, rgbBuf, width, height);
+		free(rgbBuf);
+
+		if (error) {
+			Log::error(TAG, "PNG encode failed (error %u): %s", error, lodepng_error_text(error));
+			lv_free(png);
+			return false;
+		}
 
-	flx::core::GuiLock::unlock();
+		// Hold GuiLock during the file write to prevent SPI contention with the display
+		flx::core::GuiLock::lock();
+		FILE* f = fopen(savePath.c_str(), "wb");
+		bool ok = f && fwrite(png, 1, pngSize, f) == pngSize;
+		if (f) ok = (fclose(f) == 0) && ok;
+		flx::core::GuiLock::unlock();
+		lv_free(png); // lodepng allocates through lv_malloc
 
-	if (error) {
-		Log::error(TAG, "PNG encode failed (error %u): %s", error, lodepng_error_text(error));
-		flx::system::NotificationManager::getInstance().addNotification(
-			"Screenshot Failed",
-			"Could not save image",
-			"System",
-			LV_SYMBOL_WARNING,
-			2 // High priority
-		);
-		return false;
+		if (!ok) {
+			Log::error(TAG, "Failed to write %s", savePath.c_str());
+			return false;
+		}
+		Log::info(TAG, "Screenshot saved: %s (%dx%d, %u bytes)", savePath.c_str(), width, height, (unsigned)pngSize);
+		return true;
+	});
+}
+
+void ScreenshotService::captureAndNotify(const std::string& path, CaptureCallback onComplete) {
+	if (path.empty()) {
+		Log::error(TAG, "Failed to generate screenshot filename");
+		if (onComplete) onComplete(false, "");
+		return;
 	}
 
-	Log::info(TAG, "Screenshot saved: %s (%dx%d)", savePath.c_str(), width, height);
-	flx::system::NotificationManager::getInstance().addNotification(
-		"Screenshot Saved",
-		savePath,
-		"System",
-		LV_SYMBOL_IMAGE
+	capture(path).then(
+		[path, onComplete](bool success) {
+			if (success) {
+				flx::system::NotificationManager::getInstance().addNotification(
+					"Screenshot Saved",
+					path,
+					"System",
+					LV_SYMBOL_IMAGE
+				);
+			} else {
+				flx::system::NotificationManager::getInstance().addNotification(
+					"Screenshot Failed",
+					"Could not save image",
+					"System",
+					LV_SYMBOL_WARNING,
+					2 // High priority
+				);
+			}
+			if (onComplete) onComplete(success, path);
+		},
+		flx::kernel::RunOn::Gui
 	);
-	return true;
 }
 
 uint32_t ScreenshotService::getDefaultDelay() const {
@@ -170,103 +226,51 @@ std::string ScreenshotService::generateFilename(const std::string& basePath) {
 
 ScreenshotService::ScreenshotService() = default;
 
-ScreenshotService::~ScreenshotService() {
-	if (m_timer) {
-		lv_timer_delete(m_timer);
-		m_timer = nullptr;
-	}
-}
+ScreenshotService::~ScreenshotService() = default;
 
 void ScreenshotService::scheduleCapture(uint32_t delaySec, const std::string& storagePath, CaptureCallback onComplete) {
-	// Cancel any existing pending capture/timer
+	// Cancel any existing pending countdown
 	cancelCapture();
 
-	m_onComplete = onComplete; // Store new callback
-	m_storagePath = storagePath.empty() ? getDefaultStoragePath() : storagePath;
+	std::string const path = storagePath.empty() ? getDefaultStoragePath() : storagePath;
 
 	if (delaySec == 0) {
 		// Instant capture
-		std::string path = generateFilename(m_storagePath);
-		if (path.empty()) {
-			Log::error(TAG, "Failed to generate screenshot filename");
-			if (m_onComplete) {
-				m_onComplete(false, "");
-				m_onComplete = nullptr;
-			}
-			return;
-		}
-		bool res = capture(path);
-
-		if (m_onComplete) {
-			m_onComplete(res, path);
-			m_onComplete = nullptr;
-		}
+		captureAndNotify(generateFilename(path), std::move(onComplete));
 		return;
 	}
 
-	m_countdownRemaining = static_cast<int>(delaySec);
-	if (m_countdownRemaining < 1) m_countdownRemaining = 1;
-
-	// Show initial overlay
-	char buf[16];
-	snprintf(buf, sizeof(buf), LV_SYMBOL_IMAGE " %d", m_countdownRemaining);
-	flx::core::Bundle data;
-	data.putString("text", buf);
-	flx::core::EventBus::getInstance().publish("ui.overlay.show", data);
-
-	if (m_timer) {
-		lv_timer_reset(m_timer);
-		lv_timer_resume(m_timer);
-	} else {
-		m_timer = lv_timer_create(
-			[](lv_timer_t* t) {
-				auto* self = static_cast<ScreenshotService*>(lv_timer_get_user_data(t));
-				self->onTimerTick();
-			},
-			1000, this
-		);
-	}
+	int const seconds = std::max(static_cast<int>(delaySec), 1);
+	flx::kernel::co::spawn(countdown(m_generation.load(), seconds, path, std::move(onComplete)));
 }
 
 void ScreenshotService::cancelCapture() {
-	if (m_timer) {
-		lv_timer_pause(m_timer);
-	}
-	flx::core::EventBus::getInstance().publish("ui.overlay.clear", flx::core::Bundle());
-	m_onComplete = nullptr;
+	// A running countdown sees the new generation and gives up
+	clearOverlay(m_generation.fetch_add(1));
 }
 
-void ScreenshotService::onTimerTick() {
-	m_countdownRemaining--;
-
-	if (m_countdownRemaining <= 0) {
-		// Stop timer
-		lv_timer_pause(m_timer);
-
-		// Clear overlay
-		flx::core::EventBus::getInstance().publish("ui.overlay.clear", flx::core::Bundle());
-
-		// Capture
-		std::string path = generateFilename(m_storagePath);
-		bool res = false;
-		if (path.empty()) {
-			Log::error(TAG, "Failed to generate screenshot filename");
-		} else {
-			res = capture(path);
-		}
+flx::kernel::co::Task<void> ScreenshotService::countdown(uint32_t generation, int seconds, std::string storagePath, CaptureCallback onComplete) {
+	for (int remaining = seconds; remaining > 0; remaining--) {
+		if (m_generation.load() != generation) co_return;
 
-		if (m_onComplete) {
-			m_onComplete(res, path);
-			m_onComplete = nullptr;
-		}
-	} else {
 		// Update overlay
 		char buf[16];
-		snprintf(buf, sizeof(buf), LV_SYMBOL_IMAGE " %d", m_countdownRemaining);
+		snprintf(buf, sizeof(buf), LV_SYMBOL_IMAGE " %d", remaining);
 		flx::core::Bundle data;
 		data.putString("text", buf);
-		flx::core::EventBus::getInstance().publish("ui.overlay.show", data);
+		data.putInt64("generation", generation);
+		flx::core::EventBus::getInstance().publishAsync(overlayShowTopic(), data, {.coalesce = true});
+
+		co_await flx::kernel::co::delay(1000);
 	}
+
+	// The overlay handler and the snapshot take GuiLock, which the runtime task must not wait on
+	co_await flx::kernel::co::offload([this, generation, storagePath, onComplete]() {
+		if (m_generation.load() != generation) return;
+		// Clear overlay synchronously so the badge is gone before the snapshot
+		clearOverlay(generation);
+		captureAndNotify(generateFilename(storagePath), onComplete);
+	});
 }
 
 } // namespace flx::services
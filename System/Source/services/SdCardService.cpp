@@ -1,5 +1,8 @@
 #include "sdkconfig.h"
 #include <Config.hpp>
+#include <cinttypes>
+#include <cstdio>
+#include <flx/core/BootCache.hpp>
 #include <flx/core/Logger.hpp>
 #include <flx/hal/DeviceRegistry.hpp>
 #include <flx/hal/sdcard/SpiSdCardDevice.hpp>
@@ -10,10 +13,40 @@ namespace flx::services {
 
 static constexpr std::string_view TAG = "SdCardService";
 
+// The card mounted last boot: "<serial> <negotiated kHz> <capacity bytes>"
+static constexpr const char* CARD_CACHE_KEY = "sdcard.card";
+
+namespace {
+
+struct CachedCard {
+	uint32_t serial = 0;
+	uint32_t freqKhz = 0;
+	uint64_t totalBytes = 0;
+};
+
+bool loadCachedCard(CachedCard& card) {
+	std::string value;
+	if (!flx::core::BootCache::getInstance().get(CARD_CACHE_KEY, value)) return false;
+	unsigned long serial = 0;
+	unsigned long freq = 0;
+	unsigned long long total = 0;
+	if (sscanf(value.c_str(), "%lx %lu %llu", &serial, &freq, &total) != 3 || freq == 0) return false;
+	card = {static_cast<uint32_t>(serial), static_cast<uint32_t>(freq), static_cast<uint64_t>(total)};
+	return true;
+}
+
+void storeCachedCard(const flx::hal::sdcard::ISdCardDevice::CardInfo& info) {
+	char value[48];
+	snprintf(value, sizeof(value), "%08lx %lu %llu", (unsigned long)info.serial, (unsigned long)info.maxFreqKhz, (unsigned long long)info.totalBytes);
+	flx::core::BootCache::getInstance().put(CARD_CACHE_KEY, value);
+}
+
+} // namespace
+
 const ServiceManifest SdCardService::serviceManifest = {
 	.serviceId = "com.flxos.sdcard",
 	.serviceName = "SD Card",
-	.dependencies = {},
+	.dependencies = {"com.flxos.hal"}, // May share an SPI bus that HAL init brings up
 	.priority = 15,
 	.required = false,
 	.autoStart = true,
@@ -39,14 +72,38 @@ bool SdCardService::onStart() {
 	registry.registerDevice(sdcard);
 	m_device = sdcard;
 
+	// Negotiate no higher than the card in the slot last boot managed
+	CachedCard cached;
+	const bool warm = loadCachedCard(cached);
+	if (warm) sdcard->setMaxFreqKhz(cached.freqKhz);
+
 	// Mount it
-	const bool mounted = m_device->mount(flx::config::sdcard.mountPoint);
+	bool mounted = m_device->mount(flx::config::sdcard.mountPoint);
+	if (!mounted && warm && cached.freqKhz < static_cast<uint32_t>(flx::config::sdcard.maxFreqKhz)) {
+		Log::info(TAG, "Mount with cached parameters failed, probing the card again");
+		flx::core::BootCache::getInstance().invalidate(CARD_CACHE_KEY);
+		sdcard->setMaxFreqKhz(0);
+		mounted = m_device->mount(flx::config::sdcard.mountPoint);
+	}
+
 	if (mounted) {
 		Log::info(TAG, "Mounted SD card via HAL");
+		// The cache holds the raw card capacity, not the FAT volume size getCardInfo() reports
+		flx::hal::sdcard::ISdCardDevice::CardInfo identity;
 		flx::hal::sdcard::ISdCardDevice::CardInfo info;
-		if (m_device->getCardInfo(info)) {
+		const bool identified = m_device->getCardIdentity(identity);
+		const bool known = identified && warm && identity.serial == cached.serial && identity.totalBytes == cached.totalBytes;
+		if (known) {
+			// Same card as last boot; free space is read when something asks for it
+			Log::info(TAG, "SD Card Info: Size: %llu MB, FS: %s (known card %08" PRIx32 ")", (unsigned long long)(identity.totalBytes / (1024ULL * 1024ULL)), identity.fsType.c_str(), identity.serial);
+		} else if (m_device->getCardInfo(info)) {
 			Log::info(TAG, "SD Card Info: Size: %llu MB, Free: %llu MB, FS: %s", (unsigned long long)(info.totalBytes / (1024ULL * 1024ULL)), (unsigned long long)(info.freeBytes / (1024ULL * 1024ULL)), info.fsType.c_str());
 		}
+		if (identified && !known) {
+			// A new card negotiated under the old card's cap; let the next boot find its own speed
+			if (warm && identity.serial != cached.serial) identity.maxFreqKhz = flx::config::sdcard.maxFreqKhz;
+			storeCachedCard(identity);
+		}
 	} else {
 		Log::warn(TAG, "Failed to mount SD card via HAL");
 	}
@@ -367,6 +367,16 @@ std::vector<TaskInfo> SystemInfoService::getTaskList(size_t maxTasks) {
 	uint32_t const runtime_delta = total_runtime - m_lastTotalRuntime;
 	m_lastTotalRuntime = total_runtime;
 
+	// Prefer the monitor's interval figures: current load rather than the
+	// load since whoever called getTaskList() last
+	auto const loads = flx::kernel::ResourceMonitorTask::getInstance().getLoadSummary();
+	auto const findLoad = [&loads](TaskHandle_t handle) -> const flx::kernel::ResourceMonitorTask::LoadSummary* {
+		for (const auto& load: loads) {
+			if (load.handle == handle) return &load;
+		}
+		return nullptr;
+	};
+
 	// Cache core count (static, never changes)
 	static int const cores = []() {
 		esp_chip_info_t chip_info;
@@ -384,7 +394,10 @@ std::vector<TaskInfo> SystemInfoService::getTaskList(size_t maxTasks) {
 		info.runtime = task_array[i].ulRunTimeCounter;
 
 		// Calculate CPU usage
-		if (runtime_delta > 0) {
+		if (const auto* current = findLoad(task_array[i].xHandle)) {
+			info.cpuUsagePercent = current->cpuPercent;
+			info.cpuPeakPercent = current->peakPercent;
+		} else if (runtime_delta > 0) {
 			TaskHandle_t handle = task_array[i].xHandle;
 			auto it = m_taskTracking.find(handle);
 			if (it != m_taskTracking.end()) {
@@ -438,6 +451,10 @@ std::vector<TaskInfo> SystemInfoService::getTaskList(size_t maxTasks) {
 	return tasks;
 }
 
+std::vector<flx::kernel::ResourceMonitorTask::Sample> SystemInfoService::getTaskHistory(size_t maxSamples) {
+	return flx::kernel::ResourceMonitorTask::getInstance().getHistory(maxSamples);
+}
+
 std::string SystemInfoService::formatBytes(uint32_t bytes) {
 	char buffer[32];
 	if (bytes < 1024) {
@@ -18,7 +18,7 @@ public:
 	GuiTask();
 	~GuiTask() override = default;
 
-	static void lock() { flx::core::GuiLock::lock(); }
+	static void lock(const std::source_location& site = std::source_location::current()) { flx::core::GuiLock::lock(site); }
 	static void unlock() { flx::core::GuiLock::unlock(); }
 
 	static void perform(std::function<void()> func) {
@@ -2,8 +2,10 @@
 
 #include "lvgl.h"
 #include "misc/lv_async.h"
+#include <atomic>
 #include <flx/core/Observable.hpp>
 #include <flx/ui/GuiTask.hpp>
+#include <mutex>
 
 namespace flx::ui {
 
@@ -14,6 +16,10 @@ namespace flx::ui {
  * Changes in either direction are synchronized:
  * - flx::Observable changes -> LVGL subject updated
  * - LVGL subject changes -> flx::Observable updated
+ *
+ * Observable changes are coalesced: at most one lv_async_call is queued per
+ * bridge, and it applies the latest value, so a burst of sets costs one
+ * subject update per lv_timer_handler pass (see ObservableStats).
  */
 template<typename T>
 class LvglObserverBridge {
@@ -22,13 +28,18 @@ public:
 	LvglObserverBridge(flx::Observable<T>& observable) : m_observable(observable) {
 		// Initialize LVGL subject with current observable value
 		m_pending_val = observable.get();
-		lv_subject_init_int(&m_subject, static_cast<int32_t>(m_pending_val));
+		lv_subject_init_int(&m_subject, static_cast<int32_t>(m_pending_val.load()));
 
 		// Subscribe to flx::Observable changes and update LVGL subject asynchronously
 		observable.subscribe([this](const T& value) {
 			if (!m_updating) {
-				m_pending_val = value;
-				lv_async_call(async_cb, this);
+				m_pending_val.store(value, std::memory_order_relaxed);
+				if (m_async_queued.exchange(true, std::memory_order_acq_rel)) {
+					// An update is already queued for this pass; it will pick up the new value
+					flx::ObservableStats::bridgeCollapsed.fetch_add(1, std::memory_order_relaxed);
+				} else {
+					lv_async_call(async_cb, this);
+				}
 			}
 		});
 
@@ -50,17 +61,21 @@ private:
 	static void async_cb(void* user_data) {
 		auto* self = static_cast<LvglObserverBridge*>(user_data);
 		if (self) {
-			// We are in GUI context (Lock held by run loop)
+			// We are in GUI context (Lock held by run loop). Clear the flag before
+			// reading so a set() racing with this pass queues a fresh update.
+			self->m_async_queued.store(false, std::memory_order_release);
 			self->m_updating = true;
-			lv_subject_set_int(&self->m_subject, static_cast<int32_t>(self->m_pending_val));
+			lv_subject_set_int(&self->m_subject, static_cast<int32_t>(self->m_pending_val.load(std::memory_order_relaxed)));
 			self->m_updating = false;
+			flx::ObservableStats::bridgeApplied.fetch_add(1, std::memory_order_relaxed);
 		}
 	}
 
 	flx::Observable<T>& m_observable;
 	lv_subject_t m_subject {};
 	bool m_updating = false;
-	T m_pending_val {}; // Accessed by both threads, assumed atomic for word-sized types
+	std::atomic<T> m_pending_val {}; // Written by the notifying task, read on the GUI task
+	std::atomic<bool> m_async_queued {false};
 };
 
 /**
@@ -74,12 +89,21 @@ public:
 		m_buffer = observable.get();
 		lv_subject_init_pointer(&m_subject, (void*)m_buffer.c_str());
 
-		// Subscribe to flx::Observable changes
+		// Subscribe to flx::Observable changes (coalesced like the integer bridge)
 		observable.subscribe([this](const std::string& value) {
 			if (!m_updating) {
-				// Allocate data for async transfer
-				auto* data = new AsyncUpdateData {this, value};
-				lv_async_call(async_cb, data);
+				bool queued;
+				{
+					std::lock_guard<std::mutex> lock(m_pending_mutex);
+					m_pending = value;
+					queued = m_async_queued;
+					m_async_queued = true;
+				}
+				if (queued) {
+					flx::ObservableStats::bridgeCollapsed.fetch_add(1, std::memory_order_relaxed);
+				} else {
+					lv_async_call(async_cb, this);
+				}
 			}
 		});
 
@@ -98,28 +122,30 @@ public:
 
 private:
 
-	struct AsyncUpdateData {
-		LvglStringObserverBridge* self;
-		std::string value;
-	};
-
 	static void async_cb(void* user_data) {
-		auto* data = static_cast<AsyncUpdateData*>(user_data);
-		if (data && data->self) {
-			auto* self = data->self;
+		auto* self = static_cast<LvglStringObserverBridge*>(user_data);
+		if (self) {
 			// GUI Lock is held
+			{
+				std::lock_guard<std::mutex> lock(self->m_pending_mutex);
+				self->m_buffer = self->m_pending; // Update local buffer
+				self->m_async_queued = false;
+			}
 			self->m_updating = true;
-			self->m_buffer = data->value; // Update local buffer
 			lv_subject_set_pointer(&self->m_subject, (void*)self->m_buffer.c_str());
 			self->m_updating = false;
+			flx::ObservableStats::bridgeApplied.fetch_add(1, std::memory_order_relaxed);
 		}
-		delete data;
 	}
 
 	flx::StringObservable& m_observable;
 	lv_subject_t m_subject {};
 	std::string m_buffer {}; // Keep string alive for LVGL
 	bool m_updating = false; // Prevent infinite update loops
+
+	std::mutex m_pending_mutex; // Guards m_pending / m_async_queued across tasks
+	std::string m_pending {};
+	bool m_async_queued = false;
 };
 
 } // namespace flx::ui
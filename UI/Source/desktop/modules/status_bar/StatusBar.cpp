@@ -14,9 +14,11 @@
 #include "misc/lv_types.h"
 #include "widgets/image/lv_image.h"
 #include "widgets/label/lv_label.h"
+#include <algorithm>
 #include <cstdint>
 #include <ctime>
 #include <flx/core/EventBus.hpp>
+#include <flx/core/GuiLockGuard.hpp>
 #include <flx/system/SystemManager.hpp>
 #include <flx/system/managers/NotificationManager.hpp>
 #include <flx/system/managers/PowerManager.hpp>
@@ -33,6 +35,9 @@ namespace UI::Modules {
 lv_obj_t* StatusBar::s_overlayLabel = nullptr;
 lv_obj_t* StatusBar::s_statusBarInstance = nullptr;
 
+// Newest overlay generation cleared; async shows from before it are stale (guarded by GuiLock)
+static int64_t s_overlayClearedGeneration = -1;
+
 StatusBar::StatusBar(lv_obj_t* parent) : m_parent(parent) {
 	create();
 }
@@ -313,16 +318,22 @@ void StatusBar::create() {
 		1000, m_timeLabel
 	);
 
-	// Event subscriptions for Overlay
+	// Event subscriptions for Overlay (published async, delivered on the event dispatcher task)
 	flx::core::EventBus::getInstance().subscribe("ui.overlay.show", [this](const std::string& /*event*/, const flx::core::Bundle& data) {
 		std::string const text = data.getString("text");
+		int64_t const generation = data.getInt64Or("generation", -1);
+		flx::core::GuiLockGuard lock;
+		if (generation >= 0 && generation <= s_overlayClearedGeneration) return;
 		if (s_overlayLabel) {
 			lv_label_set_text(s_overlayLabel, text.c_str());
 			lv_obj_remove_flag(s_overlayLabel, LV_OBJ_FLAG_HIDDEN);
 		}
 	});
 
-	flx::core::EventBus::getInstance().subscribe("ui.overlay.clear", [this](const std::string& /*event*/, const flx::core::Bundle& /*data*/) {
+	flx::core::EventBus::getInstance().subscribe("ui.overlay.clear", [this](const std::string& /*event*/, const flx::core::Bundle& data) {
+		int64_t const generation = data.getInt64Or("generation", -1);
+		flx::core::GuiLockGuard lock;
+		s_overlayClearedGeneration = std::max(s_overlayClearedGeneration, generation);
 		if (s_overlayLabel) {
 			lv_obj_add_flag(s_overlayLabel, LV_OBJ_FLAG_HIDDEN);
 		}
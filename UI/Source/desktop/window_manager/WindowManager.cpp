@@ -1,4 +1,5 @@
 #include <flx/core/Logger.hpp>
+#include <flx/core/Trace.hpp>
 #include <flx/ui/desktop/window_manager/WindowManager.hpp>
 #include <flx/ui/theming/layout_constants/LayoutConstants.hpp>
 #include <flx/ui/theming/ui_constants/UiConstants.hpp>
@@ -52,6 +53,7 @@ void WindowManager::init(lv_obj_t* window_container, lv_obj_t* app_container, lv
 }
 
 void WindowManager::openApp(const std::string& packageName) {
+	FLX_TRACE_SCOPE("WindowManager::openApp");
 	GuiTask::lock();
 
 	if (activateIfOpen(packageName)) {
@@ -89,7 +91,10 @@ void WindowManager::openApp(const std::string& packageName) {
 
 	setupWindowHeader(win, app.get());
 
-	app->createUI(lv_win_get_content(win));
+	{
+		FLX_TRACE_SCOPE("App::createUI");
+		app->createUI(lv_win_get_content(win));
+	}
 
 	// Register window for event-based focus management
 	flx::ui::FocusManager::getInstance().registerWindow(win);
@@ -6,6 +6,7 @@
 #include "lgfx/v1/lgfx_fonts.hpp"
 #include "libs/fsdrv/lv_fsdrv.h"
 #include "lv_init.h"
+#include "misc/lv_async.h"
 #include "misc/lv_timer.h"
 #include "misc/lv_types.h"
 #include "portmacro.h"
@@ -14,9 +15,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <flx/apps/AppManager.hpp>
+#include <flx/core/BootTimeline.hpp>
 #include <flx/core/EventBus.hpp>
 #include <flx/core/GuiLock.hpp>
 #include <flx/core/Logger.hpp>
+#include <flx/core/Trace.hpp>
+#include <flx/kernel/Executor.hpp>
 #include <flx/kernel/TaskManager.hpp>
 #include <flx/services/ServiceRegistry.hpp>
 #include <flx/system/SystemManager.hpp>
@@ -72,10 +76,20 @@ void GuiTask::display_init() {
 	lv_tick_set_cb([]() { return (uint32_t)(esp_timer_get_time() / 1000); });
 }
 
+static void finishBootTimeline() {
+	flx::core::BootTimeline::mark("first_frame");
+	flx::core::BootTimeline::freeze();
+	// Keep the flash write off the render loop
+	flx::kernel::Executor::getInstance().post([]() { flx::core::BootTimeline::save(); });
+}
+
 void GuiTask::run(void* /*data*/) {
 	lock();
 	Log::info(TAG, "Initializing GUI components...");
-	display_init();
+	{
+		flx::core::BootPhase phase("display_init");
+		display_init();
+	}
 	::ThemeEngine::init();
 
 	// Initialize GUI-dependent services and apps
@@ -83,7 +97,10 @@ void GuiTask::run(void* /*data*/) {
 	flx::apps::AppManager::getInstance().init();
 
 	flx::ui::theming::UiThemeManager::getInstance().init();
-	UI::Desktop::getInstance().init();
+	{
+		flx::core::BootPhase phase("Desktop::init");
+		UI::Desktop::getInstance().init();
+	}
 
 	// Initialize brightness from settings
 	auto& displayMgr = flx::system::DisplayManager::getInstance();
@@ -163,6 +180,33 @@ void GuiTask::run(void* /*data*/) {
 		runDisplayTest(data.getInt32("color"));
 	});
 
+	// The boot ends when the first frame reaches the panel
+	if (lv_disp) {
+		lv_display_add_event_cb(
+			lv_disp, [](lv_event_t* /*e*/) {
+				if (!flx::core::BootTimeline::isFrozen()) finishBootTimeline();
+			},
+			LV_EVENT_FLUSH_FINISH, nullptr
+		);
+	} else {
+		finishBootTimeline();
+	}
+
+	// Executor continuations with RunOn::Gui run from lv_timer_handler
+	flx::kernel::Executor::getInstance().setGuiDispatcher([](flx::kernel::Executor::Job job) {
+		auto* pending = new flx::kernel::Executor::Job(std::move(job));
+		lock();
+		lv_async_call(
+			[](void* data) {
+				auto* job = static_cast<flx::kernel::Executor::Job*>(data);
+				(*job)();
+				delete job;
+			},
+			pending
+		);
+		unlock();
+	});
+
 	unlock();
 
 	Log::info(TAG, "GUI task loop started");
@@ -174,6 +218,7 @@ void GuiTask::run(void* /*data*/) {
 			lock();
 			uint32_t delay = 10;
 			if (!m_paused) {
+				FLX_TRACE_SCOPE("lv_timer_handler");
 				delay = lv_timer_handler();
 			}
 			unlock();
@@ -10,6 +10,8 @@ Usage:
     python flxos.py info <id>                Show profile details
     python flxos.py new <id>                 Scaffold profile YAML
     python flxos.py diff <a> <b> [--json]    Compare two profiles
+    python flxos.py boottime show <file>     Show a saved boot timeline
+    python flxos.py boottime compare <a> <b> Fail if boot <b> is slower than <a>
     python flxos.py hwgen [id] [--all]       Generate HWD init scaffold from profile.yaml
     python flxos.py flash [--port]           Flash current build
     python flxos.py release <version>        Package release artifacts
@@ -590,6 +592,11 @@ def cmd_validate(args):
     allow_name_string = bool(get_nested(schema, "fields.name.allow_string", True))
     allow_name_list = bool(get_nested(schema, "fields.name.allow_list", True))
     sdkconfig_key_pattern = str(get_nested(schema, "patterns.sdkconfig_key", r"^CONFIG_[A-Z0-9_]+$"))
+    valid_log_levels = [str(v).lower() for v in get_nested(schema, "enums.log_level", ["none", "error", "warn", "info", "debug", "verbose"])]
+    valid_log_modules = [str(v) for v in get_nested(schema, "fields.logging.modules", [])]
+    stack_min = int(get_nested(schema, "fields.scheduling.tasks.stack_min", 1024))
+    valid_cores = [str(v) for v in get_nested(schema, "fields.scheduling.tasks.cores", [0, 1, "any"])]
+    priority_max = int(get_nested(schema, "fields.scheduling.tasks.priority_max", 24))
 
     if args.profile_id:
         profiles = []
@@ -675,6 +682,49 @@ def cmd_validate(args):
                         f"Invalid sdkconfig key '{key}'. Must match pattern: {sdkconfig_key_pattern}"
                     )
 
+        # Compile-time log levels
+        logging = p.get("logging", {}) or {}
+        if not isinstance(logging, dict):
+            errors.append("Field 'logging' must be a map")
+        else:
+            level = logging.get("level")
+            if level is not None and str(level).lower() not in valid_log_levels:
+                errors.append(f"Invalid logging.level '{level}'. Valid: {valid_log_levels}")
+            modules = logging.get("modules", {}) or {}
+            if not isinstance(modules, dict):
+                errors.append("Field 'logging.modules' must be a module: level map")
+            else:
+                for module, module_level in modules.items():
+                    if valid_log_modules and str(module) not in valid_log_modules:
+                        errors.append(f"Unknown module '{module}' in logging.modules. Valid: {valid_log_modules}")
+                    if str(module_level).lower() not in valid_log_levels:
+                        errors.append(f"Invalid level '{module_level}' for logging.modules.{module}. Valid: {valid_log_levels}")
+
+        # Per-task scheduling overrides
+        scheduling = p.get("scheduling", {}) or {}
+        tasks = scheduling.get("tasks", {}) if isinstance(scheduling, dict) else None
+        if tasks is None or not isinstance(tasks or {}, dict):
+            errors.append("Field 'scheduling.tasks' must be a task-name: settings map")
+        else:
+            for task, settings in (tasks or {}).items():
+                if not isinstance(settings, dict):
+                    errors.append(f"scheduling.tasks.{task} must be a map")
+                    continue
+                stack = settings.get("stack")
+                if stack is not None and (not isinstance(stack, int) or stack < stack_min):
+                    errors.append(f"Invalid stack '{stack}' for scheduling.tasks.{task}. Expected bytes, at least {stack_min}")
+                core = settings.get("core")
+                if core is not None and str(core) not in valid_cores:
+                    errors.append(f"Invalid core '{core}' for scheduling.tasks.{task}. Valid: {valid_cores}")
+                priority = settings.get("priority")
+                if priority is not None and (not isinstance(priority, int) or not 0 <= priority <= priority_max):
+                    errors.append(f"Invalid priority '{priority}' for scheduling.tasks.{task}. Expected 0-{priority_max}")
+
+        arena = scheduling.get("arena", {}) if isinstance(scheduling, dict) else {}
+        for key, value in (arena or {}).items():
+            if key not in ("internal", "psram") or not isinstance(value, int) or value < 0:
+                errors.append(f"Invalid scheduling.arena.{key} '{value}'. Expected internal/psram bytes")
+
         # SPIRAM speed / flash freq sync check
         spiram = p.get("hardware", {}).get("spiram", {})
         if spiram.get("enabled") and spiram.get("speed") == "120M":
@@ -995,6 +1045,133 @@ def cmd_diff(args):
     return 0
 
 
+def parse_boot_timeline(path: Path) -> Optional[dict]:
+    """Read a boot timeline from a boot.tl file or a captured console log.
+
+    Console logs (CONFIG_FLXOS_BOOT_TIMELINE_CONSOLE) contain the same block
+    between 'flxboot 1' and 'end'; the last complete block wins.
+    """
+    timeline = None
+    current = None
+    for raw in path.read_text(errors="replace").splitlines():
+        line = raw.strip()
+        if line == "flxboot 1":
+            current = {"build": "", "reset": 0, "phases": []}
+        elif current is None:
+            continue
+        elif line == "end":
+            timeline = current
+            current = None
+        elif line.startswith("build "):
+            current["build"] = line[6:]
+        elif line.startswith("reset "):
+            current["reset"] = int(line[6:])
+        else:
+            m = re.match(r"^(\d+) (\d+) (.+)$", line)
+            if not m:
+                continue  # Interleaved log output from another task
+            start, end = int(m.group(1)), int(m.group(2))
+            current["phases"].append({"name": m.group(3), "start_us": start, "end_us": end, "duration_us": end - start})
+    return timeline
+
+
+def is_boot_regression(base_us: int, new_us: int, threshold_ms: float, threshold_pct: float) -> bool:
+    """Slower by more than both thresholds, so jitter on short phases passes."""
+    delta = new_us - base_us
+    return delta > threshold_ms * 1000 and delta * 100 > base_us * threshold_pct
+
+
+def boot_end_us(timeline: dict) -> int:
+    """When the last phase finished, i.e. how long the whole boot took."""
+    return max((p["end_us"] for p in timeline["phases"]), default=0)
+
+
+def cmd_boottime(args):
+    """Show a boot timeline, or compare two and fail on regressions."""
+    paths = [Path(args.file)] if args.action == "show" else [Path(args.base), Path(args.new)]
+    timelines = []
+    for path in paths:
+        if not path.exists():
+            print(f"{C_RED}File '{path}' not found.{C_RESET}")
+            return 1
+        timeline = parse_boot_timeline(path)
+        if timeline is None:
+            print(f"{C_RED}No boot timeline in '{path}'.{C_RESET}")
+            return 1
+        timelines.append(timeline)
+
+    if args.action == "show":
+        timeline = timelines[0]
+        if args.json:
+            print(json.dumps(timeline, indent=2))
+            return 0
+        print(f"\n{C_BOLD}Boot Timeline: {timeline['build']}{C_RESET}")
+        print(f"{'─' * 66}")
+        print(f"  {'Phase':<32} {'Start':>9} {'Duration':>9} {'End':>9}")
+        for p in timeline["phases"]:
+            print(f"  {p['name']:<32} {p['start_us'] / 1000:>9.1f} {p['duration_us'] / 1000:>9.1f} {p['end_us'] / 1000:>9.1f}")
+        print(f"\n  {C_DIM}Times in ms since power-on.{C_RESET}\n")
+        return 0
+
+    base, new = timelines
+    base_phases = {p["name"]: p for p in base["phases"]}
+    rows = []
+    for p in new["phases"]:
+        b = base_phases.get(p["name"])
+        row = {"name": p["name"], "base": b, "new": p, "regression": False}
+        if b:
+            # Duration only: one slow phase moves the end of every later phase
+            row["regression"] = is_boot_regression(b["duration_us"], p["duration_us"], args.threshold_ms, args.threshold_pct)
+        rows.append(row)
+    new_names = {p["name"] for p in new["phases"]}
+    missing = [p["name"] for p in base["phases"] if p["name"] not in new_names]
+    regressions = [r["name"] for r in rows if r["regression"]]
+    base_end, new_end = boot_end_us(base), boot_end_us(new)
+    end_regression = is_boot_regression(base_end, new_end, args.threshold_ms, args.threshold_pct)
+
+    if args.json:
+        print(json.dumps({
+            "base": base["build"],
+            "new": new["build"],
+            "threshold_ms": args.threshold_ms,
+            "threshold_pct": args.threshold_pct,
+            "phases": rows,
+            "missing": missing,
+            "regressions": regressions,
+            "end": {"base_us": base_end, "new_us": new_end, "regression": end_regression},
+        }, indent=2))
+        return 1 if regressions or end_regression else 0
+
+    print(f"\n{C_BOLD}Boot Timeline: {base['build']} → {new['build']}{C_RESET}")
+    print(f"{'─' * 78}")
+    print(f"  {'Phase':<32} {'Duration':>9} {'Δ':>8} {'End':>9} {'Δ':>8}")
+    for r in rows:
+        p, b = r["new"], r["base"]
+        if b:
+            d_dur = (p["duration_us"] - b["duration_us"]) / 1000
+            d_end = (p["end_us"] - b["end_us"]) / 1000
+            delta = f"{d_dur:>+8.1f} {p['end_us'] / 1000:>9.1f} {d_end:>+8.1f}"
+        else:
+            delta = f"{'new':>8} {p['end_us'] / 1000:>9.1f} {'':>8}"
+        color = C_RED if r["regression"] else ""
+        print(f"  {color}{r['name']:<32} {p['duration_us'] / 1000:>9.1f} {delta}{C_RESET}")
+    for name in missing:
+        print(f"  {C_DIM}{name:<32} (not in {new['build']}){C_RESET}")
+    end_color = C_RED if end_regression else ""
+    print(f"\n  {end_color}{'Boot end':<32} {base_end / 1000:>9.1f} → {new_end / 1000:.1f} ({(new_end - base_end) / 1000:+.1f}){C_RESET}")
+    print(f"\n  {C_DIM}Times in ms; a phase's duration, or the boot end, is slower past {args.threshold_ms:g} ms and {args.threshold_pct:g}%.{C_RESET}")
+
+    if regressions or end_regression:
+        if regressions:
+            print(f"  {C_RED}✗ {len(regressions)} phase(s) slower: {', '.join(regressions)}{C_RESET}")
+        if end_regression:
+            print(f"  {C_RED}✗ Boot finished {(new_end - base_end) / 1000:.1f} ms later{C_RESET}")
+        print()
+        return 1
+    print(f"  {C_GREEN}✓ No boot regressions{C_RESET}\n")
+    return 0
+
+
 def cmd_flash(args):
     """Flash current build to device via idf.py."""
     if not _require_idf_tooling():
@@ -1768,6 +1945,19 @@ def main():
     p_diff.add_argument("profile_b", help="Right profile ID")
     p_diff.add_argument("--json", action="store_true", help="Output machine-readable JSON")
 
+    # boottime
+    p_boot = sub.add_parser("boottime", help="Show or compare boot timelines (boot.tl or console logs)")
+    boot_sub = p_boot.add_subparsers(dest="action", required=True)
+    p_boot_show = boot_sub.add_parser("show", help="Show one timeline")
+    p_boot_show.add_argument("file", help="boot.tl file or captured console log")
+    p_boot_show.add_argument("--json", action="store_true", help="Output machine-readable JSON")
+    p_boot_cmp = boot_sub.add_parser("compare", help="Compare two timelines; exit 1 if the new one is slower")
+    p_boot_cmp.add_argument("base", help="Baseline boot.tl or console log")
+    p_boot_cmp.add_argument("new", help="New boot.tl or console log")
+    p_boot_cmp.add_argument("--threshold-ms", dest="threshold_ms", type=float, default=20.0, help="Minimum slowdown to flag, in ms (default 20)")
+    p_boot_cmp.add_argument("--threshold-pct", dest="threshold_pct", type=float, default=10.0, help="Minimum slowdown to flag, in percent (default 10)")
+    p_boot_cmp.add_argument("--json", action="store_true", help="Output machine-readable JSON")
+
     # flash
     p_flash = sub.add_parser("flash", help="Flash current build to device")
     p_flash.add_argument("--port", default=None, help="Serial port (e.g. /dev/ttyUSB0)")
@@ -1805,6 +1995,7 @@ def main():
         "info": cmd_info,
         "new": cmd_new,
         "diff": cmd_diff,
+        "boottime": cmd_boottime,
         "flash": cmd_flash,
         "release": cmd_release,
         "cdn": cmd_cdn,